@@ -33,6 +33,7 @@
 */
 
 #include <stdarg.h>
+#include <float.h>
 
 #include "v_2ddrawer.h"
 #include "vectors.h"
@@ -49,6 +50,10 @@ F2DDrawer* twod = &drawer;
 EXTERN_CVAR(Float, transsouls)
 CVAR(Float, classic_scaling_factor, 1.0, CVAR_ARCHIVE)
 CVAR(Float, classic_scaling_pixelaspect, 1.2f, CVAR_ARCHIVE)
+CVARD(Bool, r_2dbatching, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "merge non-overlapping 2D draw commands with the same state into one draw call")
+
+// How many batches back a 2D command may be moved to find one it can join.
+enum { BatchLookback = 64 };
 
 IMPLEMENT_CLASS(FCanvas, false, false)
 
@@ -222,11 +227,13 @@ DEFINE_ACTION_FUNCTION_NATIVE(DShape2D, PushTriangle, Shape2D_PushTriangle)
 int F2DDrawer::AddCommand(RenderCommand *data) 
 {
 	data->mScreenFade = screenFade;
-	if (mData.Size() > 0 && data->isCompatible(mData.Last()))
+	CalcBounds(*data);
+	if (mData.Size() > mMergeFloor && data->isCompatible(mData.Last()))
 	{
 		// Merge with the last command.
 		mData.Last().mIndexCount += data->mIndexCount;
 		mData.Last().mVertCount += data->mVertCount;
+		if (data->hasBounds) mData.Last().addBounds(*data);
 		return mData.Size();
 	}
 	else
@@ -261,6 +268,216 @@ void F2DDrawer::AddIndices(int firstvert, TArray<int> &v)
 	}
 }
 
+// The two triangles of a quad, without the varargs overhead.
+void F2DDrawer::AddQuadIndices(int firstvert)
+{
+	int *ptr = &mIndices[mIndices.Reserve(6)];
+	ptr[0] = firstvert;
+	ptr[1] = firstvert + 1;
+	ptr[2] = firstvert + 2;
+	ptr[3] = firstvert + 1;
+	ptr[4] = firstvert + 3;
+	ptr[5] = firstvert + 2;
+}
+
+//==========================================================================
+//
+// Draw list recording
+//
+// Everything added after MarkDrawList can be copied out with
+// CaptureDrawList and later be appended again with ReplayDrawList,
+// without having to run the code that produced it.
+//
+//==========================================================================
+
+F2DDrawer::DrawListMark F2DDrawer::MarkDrawList()
+{
+	// The first recorded command must not get merged into an older one.
+	mMergeFloor = mData.Size();
+	return { mVertices.Size(), mIndices.Size(), mData.Size() };
+}
+
+bool F2DDrawer::CaptureDrawList(const DrawListMark &mark, DrawListCache &cache) const
+{
+	cache.Vertices.Clear();
+	cache.Indices.Clear();
+	cache.Commands.Clear();
+
+	if (mData.Size() < mark.Commands || mVertices.Size() < mark.Vertices || mIndices.Size() < mark.Indices)
+		return false;	// the list got cleared in between.
+
+	for (unsigned i = mark.Commands; i < mData.Size(); i++)
+	{
+		auto &cmd = mData[i];
+		// Shapes keep per frame state in their buffers and cannot be replayed.
+		if (cmd.shape2DBufInfo != nullptr) return false;
+		if (cmd.mVertCount > 0 && cmd.mVertIndex < (int)mark.Vertices) return false;
+		if (cmd.mIndexCount > 0 && cmd.mIndexIndex < (int)mark.Indices) return false;
+	}
+
+	cache.Vertices.Resize(mVertices.Size() - mark.Vertices);
+	if (cache.Vertices.Size() > 0)
+		memcpy(cache.Vertices.Data(), &mVertices[mark.Vertices], cache.Vertices.Size() * sizeof(TwoDVertex));
+
+	cache.Indices.Resize(mIndices.Size() - mark.Indices);
+	for (unsigned i = 0; i < cache.Indices.Size(); i++)
+		cache.Indices[i] = mIndices[mark.Indices + i] - mark.Vertices;
+
+	cache.Commands.Resize(mData.Size() - mark.Commands);
+	for (unsigned i = 0; i < cache.Commands.Size(); i++)
+	{
+		auto &cmd = cache.Commands[i];
+		cmd = mData[mark.Commands + i];
+		cmd.mVertIndex -= mark.Vertices;
+		cmd.mIndexIndex -= mark.Indices;
+	}
+	return true;
+}
+
+void F2DDrawer::ReplayDrawList(const DrawListCache &cache)
+{
+	int vbase = (int)mVertices.Size();
+	int ibase = (int)mIndices.Size();
+
+	if (cache.Vertices.Size() > 0)
+		memcpy(&mVertices[mVertices.Reserve(cache.Vertices.Size())], cache.Vertices.Data(), cache.Vertices.Size() * sizeof(TwoDVertex));
+
+	int *ptr = cache.Indices.Size() > 0 ? &mIndices[mIndices.Reserve(cache.Indices.Size())] : nullptr;
+	for (unsigned i = 0; i < cache.Indices.Size(); i++)
+		ptr[i] = cache.Indices[i] + vbase;
+
+	for (auto &cmd : cache.Commands)
+	{
+		auto &newcmd = mData[mData.Push(cmd)];
+		newcmd.mVertIndex += vbase;
+		newcmd.mIndexIndex += ibase;
+		newcmd.mScreenFade = screenFade;
+	}
+}
+
+//==========================================================================
+//
+// Calculates the screen space area a command can touch, so that Batch
+// knows which commands can be drawn in a different order.
+//
+//==========================================================================
+
+void F2DDrawer::CalcBounds(RenderCommand &cmd)
+{
+	cmd.hasBounds = false;
+	if (cmd.isSpecial != SpecialDrawCommand::NotSpecial || cmd.shape2DBufInfo != nullptr || cmd.mVertCount <= 0)
+		return;
+
+	double minx = DBL_MAX, miny = DBL_MAX, maxx = -DBL_MAX, maxy = -DBL_MAX;
+	auto &t = cmd.transform;
+	for (int i = 0; i < cmd.mVertCount; i++)
+	{
+		auto &v = mVertices[cmd.mVertIndex + i];
+		double x = v.x, y = v.y;
+		if (cmd.useTransform)
+		{
+			x = t.Cells[0][0] * v.x + t.Cells[0][1] * v.y + t.Cells[0][2];
+			y = t.Cells[1][0] * v.x + t.Cells[1][1] * v.y + t.Cells[1][2];
+		}
+		minx = min(minx, x);
+		maxx = max(maxx, x);
+		miny = min(miny, y);
+		maxy = max(maxy, y);
+	}
+	if (cmd.mFlags & DTF_Scissor)
+	{
+		minx = max(minx, (double)cmd.mScissor[0]);
+		miny = max(miny, (double)cmd.mScissor[1]);
+		maxx = min(maxx, (double)cmd.mScissor[2]);
+		maxy = min(maxy, (double)cmd.mScissor[3]);
+	}
+	// Pad by a pixel so that rounding, line widths and filtering cannot leak out of the box.
+	cmd.mBounds[0] = float(minx - 1);
+	cmd.mBounds[1] = float(miny - 1);
+	cmd.mBounds[2] = float(maxx + 1);
+	cmd.mBounds[3] = float(maxy + 1);
+	cmd.hasBounds = true;
+}
+
+//==========================================================================
+//
+// Merges draw commands that share the same state but are separated by
+// other commands, as long as nothing in between overlaps them. A HUD
+// alternating between a few textures and fonts ends up as a handful of
+// draw calls this way. The index buffer gets rebuilt so that each
+// batch's indices are contiguous.
+//
+//==========================================================================
+
+void F2DDrawer::Batch()
+{
+	unsigned count = mData.Size();
+	if (!r_2dbatching || count < 3)
+		return;
+
+	TArray<RenderCommand> batches;
+	TArray<int> head, tail;
+	TArray<int> chain(count, true);	// links the commands of a batch in submission order.
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		auto &cmd = mData[i];
+		int target = -1;
+
+		chain[i] = -1;
+		if (cmd.hasBounds)
+		{
+			bool mergeable = cmd.mType == DrawTypeTriangles;
+			int stop = max(0, (int)batches.Size() - BatchLookback);
+			for (int j = (int)batches.Size() - 1; j >= stop; j--)
+			{
+				auto &batch = batches[j];
+				if (!batch.hasBounds) break;	// stencil operations and shapes cannot be skipped.
+				if (mergeable && batch.mType == DrawTypeTriangles && cmd.isCompatible(batch))
+				{
+					target = j;
+					break;
+				}
+				if (batch.overlaps(cmd)) break;
+			}
+		}
+		if (target >= 0)
+		{
+			batches[target].mIndexCount += cmd.mIndexCount;
+			batches[target].mVertCount += cmd.mVertCount;
+			batches[target].addBounds(cmd);
+			chain[tail[target]] = i;
+			tail[target] = i;
+		}
+		else
+		{
+			batches.Push(cmd);
+			head.Push(i);
+			tail.Push(i);
+		}
+	}
+
+	if (batches.Size() == count)
+		return;
+
+	TArray<int> indices;
+	indices.Grow(mIndices.Size());
+	for (unsigned b = 0; b < batches.Size(); b++)
+	{
+		if (batches[b].mIndexCount == 0)
+			continue;
+		batches[b].mIndexIndex = indices.Size();
+		for (int c = head[b]; c >= 0; c = chain[c])
+		{
+			auto &cmd = mData[c];
+			if (cmd.mIndexCount > 0)
+				memcpy(&indices[indices.Reserve(cmd.mIndexCount)], &mIndices[cmd.mIndexIndex], cmd.mIndexCount * sizeof(int));
+		}
+	}
+	mIndices = std::move(indices);
+	mData = std::move(batches);
+}
+
 //==========================================================================
 //
 // SetStyle
@@ -568,7 +785,7 @@ void F2DDrawer::AddTexture(FGameTexture* img, DrawParms& parms)
 	dg.transform.Cells[1][2] += offset.Y;
 	dg.mIndexIndex = mIndices.Size();
 	dg.mIndexCount += 6;
-	AddIndices(dg.mVertIndex, 6, 0, 1, 2, 1, 3, 2);
+	AddQuadIndices(dg.mVertIndex);
 	AddCommand(&dg);
 	offset = osave;
 }
@@ -988,7 +1205,7 @@ void F2DDrawer::AddFlatFill(int left, int top, int right, int bottom, FGameTextu
 	dg.transform.Cells[1][2] += offset.Y;
 	dg.mIndexIndex = mIndices.Size();
 	dg.mIndexCount += 6;
-	AddIndices(dg.mVertIndex, 6, 0, 1, 2, 1, 3, 2);
+	AddQuadIndices(dg.mVertIndex);
 	AddCommand(&dg);
 }
 
@@ -1018,13 +1235,14 @@ void F2DDrawer::AddColorOnlyQuad(int x1, int y1, int w, int h, PalEntry color, F
 	dg.transform.Cells[1][2] += offset.Y;
 	dg.mIndexIndex = mIndices.Size();
 	dg.mIndexCount += 6;
-	AddIndices(dg.mVertIndex, 6, 0, 1, 2, 1, 3, 2);
+	AddQuadIndices(dg.mVertIndex);
 	if (!prepend) AddCommand(&dg);
 	else
 	{
 		// Only needed by Raze's fullscreen blends because they are being calculated late when half of the 2D content has already been submitted,
 		// This ensures they are below the HUD, not above it.
 		dg.mScreenFade = screenFade;
+		CalcBounds(dg);
 		mData.Insert(0, dg);
 	}
 }
@@ -1107,7 +1325,7 @@ void F2DDrawer::AddThickLine(const DVector2& v1, const DVector2& v2, double thic
 	dg.transform.Cells[1][2] += offset.Y;
 	dg.mIndexIndex = mIndices.Size();
 	dg.mIndexCount += 6;
-	AddIndices(dg.mVertIndex, 6, 0, 1, 2, 1, 3, 2);
+	AddQuadIndices(dg.mVertIndex);
 	AddCommand(&dg);
 }
 
@@ -1198,6 +1416,7 @@ void F2DDrawer::Clear()
 		mVertices.Clear();
 		mIndices.Clear();
 		mData.Clear();
+		mMergeFloor = 0;
 		mIsFirstPass = true;
 	}
 	screenFade = 1.f;
@@ -142,6 +142,9 @@ public:
 		uint8_t mFlags;
 		float mScreenFade;
 
+		bool hasBounds;		// mBounds is only valid if this is set. Commands without bounds are never reordered.
+		float mBounds[4];	// screen space bounding box (left, top, right, bottom)
+
 		bool useTransform;
 		DMatrix3x3 transform;
 
@@ -155,6 +158,20 @@ public:
 			memset((void*)this, 0,  sizeof(*this));
 		}
 
+		bool overlaps(const RenderCommand &other) const
+		{
+			return mBounds[0] < other.mBounds[2] && other.mBounds[0] < mBounds[2] &&
+				mBounds[1] < other.mBounds[3] && other.mBounds[1] < mBounds[3];
+		}
+
+		void addBounds(const RenderCommand &other)
+		{
+			mBounds[0] = min(mBounds[0], other.mBounds[0]);
+			mBounds[1] = min(mBounds[1], other.mBounds[1]);
+			mBounds[2] = max(mBounds[2], other.mBounds[2]);
+			mBounds[3] = max(mBounds[3], other.mBounds[3]);
+		}
+
 		// If these fields match, two draw commands can be batched.
 		bool isCompatible(const RenderCommand &other) const
 		{
@@ -188,9 +205,24 @@ public:
 		}
 	};
 
+	// A recorded part of the draw list that can be appended again in a later
+	// frame, for 2D content that is known not to have changed.
+	struct DrawListCache
+	{
+		TArray<TwoDVertex> Vertices;
+		TArray<int> Indices;
+		TArray<RenderCommand> Commands;
+	};
+
+	struct DrawListMark
+	{
+		unsigned Vertices, Indices, Commands;
+	};
+
 	TArray<int> mIndices;
 	TArray<TwoDVertex> mVertices;
 	TArray<RenderCommand> mData;
+	unsigned mMergeFloor = 0;	// AddCommand may not merge into commands below this.
 	int Width, Height;
 	bool isIn2D = false;
 	bool locked = false;	// prevents clearing of the data so it can be reused multiple times (useful for screen fades)
@@ -203,8 +235,14 @@ public:
 
 	int AddCommand(RenderCommand *data);
 	void AddIndices(int firstvert, int count, ...);
+	void Batch();
+	DrawListMark MarkDrawList();
+	bool CaptureDrawList(const DrawListMark &mark, DrawListCache &cache) const;
+	void ReplayDrawList(const DrawListCache &cache);
 private:
 	void AddIndices(int firstvert, TArray<int> &v);
+	void AddQuadIndices(int firstvert);
+	void CalcBounds(RenderCommand &cmd);
 	bool SetStyle(FGameTexture *tex, DrawParms &parms, PalEntry &color0, RenderCommand &quad);
 	void SetColorOverlay(PalEntry color, float alpha, PalEntry &vertexcolor, PalEntry &overlaycolor);
 
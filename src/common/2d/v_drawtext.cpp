@@ -43,6 +43,7 @@
 #include "gstrings.h"
 #include "vm.h"
 #include "printf.h"
+#include "superfasthash.h"
 
 
 int ListGetInt(VMVa_List &tags);
@@ -263,52 +264,83 @@ DEFINE_ACTION_FUNCTION(FCanvas, DrawChar)
 // This is only needed as a dummy. The code using wide strings does not need color control.
 EColorRange V_ParseFontColor(const char32_t *&color_value, int normalcolor, int boldcolor) { return CR_UNTRANSLATED; }
 
-template<class chartype>
-void DrawTextCommon(F2DDrawer *drawer, FFont *font, int normalcolor, double x, double y, const chartype *string, DrawParms &parms)
+//==========================================================================
+//
+// Text layout
+//
+// Decoding a string, parsing its color escapes and looking up every
+// character is the same work each frame for HUD and menu text, so the
+// resulting glyph runs for byte strings are cached. Positions are relative
+// to the text origin, so the cache is independent of where the text gets
+// drawn.
+//
+//==========================================================================
+
+CUSTOM_CVARD(Bool, r_fontatlas, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "draw text from shared font atlas textures")
 {
-	int 		w;
-	const chartype *ch;
-	int 		c;
-	double 		cx;
-	double 		cy;
-	int			boldcolor;
-	FTranslationID			trans = INVALID_TRANSLATION;
-	int			kerning;
-	FGameTexture *pic;
+	V_ClearTextLayouts();
+}
 
-	double scalex = parms.scalex * parms.patchscalex;
-	double scaley = parms.scaley * parms.patchscaley;
+enum
+{
+	MaxCachedTextLength = 1024,
+	MaxCachedLayouts = 2048,
+};
 
-	if (parms.celly == 0) parms.celly = font->GetHeight() + 1;
-	parms.celly = int (parms.celly * scaley);
+struct FTextGlyph
+{
+	FGameTexture *Pic;
+	const FFontAtlasGlyph *Atlas;	// null if the character must be drawn from its own texture
+	double X, Y;
+	int Width;
+	int ColorChange;	// the color set by escapes since the previous glyph, CR_UNDEFINED if none
+};
+
+struct FTextLayoutKey
+{
+	FFont *Font;
+	double ScaleX;
+	int NormalColor, CellX, CellY, Spacing, Monospace, MaxLen;
+};
 
-	bool palettetrans = (normalcolor == CR_NATIVEPAL && parms.TranslationId != NO_TRANSLATION);
+struct FTextLayout
+{
+	FTextLayoutKey Key;
+	FString Text;
+	TArray<FTextGlyph> Glyphs;
+};
 
-	if (normalcolor >= NumTextColors)
-		normalcolor = CR_UNTRANSLATED;
-	boldcolor = normalcolor ? normalcolor - 1 : NumTextColors - 1;
+static TMap<uint32_t, FTextLayout> TextLayouts;
+static TArray<FTextGlyph> UncachedGlyphs;
 
-	PalEntry colorparm = parms.color;
-	PalEntry color = 0xffffffff;
-	trans = palettetrans? INVALID_TRANSLATION : font->GetColorTranslation((EColorRange)normalcolor, &color);
-	parms.color = PalEntry(colorparm.a, (color.r * colorparm.r) / 255, (color.g * colorparm.g) / 255, (color.b * colorparm.b) / 255);
+void V_ClearTextLayouts()
+{
+	TextLayouts.Clear();
+	UncachedGlyphs.Reset();
+}
 
-	kerning = font->GetDefaultKerning();
+template<class chartype>
+static void LayoutText(FFont *font, int normalcolor, const chartype *string, const DrawParms &parms, double scalex, TArray<FTextGlyph> &glyphs)
+{
+	int boldcolor = normalcolor ? normalcolor - 1 : NumTextColors - 1;
+	int kerning = font->GetDefaultKerning();
+	bool useatlas = r_fontatlas;
+	int currentcolor = normalcolor;
+	int colorchange = CR_UNDEFINED;
+	const chartype *ch = string;
+	double cx = 0;
+	double cy = 0;
 
-	ch = string;
-	cx = x;
-	cy = y;
+	glyphs.Clear();
 
 	if (parms.monospace == EMonospacing::CellCenter)
 		cx += parms.spacing / 2;
 	else if (parms.monospace == EMonospacing::CellRight)
 		cx += parms.spacing;
 
-
-	auto currentcolor = normalcolor;
 	while (ch - string < parms.maxstrlen)
 	{
-		c = GetCharFromString(ch);
+		int c = GetCharFromString(ch);
 		if (!c)
 			break;
 
@@ -317,39 +349,32 @@ void DrawTextCommon(F2DDrawer *drawer, FFont *font, int normalcolor, double x, d
 			EColorRange newcolor = V_ParseFontColor(ch, normalcolor, boldcolor);
 			if (newcolor != CR_UNDEFINED)
 			{
-				trans = font->GetColorTranslation(newcolor, &color);
-				parms.color = PalEntry(colorparm.a, (color.r * colorparm.r) / 255, (color.g * colorparm.g) / 255, (color.b * colorparm.b) / 255);
-				currentcolor = newcolor;
+				currentcolor = colorchange = newcolor;
 			}
 			continue;
 		}
 
 		if (c == '\n')
 		{
-			cx = x;
+			cx = 0;
 			cy += parms.celly;
 			continue;
 		}
 
-		if (NULL != (pic = font->GetChar(c, currentcolor, &w)))
+		int w;
+		FGameTexture *pic = font->GetChar(c, currentcolor, &w);
+		if (pic != nullptr)
 		{
-			// if palette translation is used, font colors will be ignored.
-			if (!palettetrans) parms.TranslationId = trans;
-			SetTextureParms(drawer, &parms, pic, cx, cy);
-			if (parms.cellx)
-			{
-				w = parms.cellx;
-				parms.destwidth = parms.cellx;
-				parms.destheight = parms.celly;
-			}
-			if (parms.monospace == EMonospacing::CellLeft)
-				parms.left = 0;
-			else if (parms.monospace == EMonospacing::CellCenter)
-				parms.left = w / 2.;
-			else if (parms.monospace == EMonospacing::CellRight)
-				parms.left = w;
-
-			drawer->AddTexture(pic, parms);
+			if (parms.cellx) w = parms.cellx;
+
+			auto &glyph = glyphs[glyphs.Reserve(1)];
+			glyph.Pic = pic;
+			glyph.Atlas = useatlas ? font->GetAtlasGlyph(c, pic) : nullptr;
+			glyph.X = cx;
+			glyph.Y = cy;
+			glyph.Width = w;
+			glyph.ColorChange = colorchange;
+			colorchange = CR_UNDEFINED;
 		}
 		if (parms.monospace == EMonospacing::Off)
 		{
@@ -359,7 +384,116 @@ void DrawTextCommon(F2DDrawer *drawer, FFont *font, int normalcolor, double x, d
 		{
 			cx += (parms.spacing) * scalex;
 		}
+	}
+}
 
+template<class chartype>
+static const TArray<FTextGlyph> &GetTextLayout(FFont *font, int normalcolor, const chartype *string, const DrawParms &parms, double scalex)
+{
+	LayoutText(font, normalcolor, string, parms, scalex, UncachedGlyphs);
+	return UncachedGlyphs;
+}
+
+static const TArray<FTextGlyph> &GetTextLayout(FFont *font, int normalcolor, const uint8_t *string, const DrawParms &parms, double scalex)
+{
+	size_t len = strlen((const char *)string);
+	if (len > MaxCachedTextLength)
+	{
+		LayoutText(font, normalcolor, string, parms, scalex, UncachedGlyphs);
+		return UncachedGlyphs;
+	}
+
+	FTextLayoutKey key;
+	memset(&key, 0, sizeof(key));	// the key gets hashed and compared as raw memory.
+	key.Font = font;
+	key.ScaleX = scalex;
+	key.NormalColor = normalcolor;
+	key.CellX = parms.cellx;
+	key.CellY = parms.celly;
+	key.Spacing = parms.spacing;
+	key.Monospace = parms.monospace;
+	key.MaxLen = parms.maxstrlen;
+
+	uint32_t hash = SuperFastHash((const char *)string, len) ^ (SuperFastHash((const char *)&key, sizeof(key)) * 0x9e3779b1u);
+	auto layout = TextLayouts.CheckKey(hash);
+	if (layout != nullptr && !memcmp(&layout->Key, &key, sizeof(key)) && layout->Text.Len() == len && !memcmp(layout->Text.GetChars(), string, len))
+	{
+		return layout->Glyphs;
+	}
+
+	if (layout == nullptr && TextLayouts.CountUsed() >= MaxCachedLayouts)
+	{
+		// Text that changes every frame would otherwise make this grow forever.
+		TextLayouts.Clear();
+	}
+	auto &entry = TextLayouts[hash];
+	entry.Key = key;
+	entry.Text = FString((const char *)string, len);
+	LayoutText(font, normalcolor, string, parms, scalex, entry.Glyphs);
+	return entry.Glyphs;
+}
+
+template<class chartype>
+void DrawTextCommon(F2DDrawer *drawer, FFont *font, int normalcolor, double x, double y, const chartype *string, DrawParms &parms)
+{
+	FTranslationID			trans = INVALID_TRANSLATION;
+
+	double scalex = parms.scalex * parms.patchscalex;
+	double scaley = parms.scaley * parms.patchscaley;
+
+	if (parms.celly == 0) parms.celly = font->GetHeight() + 1;
+	parms.celly = int (parms.celly * scaley);
+
+	bool palettetrans = (normalcolor == CR_NATIVEPAL && parms.TranslationId != NO_TRANSLATION);
+
+	if (normalcolor >= NumTextColors)
+		normalcolor = CR_UNTRANSLATED;
+
+	PalEntry colorparm = parms.color;
+	PalEntry color = 0xffffffff;
+	trans = palettetrans? INVALID_TRANSLATION : font->GetColorTranslation((EColorRange)normalcolor, &color);
+	parms.color = PalEntry(colorparm.a, (color.r * colorparm.r) / 255, (color.g * colorparm.g) / 255, (color.b * colorparm.b) / 255);
+
+	// Atlas pages can only be used if the glyph's source rectangle can be remapped onto them.
+	bool canuseatlas = r_fontatlas && parms.srcx == 0 && parms.srcy == 0 && parms.srcwidth == 1 && parms.srcheight == 1 && parms.windowleft <= 0;
+
+	for (auto &glyph : GetTextLayout(font, normalcolor, string, parms, scalex))
+	{
+		if (glyph.ColorChange != CR_UNDEFINED)
+		{
+			trans = font->GetColorTranslation((EColorRange)glyph.ColorChange, &color);
+			parms.color = PalEntry(colorparm.a, (color.r * colorparm.r) / 255, (color.g * colorparm.g) / 255, (color.b * colorparm.b) / 255);
+		}
+
+		// if palette translation is used, font colors will be ignored.
+		if (!palettetrans) parms.TranslationId = trans;
+		SetTextureParms(drawer, &parms, glyph.Pic, x + glyph.X, y + glyph.Y);
+		if (parms.cellx)
+		{
+			parms.destwidth = parms.cellx;
+			parms.destheight = parms.celly;
+		}
+		if (parms.monospace == EMonospacing::CellLeft)
+			parms.left = 0;
+		else if (parms.monospace == EMonospacing::CellCenter)
+			parms.left = glyph.Width / 2.;
+		else if (parms.monospace == EMonospacing::CellRight)
+			parms.left = glyph.Width;
+
+		if (glyph.Atlas != nullptr && canuseatlas && parms.windowright >= parms.texwidth)
+		{
+			parms.srcx = glyph.Atlas->U;
+			parms.srcy = glyph.Atlas->V;
+			parms.srcwidth = glyph.Atlas->Width;
+			parms.srcheight = glyph.Atlas->Height;
+			drawer->AddTexture(glyph.Atlas->Page, parms);
+			parms.srcx = parms.srcy = 0;
+			parms.srcwidth = parms.srcheight = 1;
+		}
+		else
+		{
+			drawer->AddTexture(glyph.Pic, parms);
+		}
 	}
 }
 
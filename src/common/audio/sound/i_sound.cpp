@@ -36,6 +36,7 @@
 #include <stdlib.h>
 
 #include "oalsound.h"
+#include "softsound.h"
 
 #include "i_module.h"
 #include "cmdlib.h"
@@ -260,11 +261,15 @@ void I_InitSound ()
 		return;
 	}
 
-	// Keep it simple: let everything except "null" init the sound.
+	// Keep it simple: let everything except "null" and "software" init the OpenAL sound.
 	if (stricmp(snd_backend, "null") == 0)
 	{
 		GSnd = new NullSoundRenderer;
 	}
+	else if (stricmp(snd_backend, "software") == 0)
+	{
+		GSnd = new SoftSoundRenderer;
+	}
 	else
 	{
 		#ifndef NO_OPENAL
@@ -492,3 +497,81 @@ SoundHandle SoundRenderer::LoadSoundVoc(uint8_t *sfxdata, int length)
 	return retval;
 }
 
+
+//==========================================================================
+//
+// SoundRenderer :: DecodeSound
+//
+// Decodes compressed sound data into PCM samples. This only uses the
+// decoder and does not touch the output device, so it may be called from
+// any thread. Errors are returned in decoded.error instead of printed.
+//
+//==========================================================================
+
+bool SoundRenderer::DecodeSound(const uint8_t *sfxdata, int length, int def_loop_start, int def_loop_end, FDecodedSound &decoded)
+{
+	ChannelConfig chans;
+	SampleType type;
+	int srate;
+	uint32_t loop_start = 0, loop_end = ~0u;
+	zmusic_bool startass = false, endass = false;
+
+	if (def_loop_start < 0)
+	{
+		FindLoopTags(sfxdata, length, &loop_start, &startass, &loop_end, &endass);
+	}
+	else
+	{
+		loop_start = def_loop_start;
+		loop_end = def_loop_end;
+		startass = endass = true;
+	}
+	auto decoder = CreateDecoder(sfxdata, length, true);
+	if (!decoder)
+		return false;
+
+	SoundDecoder_GetInfo(decoder, &srate, &chans, &type);
+	int channels = chans == ChannelConfig_Mono ? 1 : chans == ChannelConfig_Stereo ? 2 : 0;
+	int bits = type == SampleType_UInt8 ? 8 : type == SampleType_Int16 ? 16 : 0;
+
+	if (channels == 0 || bits == 0)
+	{
+		SoundDecoder_Close(decoder);
+		decoded.error.Format("Unsupported audio format: %s, %s", GetChannelConfigName(chans), GetSampleTypeName(type));
+		return false;
+	}
+
+	TArray<uint8_t> &data = decoded.data;
+	unsigned total = 0;
+	unsigned got;
+
+	data.Resize(total + 32768);
+	while ((got = (unsigned)SoundDecoder_Read(decoder, (char*)&data[total], data.Size() - total)) > 0)
+	{
+		total += got;
+		data.Resize(total * 2);
+	}
+	data.Resize(total);
+	SoundDecoder_Close(decoder);
+	if (total == 0)
+	{
+		return false;
+	}
+
+	if (!startass) loop_start = Scale(loop_start, srate, 1000);
+	if (!endass && loop_end != ~0u) loop_end = Scale(loop_end, srate, 1000);
+	const uint32_t samples = total / (channels * bits / 8);
+	if (loop_start > samples) loop_start = 0;
+	if (loop_end > samples) loop_end = samples;
+
+	decoded.frequency = srate;
+	decoded.channels = channels;
+	decoded.bits = bits;
+	// Looping over the entire sound is the default, so only pass on loop points that actually change something.
+	if ((loop_start > 0 || loop_end < samples) && loop_end > loop_start)
+	{
+		decoded.loopstart = loop_start;
+		decoded.loopend = loop_end;
+	}
+	return true;
+}
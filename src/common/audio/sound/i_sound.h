@@ -39,6 +39,7 @@
 #include <vector>
 #include "i_soundinternal.h"
 #include "zstring.h"
+#include "tarray.h"
 #include <zmusic.h>
 #include "files.h"
 
@@ -96,6 +97,20 @@ typedef bool (*SoundStreamCallback)(SoundStream *stream, void *buff, int len, vo
 struct SoundDecoder;
 class MIDIDevice;
 
+// PCM data produced by SoundRenderer::DecodeSound. Decoding does not touch
+// the output device, so this can be filled in on a worker thread and handed
+// to LoadSoundRaw on the main thread afterward.
+struct FDecodedSound
+{
+	TArray<uint8_t> data;
+	int frequency = 0;
+	int channels = 0;
+	int bits = 0;
+	int loopstart = -1;
+	int loopend = -1;
+	FString error;
+};
+
 class SoundRenderer
 {
 public:
@@ -108,6 +123,7 @@ public:
 	virtual SoundHandle LoadSound(uint8_t *sfxdata, int length, int def_loop_start, int def_loop_end) = 0;
 	SoundHandle LoadSoundVoc(uint8_t *sfxdata, int length);
 	virtual SoundHandle LoadSoundRaw(uint8_t *sfxdata, int length, int frequency, int channels, int bits, int loopstart, int loopend = -1) = 0;
+	static bool DecodeSound(const uint8_t *sfxdata, int length, int def_loop_start, int def_loop_end, FDecodedSound &decoded);	// thread safe
 	virtual void UnloadSound (SoundHandle sfx) = 0;	// unloads a sound from memory
 	virtual unsigned int GetMSLength(SoundHandle sfx) = 0;	// Gets the length of a sound at its default frequency
 	virtual unsigned int GetSampleLength(SoundHandle sfx) = 0;	// Gets the length of a sound at its default frequency
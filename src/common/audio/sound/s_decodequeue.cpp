@@ -0,0 +1,162 @@
+//
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2026 The Redemption Team
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+
+#include "s_decodequeue.h"
+#include "c_cvars.h"
+#include "basics.h"
+
+CVARD(Int, snd_decodethreads, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "number of sound decoding threads, 0 picks one based on the CPU count")
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+FSoundDecodeQueue::~FSoundDecodeQueue()
+{
+	StopThreads();
+	for (auto job : Queued) delete job;
+	for (auto job : Finished) delete job;
+}
+
+//==========================================================================
+//
+// Adds a job to the queue and wakes up a worker for it.
+//
+//==========================================================================
+
+void FSoundDecodeQueue::Submit(FSoundDecodeJob *job)
+{
+	StartThreads();
+
+	std::unique_lock<std::mutex> lock(QueueMutex);
+	Queued.push_back(job);
+	lock.unlock();
+	WorkCondition.notify_one();
+}
+
+//==========================================================================
+//
+// Moves all finished jobs to the passed array. If 'wait' is set this
+// blocks until nothing is queued or running anymore.
+//
+//==========================================================================
+
+void FSoundDecodeQueue::FetchFinished(TArray<FSoundDecodeJob *> &finished, bool wait)
+{
+	std::unique_lock<std::mutex> lock(QueueMutex);
+	if (wait)
+	{
+		DoneCondition.wait(lock, [&]() { return Queued.empty() && Running == 0; });
+	}
+	finished.Append(Finished);
+	Finished.Clear();
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+bool FSoundDecodeQueue::IsIdle()
+{
+	std::unique_lock<std::mutex> lock(QueueMutex);
+	return Queued.empty() && Running == 0 && Finished.Size() == 0;
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FSoundDecodeQueue::WorkerMain()
+{
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(QueueMutex);
+		WorkCondition.wait(lock, [&]() { return !Queued.empty() || ShutdownFlag; });
+		if (ShutdownFlag)
+			break;
+
+		FSoundDecodeJob *job = Queued.front();
+		Queued.pop_front();
+		Running++;
+		lock.unlock();
+
+		job->Success = SoundRenderer::DecodeSound(job->Source.Data(), (int)job->Source.Size(), job->LoopStart, job->LoopEnd, job->Result);
+		job->Source.Reset();
+
+		lock.lock();
+		Finished.Push(job);
+		Running--;
+		bool idle = Queued.empty() && Running == 0;
+		lock.unlock();
+		if (idle)
+			DoneCondition.notify_all();
+	}
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FSoundDecodeQueue::StartThreads()
+{
+	if (!Threads.empty())
+		return;
+
+	int numthreads = snd_decodethreads;
+	if (numthreads <= 0)
+	{
+		// Leave one core for the game itself.
+		numthreads = clamp((int)std::thread::hardware_concurrency() - 1, 1, 8);
+	}
+
+	for (int i = 0; i < numthreads; i++)
+	{
+		Threads.push_back(std::thread([this]() { WorkerMain(); }));
+	}
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FSoundDecodeQueue::StopThreads()
+{
+	std::unique_lock<std::mutex> lock(QueueMutex);
+	ShutdownFlag = true;
+	lock.unlock();
+	WorkCondition.notify_all();
+	for (auto &thread : Threads)
+		thread.join();
+	Threads.clear();
+	lock.lock();
+	ShutdownFlag = false;
+}
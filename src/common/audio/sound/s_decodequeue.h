@@ -0,0 +1,72 @@
+//
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2026 The Redemption Team
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include "i_sound.h"
+
+// One sound waiting to be decoded. The compressed data is read on the main
+// thread because the file system is not thread safe. Only the decoding
+// itself runs on the worker threads.
+struct FSoundDecodeJob
+{
+	int SfxIndex = 0;
+	int LoopStart = -1;
+	int LoopEnd = -1;
+	TArray<uint8_t> Source;
+
+	bool Success = false;
+	FDecodedSound Result;
+};
+
+// Worker threads that turn compressed sound effects into PCM data, so that
+// the first play of a sound or a level precache does not stall the game
+// thread. Finished jobs are collected by the main thread, which does the
+// upload to the sound renderer.
+class FSoundDecodeQueue
+{
+public:
+	~FSoundDecodeQueue();
+
+	void Submit(FSoundDecodeJob *job);
+	void FetchFinished(TArray<FSoundDecodeJob *> &finished, bool wait);
+	bool IsIdle();
+
+private:
+	void StartThreads();
+	void StopThreads();
+	void WorkerMain();
+
+	std::vector<std::thread> Threads;
+	std::mutex QueueMutex;
+	std::condition_variable WorkCondition;
+	std::condition_variable DoneCondition;
+	std::deque<FSoundDecodeJob *> Queued;
+	TArray<FSoundDecodeJob *> Finished;
+	int Running = 0;
+	bool ShutdownFlag = false;
+};
@@ -38,6 +38,7 @@
 
 
 #include "s_soundinternal.h"
+#include "s_decodequeue.h"
 #include "m_swap.h"
 #include "superfasthash.h"
 #include "s_music.h"
@@ -51,6 +52,7 @@ CVAR(Bool, i_soundinbackground, false, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 CVAR(Bool, i_pauseinbackground, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 // killough 2/21/98: optionally use varying pitched sounds
 CVAR(Bool, snd_pitched, false, CVAR_ARCHIVE)
+CVARD(Bool, snd_asyncload, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "decode sounds on worker threads instead of stalling the game when they are first played")
 
 int SoundEnabled()
 {
@@ -90,6 +92,7 @@ void SoundEngine::Init(TArray<uint8_t> &curve)
 void SoundEngine::Clear()
 {
 	StopAllChannels();
+	DiscardSoundDecodes();
 	UnloadAllSounds();
 	S_sfx.Clear();
 	ClearRandoms();
@@ -113,6 +116,9 @@ void SoundEngine::Shutdown ()
 		delete chan;
 	}
 	FreeChannels = NULL;
+
+	delete DecodeQueue;
+	DecodeQueue = nullptr;
 }
 
 //==========================================================================
@@ -150,6 +156,9 @@ void SoundEngine::CacheMarkedSounds()
 			CacheSound(&S_sfx[i]);
 		}
 	}
+	// All the decoding has been spread across the worker threads, now wait for them to finish.
+	FinishSoundDecodes(true);
+
 	for (unsigned i = 1; i < S_sfx.Size(); ++i)
 	{
 		if (!S_sfx[i].bUsed && S_sfx[i].link == sfxinfo_t::NO_LINK)
@@ -179,7 +188,7 @@ void SoundEngine::CacheSound (sfxinfo_t *sfx)
 		}
 		else
 		{
-			LoadSound(sfx);
+			LoadSound(sfx, snd_asyncload);
 			sfx->bUsed = true;
 		}
 	}
@@ -193,6 +202,8 @@ void SoundEngine::CacheSound (sfxinfo_t *sfx)
 
 void SoundEngine::UnloadSound (sfxinfo_t *sfx)
 {
+	// If the sound is still being decoded, the result will be thrown away.
+	sfx->bDecodePending = false;
 	if (sfx->data.isValid())
 	{
 		GSnd->UnloadSound(sfx->data);
@@ -514,8 +525,9 @@ FSoundChan *SoundEngine::StartSound(int type, const void *source,
 		return NULL;
 	}
 
-	// Make sure the sound is loaded.
-	sfx = LoadSound(sfx);
+	// Make sure the sound is loaded. Sounds that need decoding may be deferred
+	// until the decoder has finished, unless they need to start at an offset.
+	sfx = LoadSound(sfx, snd_asyncload && startTime == 0.f);
 
 	// The empty sound never plays.
 	if (sfx->lumpnum == sfx_empty)
@@ -572,6 +584,15 @@ FSoundChan *SoundEngine::StartSound(int type, const void *source,
 	{
 		chan = NULL;
 	}
+	else if (sfx->bDecodePending)
+	{
+		// Start the channel evicted so that it gets restarted as soon as the decoder is done with it.
+		// The backend never sees this start, so the rolloff it would have copied has to be set here for the restart.
+		chan = GetChannel(NULL);
+		chan->Rolloff = *rolloff;
+		GSnd->MarkStartTime(chan);
+		chanflags |= CHANF_EVICTED | CHANF_DEFERRED;
+	}
 	else 
 	{
 		int startflags = 0;
@@ -654,7 +675,15 @@ void SoundEngine::RestartChannel(FSoundChan *chan)
 	if (sfx->bSingular && CheckSingular(chan->SoundID))
 		return;
 
-	sfx = LoadSound(sfx);
+	chan->ChanFlags &= ~CHANF_DEFERRED;
+	sfx = LoadSound(sfx, snd_asyncload);
+
+	if (sfx->bDecodePending)
+	{
+		// Try again once the decoder has delivered the data.
+		chan->ChanFlags |= CHANF_DEFERRED;
+		return;
+	}
 
 	// The empty sound never plays.
 	if (sfx->lumpnum == sfx_empty)
@@ -712,10 +741,17 @@ void SoundEngine::RestartChannel(FSoundChan *chan)
 //
 //==========================================================================
 
-sfxinfo_t *SoundEngine::LoadSound(sfxinfo_t *sfx)
+sfxinfo_t *SoundEngine::LoadSound(sfxinfo_t *sfx, bool async)
 {
 	if (GSnd->IsNull()) return sfx;
 
+	if (sfx->bDecodePending)
+	{
+		if (async) return sfx;
+		// The caller needs the data right now so there's no way around waiting for the decoder.
+		FinishSoundDecodes(true);
+	}
+
 	while (!sfx->data.isValid())
 	{
 		unsigned int i;
@@ -729,7 +765,7 @@ sfxinfo_t *SoundEngine::LoadSound(sfxinfo_t *sfx)
 		// then set this one up as a link, and don't load the sound again.
 		for (i = 0; i < S_sfx.Size(); i++)
 		{
-			if (S_sfx[i].data.isValid() && S_sfx[i].link == sfxinfo_t::NO_LINK && S_sfx[i].lumpnum == sfx->lumpnum &&
+			if ((S_sfx[i].data.isValid() || S_sfx[i].bDecodePending) && S_sfx[i].link == sfxinfo_t::NO_LINK && S_sfx[i].lumpnum == sfx->lumpnum &&
 				(!sfx->bLoadRAW || (sfx->RawRate == S_sfx[i].RawRate)))	// Raw sounds with different sample rates may not share buffers, even if they use the same source data.
 			{
 				DPrintf (DMSG_NOTIFY, "Linked %s to %s (%d)\n", sfx->name.GetChars(), S_sfx[i].name.GetChars(), i);
@@ -737,6 +773,7 @@ sfxinfo_t *SoundEngine::LoadSound(sfxinfo_t *sfx)
 				// This is necessary to avoid using the rolloff settings of the linked sound if its
 				// settings are different.
 				if (sfx->Rolloff.MinDistance == 0) sfx->Rolloff = S_Rolloff;
+				if (S_sfx[i].bDecodePending && !async) FinishSoundDecodes(true);
 				return &S_sfx[i];
 			}
 		}
@@ -768,6 +805,11 @@ sfxinfo_t *SoundEngine::LoadSound(sfxinfo_t *sfx)
 				sfx->data = GSnd->LoadSoundRaw(sfxp+8, dmxlen, frequency, 1, 8, sfx->LoopStart);
 			}
 			// If that fails, let the sound system try and figure it out.
+			else if (async)
+			{
+				QueueSoundDecode(sfx, std::move(sfxdata));
+				return sfx;
+			}
 			else
 			{
 				sfx->data = GSnd->LoadSound(sfxp, size, sfx->LoopStart, sfx->LoopEnd);
@@ -787,6 +829,93 @@ sfxinfo_t *SoundEngine::LoadSound(sfxinfo_t *sfx)
 	return sfx;
 }
 
+//==========================================================================
+//
+// QueueSoundDecode
+//
+// Hands the compressed data off to the decoder threads. The sound remains
+// unloaded until FinishSoundDecodes picks up the result.
+//
+//==========================================================================
+
+void SoundEngine::QueueSoundDecode(sfxinfo_t *sfx, TArray<uint8_t> &&sfxdata)
+{
+	if (DecodeQueue == nullptr)
+	{
+		DecodeQueue = new FSoundDecodeQueue;
+	}
+	auto job = new FSoundDecodeJob;
+	job->SfxIndex = int(sfx - &S_sfx[0]);
+	job->LoopStart = sfx->LoopStart;
+	job->LoopEnd = sfx->LoopEnd;
+	job->Source = std::move(sfxdata);
+	sfx->bDecodePending = true;
+	DecodeQueue->Submit(job);
+}
+
+//==========================================================================
+//
+// FinishSoundDecodes
+//
+// Uploads everything the decoder threads have finished to the sound
+// renderer. This must be called from the main thread.
+//
+//==========================================================================
+
+void SoundEngine::FinishSoundDecodes(bool wait)
+{
+	if (DecodeQueue == nullptr)
+	{
+		return;
+	}
+
+	TArray<FSoundDecodeJob *> finished;
+	DecodeQueue->FetchFinished(finished, wait);
+
+	for (auto job : finished)
+	{
+		sfxinfo_t *sfx = (unsigned)job->SfxIndex < S_sfx.Size() ? &S_sfx[job->SfxIndex] : nullptr;
+
+		// Ignore the result if the sound got unloaded in the meantime.
+		if (sfx && sfx->bDecodePending && !sfx->data.isValid())
+		{
+			sfx->bDecodePending = false;
+			if (job->Success)
+			{
+				auto &res = job->Result;
+				sfx->data = GSnd->LoadSoundRaw(res.data.Data(), (int)res.data.Size(), res.frequency, res.channels, res.bits, res.loopstart, res.loopend);
+			}
+			else if (job->Result.error.IsNotEmpty())
+			{
+				Printf("%s\n", job->Result.error.GetChars());
+			}
+			if (!sfx->data.isValid())
+			{
+				sfx->lumpnum = sfx_empty;
+			}
+		}
+		delete job;
+	}
+}
+
+//==========================================================================
+//
+// DiscardSoundDecodes
+//
+// Waits for all pending decodes and throws the results away. Needed before
+// the sound list gets cleared.
+//
+//==========================================================================
+
+void SoundEngine::DiscardSoundDecodes()
+{
+	for (auto &sfx : S_sfx)
+	{
+		sfx.bDecodePending = false;
+	}
+	FinishSoundDecodes(true);
+}
+
 //==========================================================================
 //
 // S_CheckSingular
@@ -1218,7 +1347,7 @@ void SoundEngine::RestoreEvictedChannel(FSoundChan *chan)
 		RestartChannel(chan);
 		if (!(chan->ChanFlags & CHANF_LOOP))
 		{
-			if (chan->ChanFlags & CHANF_EVICTED)
+			if ((chan->ChanFlags & (CHANF_EVICTED | CHANF_DEFERRED)) == CHANF_EVICTED)
 			{ // Still evicted and not looping? Forget about it.
 				ReturnChannel(chan);
 			}
@@ -1277,6 +1406,8 @@ void SoundEngine::UpdateSounds(int time)
 	GSnd->UpdateListener(&listener);
 	GSnd->UpdateSounds();
 
+	FinishSoundDecodes(false);
+
 	if (time >= RestartEvictionsAt)
 	{
 		RestartEvictionsAt = 0;
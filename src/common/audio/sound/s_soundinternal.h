@@ -99,6 +99,7 @@ constexpr FSoundID INVALID_SOUND = FSoundID::fromInt(-1);
 	 bool		bSingular = false;
 	 bool		bTentative = true;
 	 bool		bExternal = false;
+	 bool		bDecodePending = false;		// data is being decoded on a worker thread
 
 	 int			RawRate = 0;				// Sample rate to use when bLoadRAW is true
 	 int			LoopStart = -1;				// -1 means no specific loop defined
@@ -180,6 +181,8 @@ ReverbContainer *S_FindEnvironment (const char *name);
 ReverbContainer *S_FindEnvironment (int id);
 void S_AddEnvironment (ReverbContainer *settings);
 
+class FSoundDecodeQueue;
+
 class SoundEngine
 {
 protected:
@@ -198,6 +201,7 @@ protected:
 	TMap<int, FSoundID> ResIdMap;
 	TArray<FRandomSoundList> S_rnd;
 	bool blockNewSounds = false;
+	FSoundDecodeQueue* DecodeQueue = nullptr;
 
 private:
 	void LinkChannel(FSoundChan* chan, FSoundChan** head);
@@ -218,6 +222,9 @@ private:
 	bool CheckSingular(FSoundID sound_id);
 	virtual TArray<uint8_t> ReadSound(int lumpnum) = 0;
 
+	void QueueSoundDecode(sfxinfo_t* sfx, TArray<uint8_t>&& sfxdata);
+	void DiscardSoundDecodes();
+
 protected:
 	virtual bool CheckSoundLimit(sfxinfo_t* sfx, const FVector3& pos, int near_limit, float limit_range, int sourcetype, const void* actor, int channel, float attenuation);
 	virtual FSoundID ResolveSound(const void *ent, int srctype, FSoundID soundid, float &attenuation);
@@ -235,7 +242,8 @@ public:
 	}
 
 	virtual void StopChannel(FSoundChan* chan);
-	sfxinfo_t* LoadSound(sfxinfo_t* sfx);
+	sfxinfo_t* LoadSound(sfxinfo_t* sfx, bool async = false);
+	void FinishSoundDecodes(bool wait);
 	sfxinfo_t* GetWritableSfx(FSoundID snd)
 	{
 		if ((unsigned)snd.index() >= S_sfx.Size()) return nullptr;
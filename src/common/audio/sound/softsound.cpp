@@ -0,0 +1,1177 @@
+//
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2026 The Redemption Team
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+
+#include <math.h>
+#include <chrono>
+
+#include "softsound.h"
+#include "c_cvars.h"
+#include "c_dispatch.h"
+#include "v_text.h"
+#include "printf.h"
+#include "files.h"
+#include "m_swap.h"
+#include "i_time.h"
+
+#ifndef NO_SSE
+#include <emmintrin.h>
+#endif
+
+EXTERN_CVAR(Int, snd_channels)
+EXTERN_CVAR(Int, snd_samplerate)
+EXTERN_CVAR(Bool, snd_waterreverb)
+
+CVARD(Int, snd_softmixframes, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "frames the software mixer renders per update, 0 follows the wall clock")
+CVARD(String, snd_softwavfile, "", CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "if set, the software mixer writes its output to this WAV file")
+
+extern ReverbContainer *ForcedEnvironment;
+
+#define AREA_SOUND_RADIUS  (32.f)
+
+#define PITCH_MULT (0.7937005f) /* Approx. 4 semitones lower, same as the OpenAL backend */
+
+enum
+{
+	MIX_BLOCK = 256,	// frames per mixing block
+};
+
+static float GetRolloff(const FRolloffInfo *rolloff, float distance)
+{
+	return soundEngine->GetRolloff(rolloff, distance);
+}
+
+//==========================================================================
+//
+// Mixing kernels
+//
+//==========================================================================
+
+static void MixMonoToStereo(float *out, const float *in, int frames, float gl, float gr)
+{
+	int i = 0;
+#ifndef NO_SSE
+	__m128 gain = _mm_setr_ps(gl, gr, gl, gr);
+	for (; i + 4 <= frames; i += 4)
+	{
+		__m128 s = _mm_loadu_ps(in + i);
+		__m128 lo = _mm_unpacklo_ps(s, s);
+		__m128 hi = _mm_unpackhi_ps(s, s);
+		_mm_storeu_ps(out + i * 2, _mm_add_ps(_mm_loadu_ps(out + i * 2), _mm_mul_ps(lo, gain)));
+		_mm_storeu_ps(out + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(out + i * 2 + 4), _mm_mul_ps(hi, gain)));
+	}
+#endif
+	for (; i < frames; i++)
+	{
+		out[i * 2] += in[i] * gl;
+		out[i * 2 + 1] += in[i] * gr;
+	}
+}
+
+static void MixStereo(float *out, const float *in, int frames, float gl, float gr)
+{
+	int i = 0;
+#ifndef NO_SSE
+	__m128 gain = _mm_setr_ps(gl, gr, gl, gr);
+	for (; i + 2 <= frames; i += 2)
+	{
+		__m128 s = _mm_loadu_ps(in + i * 2);
+		_mm_storeu_ps(out + i * 2, _mm_add_ps(_mm_loadu_ps(out + i * 2), _mm_mul_ps(s, gain)));
+	}
+#endif
+	for (; i < frames; i++)
+	{
+		out[i * 2] += in[i * 2] * gl;
+		out[i * 2 + 1] += in[i * 2 + 1] * gr;
+	}
+}
+
+// Adds a stereo buffer to a mono one, used for the reverb send.
+static void MixStereoToMono(float *out, const float *in, int frames, float gain)
+{
+	int i = 0;
+#ifndef NO_SSE
+	__m128 g = _mm_set1_ps(gain);
+	for (; i + 4 <= frames; i += 4)
+	{
+		__m128 a = _mm_loadu_ps(in + i * 2);
+		__m128 b = _mm_loadu_ps(in + i * 2 + 4);
+		__m128 l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_add_ps(l, r), g)));
+	}
+#endif
+	for (; i < frames; i++)
+	{
+		out[i] += (in[i * 2] + in[i * 2 + 1]) * gain;
+	}
+}
+
+static void ConvertToInt16(int16_t *out, const float *in, int count, float gain)
+{
+	int i = 0;
+#ifndef NO_SSE
+	__m128 g = _mm_set1_ps(gain * 32767.f);
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i a = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i), g));
+		__m128i b = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), g));
+		_mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(a, b));	// saturates
+	}
+#endif
+	for (; i < count; i++)
+	{
+		out[i] = (int16_t)clamp<int>((int)lrintf(in[i] * gain * 32767.f), -32768, 32767);
+	}
+}
+
+//==========================================================================
+//
+// Data structures
+//
+//==========================================================================
+
+struct SoftSample
+{
+	TArray<float> Data;		// interleaved frames
+	int Channels;
+	int Frequency;
+	uint32_t Frames;
+	uint32_t LoopStart;
+	uint32_t LoopEnd;
+};
+
+struct SoftVoice
+{
+	SoftSample *Sample;
+	FISoundChannel *Chan;	// nullptr if the voice is free
+	uint64_t Position;		// 32.32 fixed point frame position
+	uint64_t Step;
+	float Volume;
+	float Pitch;
+	float GainL, GainR;
+	int Priority;
+	int Flags;				// SNDF_* flags
+	bool Is3D;
+	bool Ended;
+	FVector3 Pos;
+};
+
+// A small Schroeder style reverb: four parallel damped combs followed by two
+// allpasses per output channel, with the right side slightly detuned.
+class SoftReverb
+{
+	static const int NumCombs = 4;
+	static const int NumAllpasses = 2;
+
+	struct Delay
+	{
+		TArray<float> Buffer;
+		unsigned Pos = 0;
+		float Store = 0.f;
+
+		void Init(int length)
+		{
+			Buffer.Resize(max(length, 1));
+			memset(Buffer.Data(), 0, Buffer.Size() * sizeof(float));
+			Pos = 0;
+			Store = 0.f;
+		}
+	};
+
+	Delay Combs[2][NumCombs];
+	Delay Allpasses[2][NumAllpasses];
+	float Feedback[NumCombs] = {};
+	float Damp = 0.2f;
+	float Wet = 0.f;
+
+public:
+	SoftReverb(int rate)
+	{
+		static const int comblengths[NumCombs] = { 1116, 1188, 1277, 1356 };
+		static const int aplengths[NumAllpasses] = { 556, 441 };
+		double scale = rate / 44100.;
+		for (int side = 0; side < 2; side++)
+		{
+			for (int i = 0; i < NumCombs; i++) Combs[side][i].Init(int((comblengths[i] + side * 23) * scale));
+			for (int i = 0; i < NumAllpasses; i++) Allpasses[side][i].Init(int((aplengths[i] + side * 23) * scale));
+		}
+	}
+
+	void SetParams(const REVERB_PROPERTIES &props, int rate)
+	{
+		// Feedback is derived from the decay time so that every comb reaches -60dB at the same moment.
+		float decay = max(props.DecayTime, 0.1f);
+		for (int i = 0; i < NumCombs; i++)
+		{
+			float seconds = Combs[0][i].Buffer.Size() / float(rate);
+			Feedback[i] = powf(10.f, -3.f * seconds / decay);
+		}
+		Damp = clamp(0.6f - 0.4f * props.DecayHFRatio, 0.05f, 0.9f);
+		// Room and Reverb are in millibels.
+		Wet = powf(10.f, props.Room / 2000.f) * powf(10.f, props.Reverb / 2000.f) * 0.5f;
+	}
+
+	void Process(const float *in, float *out, int frames)
+	{
+		if (Wet <= 0.0001f)
+			return;
+
+		for (int i = 0; i < frames; i++)
+		{
+			float input = in[i] * 0.05f;
+			for (int side = 0; side < 2; side++)
+			{
+				float acc = 0.f;
+				for (int c = 0; c < NumCombs; c++)
+				{
+					Delay &d = Combs[side][c];
+					float o = d.Buffer[d.Pos];
+					d.Store = o * (1.f - Damp) + d.Store * Damp;
+					d.Buffer[d.Pos] = input + d.Store * Feedback[c];
+					if (++d.Pos >= d.Buffer.Size()) d.Pos = 0;
+					acc += o;
+				}
+				for (int a = 0; a < NumAllpasses; a++)
+				{
+					Delay &d = Allpasses[side][a];
+					float b = d.Buffer[d.Pos];
+					d.Buffer[d.Pos] = acc + b * 0.5f;
+					if (++d.Pos >= d.Buffer.Size()) d.Pos = 0;
+					acc = b - acc;
+				}
+				out[i * 2 + side] += acc * Wet;
+			}
+		}
+	}
+};
+
+//==========================================================================
+//
+// SoftSoundStream
+//
+//==========================================================================
+
+class SoftSoundStream : public SoundStream
+{
+	SoftSoundRenderer *Renderer;
+	SoundStreamCallback Callback;
+	void *UserData;
+	int Flags;
+	int SampleRate;
+	int Channels;
+	int SampleSize;
+
+	TArray<uint8_t> Data;
+	TArray<float> Frames;	// converted stereo frames that have not been played yet
+	uint64_t ReadPos = 0;	// 32.32 position into Frames
+	uint64_t Played = 0;
+	float Volume = 1.f;
+	bool Paused = false;
+	bool Starved = false;
+	std::atomic<bool> Playing;
+
+public:
+	SoftSoundStream(SoftSoundRenderer *renderer, SoundStreamCallback callback, int buffbytes, int flags, int samplerate, void *userdata)
+		: Renderer(renderer), Callback(callback), UserData(userdata), Flags(flags), SampleRate(samplerate), Playing(false)
+	{
+		Channels = (flags & Mono) ? 1 : 2;
+		SampleSize = (flags & Bits8) ? 1 : (flags & (Bits32 | Float)) ? 4 : 2;
+		int framesize = Channels * SampleSize;
+		buffbytes += framesize - 1;
+		buffbytes -= buffbytes % framesize;
+		Data.Resize(max(buffbytes, framesize));
+		Renderer->AddStream(this);
+	}
+
+	~SoftSoundStream()
+	{
+		Renderer->RemoveStream(this);
+	}
+
+	bool Play(bool looping, float vol) override
+	{
+		SetVolume(vol);
+		if (Playing.load())
+			return true;
+
+		Frames.Clear();
+		ReadPos = 0;
+		Played = 0;
+		Starved = false;
+		Playing.store(true);
+		return true;
+	}
+
+	void Stop() override
+	{
+		Playing.store(false);
+		Frames.Clear();
+		ReadPos = 0;
+	}
+
+	void SetVolume(float vol) override
+	{
+		Volume = vol;
+	}
+
+	bool SetPaused(bool paused) override
+	{
+		Paused = paused;
+		return true;
+	}
+
+	bool IsEnded() override
+	{
+		return !Playing.load();
+	}
+
+	Position GetPlayPosition() override
+	{
+		return { Played, std::chrono::nanoseconds(0) };
+	}
+
+	FString GetStats() override
+	{
+		FString stats = Starved ? "Underrun" : "Ready";
+		if (Paused) stats += ", paused";
+		if (Playing.load()) stats += ", playing";
+		stats.AppendFormat(", %dHz", SampleRate);
+		return stats;
+	}
+
+	// Pulls one buffer from the callback and appends it as stereo float frames.
+	bool Fill()
+	{
+		if (!Callback(this, Data.Data(), Data.Size(), UserData))
+			return false;
+
+		unsigned count = Data.Size() / SampleSize;
+		unsigned first = Frames.Reserve(count / Channels * 2);
+		float *dest = &Frames[first];
+		for (unsigned i = 0; i < count; i++)
+		{
+			float v;
+			if (Flags & Bits8) v = (Data[i] - 128) / 128.f;
+			else if (Flags & Float) v = ((float*)Data.Data())[i];
+			else if (Flags & Bits32) v = ((int32_t*)Data.Data())[i] / 2147483648.f;
+			else v = ((int16_t*)Data.Data())[i] / 32768.f;
+
+			if (Channels == 1)
+			{
+				dest[i * 2] = dest[i * 2 + 1] = v;
+			}
+			else
+			{
+				dest[i] = v;
+			}
+		}
+		return true;
+	}
+
+	void Mix(float *out, int frames, int outrate)
+	{
+		if (!Playing.load() || Paused)
+			return;
+
+		uint64_t step = (uint64_t(SampleRate) << 32) / outrate;
+		unsigned needed = unsigned((ReadPos + step * frames) >> 32) + 2;
+		while (Frames.Size() / 2 < needed)
+		{
+			if (!Fill())
+			{
+				Starved = true;
+				break;
+			}
+		}
+
+		unsigned available = Frames.Size() / 2;
+		float gain = Volume * Renderer->MusicVolume;
+		const float *src = Frames.Data();
+		int i;
+		for (i = 0; i < frames; i++)
+		{
+			unsigned idx = unsigned(ReadPos >> 32);
+			if (idx + 1 >= available)
+				break;
+			float frac = (ReadPos & 0xffffffff) * (1.f / 4294967296.f);
+			out[i * 2] += (src[idx * 2] + (src[idx * 2 + 2] - src[idx * 2]) * frac) * gain;
+			out[i * 2 + 1] += (src[idx * 2 + 1] + (src[idx * 2 + 3] - src[idx * 2 + 1]) * frac) * gain;
+			ReadPos += step;
+		}
+
+		// Drop everything that has been played.
+		unsigned consumed = min(unsigned(ReadPos >> 32), available);
+		Frames.Delete(0, consumed * 2);
+		ReadPos -= uint64_t(consumed) << 32;
+		Played += consumed;
+
+		if (i < frames && Starved)
+		{
+			// The callback ran dry, so the stream is over.
+			Playing.store(false);
+		}
+	}
+};
+
+//==========================================================================
+//
+// SoftSoundRenderer
+//
+//==========================================================================
+
+SoftSoundRenderer::SoftSoundRenderer()
+{
+	OutputRate = *snd_samplerate > 0 ? *snd_samplerate : 44100;
+
+	Voices.Resize(clamp<int>(snd_channels, 8, 1024));
+	memset(Voices.Data(), 0, Voices.Size() * sizeof(SoftVoice));
+
+	MixBuffer.Resize(MIX_BLOCK * 2);
+	WorldBuffer.Resize(MIX_BLOCK * 2);
+	ReverbSend.Resize(MIX_BLOCK);
+	VoiceBuffer.Resize(MIX_BLOCK * 2);
+	OutputBuffer.Resize(MIX_BLOCK * 2);
+
+	Reverb = new SoftReverb(OutputRate);
+	LoadReverb(DefaultEnvironments[0]);
+
+	const char *wavname = snd_softwavfile;
+	if (*wavname != 0)
+	{
+		WavFile = FileSys::FileWriter::Open(wavname);
+		if (WavFile == nullptr)
+		{
+			Printf(TEXTCOLOR_RED "Unable to open %s for writing\n", wavname);
+		}
+		else
+		{
+			// The sizes get patched in when the file gets closed.
+			uint8_t header[44] = {};
+			WavFile->Write(header, sizeof(header));
+		}
+	}
+	LastUpdate = I_nsTime();
+}
+
+SoftSoundRenderer::~SoftSoundRenderer()
+{
+	while (Streams.Size() > 0)
+	{
+		delete Streams[0];
+	}
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan != nullptr) StopVoice(&voice);
+	}
+	CloseOutput();
+	delete Reverb;
+}
+
+bool SoftSoundRenderer::IsValid()
+{
+	return true;
+}
+
+void SoftSoundRenderer::SetSfxVolume(float volume)
+{
+	SfxVolume = volume;
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan != nullptr) CalcVoiceGains(&voice);
+	}
+}
+
+void SoftSoundRenderer::SetMusicVolume(float volume)
+{
+	MusicVolume = volume;
+}
+
+float SoftSoundRenderer::GetOutputRate()
+{
+	return (float)OutputRate;
+}
+
+//==========================================================================
+//
+// Sample management
+//
+//==========================================================================
+
+SoundHandle SoftSoundRenderer::LoadSound(uint8_t *sfxdata, int length, int def_loop_start, int def_loop_end)
+{
+	SoundHandle retval = { NULL };
+	FDecodedSound decoded;
+
+	if (!DecodeSound(sfxdata, length, def_loop_start, def_loop_end, decoded))
+	{
+		if (decoded.error.IsNotEmpty())
+			Printf("%s\n", decoded.error.GetChars());
+		return retval;
+	}
+	return LoadSoundRaw(decoded.data.Data(), (int)decoded.data.Size(), decoded.frequency, decoded.channels, decoded.bits, decoded.loopstart, decoded.loopend);
+}
+
+SoundHandle SoftSoundRenderer::LoadSoundRaw(uint8_t *sfxdata, int length, int frequency, int channels, int bits, int loopstart, int loopend)
+{
+	SoundHandle retval = { NULL };
+
+	if (length == 0) return retval;
+
+	if ((bits != 8 && bits != -8 && bits != 16) || (channels != 1 && channels != 2) || frequency <= 0)
+	{
+		Printf("Unhandled format: %d bit, %d channel, %d hz\n", bits, channels, frequency);
+		return retval;
+	}
+
+	int samplesize = bits == 16 ? 2 : 1;
+	unsigned count = length / samplesize;
+	count -= count % channels;
+
+	auto sample = new SoftSample;
+	sample->Channels = channels;
+	sample->Frequency = frequency;
+	sample->Frames = count / channels;
+	sample->Data.Resize(count);
+
+	float *dest = sample->Data.Data();
+	for (unsigned i = 0; i < count; i++)
+	{
+		if (bits == 16) dest[i] = LittleShort(((int16_t*)sfxdata)[i]) / 32768.f;
+		else if (bits == 8) dest[i] = (sfxdata[i] - 128) / 128.f;
+		else dest[i] = int8_t(sfxdata[i]) / 128.f;
+	}
+
+	sample->LoopStart = 0;
+	sample->LoopEnd = sample->Frames;
+	if (loopstart > 0 || loopend > 0)
+	{
+		if (loopstart < 0) loopstart = 0;
+		if (loopend < loopstart) loopend = sample->Frames;
+		sample->LoopEnd = min<uint32_t>(loopend, sample->Frames);
+		sample->LoopStart = min<uint32_t>(loopstart, sample->LoopEnd);
+		if (sample->LoopStart == sample->LoopEnd)
+		{
+			sample->LoopStart = 0;
+			sample->LoopEnd = sample->Frames;
+		}
+	}
+
+	retval.data = sample;
+	return retval;
+}
+
+void SoftSoundRenderer::UnloadSound(SoundHandle sfx)
+{
+	if (sfx.data == nullptr)
+		return;
+
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan != nullptr && voice.Sample == sfx.data)
+		{
+			StopChannel(voice.Chan);
+		}
+	}
+	delete (SoftSample*)sfx.data;
+}
+
+unsigned int SoftSoundRenderer::GetMSLength(SoundHandle sfx)
+{
+	auto sample = (SoftSample*)sfx.data;
+	if (sample == nullptr) return 0;
+	return (unsigned int)(uint64_t(sample->Frames) * 1000 / sample->Frequency);
+}
+
+unsigned int SoftSoundRenderer::GetSampleLength(SoundHandle sfx)
+{
+	auto sample = (SoftSample*)sfx.data;
+	return sample == nullptr ? 0 : sample->Frames;
+}
+
+//==========================================================================
+//
+// Streams
+//
+//==========================================================================
+
+SoundStream *SoftSoundRenderer::CreateStream(SoundStreamCallback callback, int buffbytes, int flags, int samplerate, void *userdata)
+{
+	if (samplerate <= 0 || buffbytes <= 0)
+		return nullptr;
+	return new SoftSoundStream(this, callback, buffbytes, flags, samplerate, userdata);
+}
+
+void SoftSoundRenderer::AddStream(SoftSoundStream *stream)
+{
+	Streams.Push(stream);
+}
+
+void SoftSoundRenderer::RemoveStream(SoftSoundStream *stream)
+{
+	unsigned int idx = Streams.Find(stream);
+	if (idx < Streams.Size())
+		Streams.Delete(idx);
+}
+
+//==========================================================================
+//
+// Voices
+//
+//==========================================================================
+
+SoftVoice *SoftSoundRenderer::AllocVoice(int priority, float dist_sqr)
+{
+	SoftVoice *lowest = nullptr;
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan == nullptr)
+			return &voice;
+
+		// Same criteria as the OpenAL backend: the lowest priority loses, with ties broken by distance.
+		if (lowest == nullptr || voice.Priority < lowest->Priority ||
+			(voice.Priority == lowest->Priority && voice.Chan->DistanceSqr > lowest->Chan->DistanceSqr))
+		{
+			lowest = &voice;
+		}
+	}
+	if (lowest != nullptr && (lowest->Priority < priority || (lowest->Priority == priority && lowest->Chan->DistanceSqr > dist_sqr)))
+	{
+		StopChannel(lowest->Chan);
+		return lowest;
+	}
+	return nullptr;
+}
+
+FISoundChannel *SoftSoundRenderer::StartVoice(SoftVoice *voice, SoundHandle sfx, float vol, float pitch, int chanflags, FISoundChannel *reuse_chan, float startTime)
+{
+	auto sample = (SoftSample*)sfx.data;
+
+	voice->Sample = sample;
+	voice->Volume = vol;
+	voice->Pitch = pitch;
+	voice->Flags = chanflags;
+	voice->Ended = false;
+
+	uint64_t offset = 0;
+	if (!reuse_chan || reuse_chan->StartTime == 0)
+	{
+		float sfxlength = sample->Frames / float(sample->Frequency);
+		float st = (chanflags & SNDF_LOOP)
+				? (sfxlength > 0 ? fmodf(startTime, sfxlength) : 0)
+				: clamp<float>(startTime, 0.f, sfxlength);
+		offset = uint64_t(st * sample->Frequency);
+	}
+	else if (chanflags & SNDF_ABSTIME)
+	{
+		offset = reuse_chan->StartTime;
+	}
+	else if (MixClock > reuse_chan->StartTime)
+	{
+		// StartTime was set by MarkStartTime and is measured in output frames.
+		offset = (MixClock - reuse_chan->StartTime) * sample->Frequency / OutputRate;
+	}
+	if (chanflags & SNDF_LOOP)
+	{
+		if (offset >= sample->LoopEnd && sample->LoopEnd > sample->LoopStart)
+			offset = sample->LoopStart + (offset - sample->LoopStart) % (sample->LoopEnd - sample->LoopStart);
+	}
+	else if (offset >= sample->Frames)
+	{
+		return nullptr;
+	}
+	voice->Position = offset << 32;
+
+	FISoundChannel *chan = reuse_chan;
+	if (!chan) chan = soundEngine->GetChannel(voice);
+	else chan->SysChannel = voice;
+	voice->Chan = chan;
+	return chan;
+}
+
+FISoundChannel *SoftSoundRenderer::StartSound(SoundHandle sfx, float vol, float pitch, int chanflags, FISoundChannel *reuse_chan, float startTime)
+{
+	if (sfx.data == nullptr)
+		return nullptr;
+
+	SoftVoice *voice = AllocVoice(1000, 0.f);
+	if (voice == nullptr)
+		return nullptr;
+
+	voice->Is3D = false;
+	voice->Priority = 1000;
+	FISoundChannel *chan = StartVoice(voice, sfx, vol, pitch, chanflags, reuse_chan, startTime);
+	if (chan == nullptr)
+		return nullptr;
+
+	chan->Rolloff.RolloffType = ROLLOFF_Log;
+	chan->Rolloff.RolloffFactor = 0.f;
+	chan->Rolloff.MinDistance = 1.f;
+	chan->DistanceSqr = 0.f;
+	chan->ManualRolloff = false;
+	CalcVoiceGains(voice);
+	return chan;
+}
+
+FISoundChannel *SoftSoundRenderer::StartSound3D(SoundHandle sfx, SoundListener *listener, float vol, FRolloffInfo *rolloff, float distscale, float pitch, int priority, const FVector3 &pos, const FVector3 &vel, int channum, int chanflags, FISoundChannel *reuse_chan, float startTime)
+{
+	if (sfx.data == nullptr)
+		return nullptr;
+
+	float dist_sqr = (float)(pos - listener->position).LengthSquared();
+	SoftVoice *voice = AllocVoice(priority, dist_sqr);
+	if (voice == nullptr)
+		return nullptr;
+
+	voice->Is3D = true;
+	voice->Priority = priority;
+	voice->Pos = pos;
+	FISoundChannel *chan = StartVoice(voice, sfx, vol, pitch, chanflags, reuse_chan, startTime);
+	if (chan == nullptr)
+		return nullptr;
+
+	chan->Rolloff = *rolloff;
+	chan->DistanceScale = distscale;
+	chan->DistanceSqr = dist_sqr;
+	chan->ManualRolloff = true;
+	CalcVoiceGains(voice);
+	return chan;
+}
+
+//==========================================================================
+//
+// Computes the attenuation and panning of a voice.
+//
+//==========================================================================
+
+void SoftSoundRenderer::CalcVoiceGains(SoftVoice *voice)
+{
+	float gain = voice->Volume * SfxVolume;
+	float pan = 0.f;
+
+	if (voice->Is3D && voice->Chan != nullptr)
+	{
+		FVector3 dir = voice->Pos - Listener.position;
+		float dist = dir.Length();
+		gain *= GetRolloff(&voice->Chan->Rolloff, dist * voice->Chan->DistanceScale);
+
+		if (dist >= 0.0004f)
+		{
+			// The listener's right in sound space, where Y is up.
+			FVector3 right(sinf(Listener.angle), 0.f, -cosf(Listener.angle));
+			pan = clamp((dir | right) / dist, -1.f, 1.f);
+			if ((voice->Flags & SNDF_AREA) && dist < AREA_SOUND_RADIUS)
+			{
+				// Area sounds surround the listener when close to them.
+				pan *= dist / AREA_SOUND_RADIUS;
+			}
+		}
+	}
+
+	if (voice->Sample != nullptr && voice->Sample->Channels == 2 && !voice->Is3D)
+	{
+		// Stereo sounds play unpanned.
+		voice->GainL = voice->GainR = gain;
+	}
+	else
+	{
+		// Constant power panning.
+		float angle = (pan + 1.f) * float(M_PI / 4);
+		voice->GainL = gain * cosf(angle);
+		voice->GainR = gain * sinf(angle);
+	}
+
+	float pitch = max(voice->Pitch, 0.0001f);
+	if (WasInWater && !(voice->Flags & SNDF_NOREVERB))
+		pitch *= PITCH_MULT;
+	if (voice->Sample != nullptr)
+		voice->Step = uint64_t(double(voice->Sample->Frequency) * pitch / OutputRate * 4294967296.);
+}
+
+void SoftSoundRenderer::StopVoice(SoftVoice *voice)
+{
+	voice->Chan = nullptr;
+	voice->Sample = nullptr;
+}
+
+void SoftSoundRenderer::StopChannel(FISoundChannel *chan)
+{
+	if (chan == nullptr || chan->SysChannel == nullptr)
+		return;
+
+	auto voice = (SoftVoice*)chan->SysChannel;
+	// Release first, so it can be properly marked as evicted if it's being killed
+	soundEngine->ChannelEnded(chan);
+	StopVoice(voice);
+
+	if (!(chan->ChanFlags & CHANF_EVICTED))
+		soundEngine->SoundDone(chan);
+}
+
+void SoftSoundRenderer::ChannelVolume(FISoundChannel *chan, float volume)
+{
+	if (chan == nullptr || chan->SysChannel == nullptr)
+		return;
+
+	auto voice = (SoftVoice*)chan->SysChannel;
+	voice->Volume = volume;
+	CalcVoiceGains(voice);
+}
+
+void SoftSoundRenderer::ChannelPitch(FISoundChannel *chan, float pitch)
+{
+	if (chan == nullptr || chan->SysChannel == nullptr)
+		return;
+
+	auto voice = (SoftVoice*)chan->SysChannel;
+	voice->Pitch = pitch;
+	CalcVoiceGains(voice);
+}
+
+void SoftSoundRenderer::MarkStartTime(FISoundChannel *chan, float startTime)
+{
+	// Uses the mixer clock so that restarted sounds stay in sync with the output.
+	uint64_t start = uint64_t(max(startTime, 0.f) * OutputRate);
+	chan->StartTime = MixClock > start ? MixClock - start : 0;
+}
+
+unsigned int SoftSoundRenderer::GetPosition(FISoundChannel *chan)
+{
+	if (chan == nullptr || chan->SysChannel == nullptr)
+		return 0;
+
+	auto voice = (SoftVoice*)chan->SysChannel;
+	return unsigned(voice->Position >> 32);
+}
+
+float SoftSoundRenderer::GetAudibility(FISoundChannel *chan)
+{
+	if (chan == nullptr || chan->SysChannel == nullptr)
+		return 0.f;
+
+	auto voice = (SoftVoice*)chan->SysChannel;
+	return voice->Volume * SfxVolume * GetRolloff(&chan->Rolloff, sqrtf(chan->DistanceSqr) * chan->DistanceScale);
+}
+
+void SoftSoundRenderer::Sync(bool sync)
+{
+	Synced = sync;
+}
+
+void SoftSoundRenderer::SetSfxPaused(bool paused, int slot)
+{
+	if (paused) SFXPaused |= 1 << slot;
+	else SFXPaused &= ~(1 << slot);
+}
+
+void SoftSoundRenderer::SetInactive(EInactiveState inactive)
+{
+	Inactive = inactive;
+}
+
+void SoftSoundRenderer::UpdateSoundParams3D(SoundListener *listener, FISoundChannel *chan, bool areasound, const FVector3 &pos, const FVector3 &vel)
+{
+	if (chan == nullptr || chan->SysChannel == nullptr)
+		return;
+
+	auto voice = (SoftVoice*)chan->SysChannel;
+	chan->DistanceSqr = (float)(pos - listener->position).LengthSquared();
+	voice->Pos = pos;
+	if (areasound) voice->Flags |= SNDF_AREA;
+	else voice->Flags &= ~SNDF_AREA;
+	CalcVoiceGains(voice);
+}
+
+void SoftSoundRenderer::UpdateListener(SoundListener *listener)
+{
+	if (!listener->valid)
+		return;
+
+	Listener = *listener;
+
+	const ReverbContainer *env = ForcedEnvironment;
+	if (!env)
+	{
+		env = listener->Environment;
+		if (!env)
+			env = DefaultEnvironments[0];
+	}
+
+	bool inwater = listener->underwater || env->SoftwareWater;
+	if (inwater && *snd_waterreverb)
+	{
+		// Find the "Underwater" reverb environment
+		auto waterenv = S_FindEnvironment(0x1600);
+		if (waterenv) env = waterenv;
+	}
+	if (env != PrevEnvironment || env->Modified)
+	{
+		PrevEnvironment = env;
+		DPrintf(DMSG_NOTIFY, "Reverb Environment %s\n", env->Name);
+		LoadReverb(env);
+		const_cast<ReverbContainer*>(env)->Modified = false;
+	}
+
+	if (inwater != WasInWater)
+	{
+		// NOTE: Moving into and out of water will undo pitch variations on sounds.
+		WasInWater = inwater;
+		for (auto &voice : Voices)
+		{
+			if (voice.Chan != nullptr) CalcVoiceGains(&voice);
+		}
+	}
+}
+
+void SoftSoundRenderer::LoadReverb(const ReverbContainer *env)
+{
+	if (env != nullptr)
+	{
+		Reverb->SetParams(env->Properties, OutputRate);
+	}
+}
+
+//==========================================================================
+//
+// Mixing
+//
+//==========================================================================
+
+void SoftSoundRenderer::UpdateSounds()
+{
+	uint64_t now = I_nsTime();
+	int frames;
+
+	if (snd_softmixframes > 0)
+	{
+		frames = snd_softmixframes;
+	}
+	else
+	{
+		// Follow the wall clock but don't try to catch up with long stalls.
+		uint64_t elapsed = min<uint64_t>(now - LastUpdate, 250'000'000);
+		frames = int(elapsed * OutputRate / 1'000'000'000);
+		// Keep the remainder for the next update.
+		now -= (elapsed * OutputRate % 1'000'000'000) / OutputRate;
+	}
+	LastUpdate = now;
+
+	MixTime.Reset();
+	MixTime.Clock();
+	Mix(frames);
+	MixTime.Unclock();
+	MixedLastUpdate = frames;
+
+	// Release channels whose sounds have finished.
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan != nullptr && voice.Ended)
+		{
+			StopChannel(voice.Chan);
+		}
+	}
+}
+
+void SoftSoundRenderer::Mix(int frames)
+{
+	if (Inactive == INACTIVE_Complete)
+		return;
+
+	while (frames > 0)
+	{
+		int count = min<int>(frames, MIX_BLOCK);
+		MixBlock(MixBuffer.Data(), count);
+		WriteOutput(MixBuffer.Data(), count);
+		MixClock += count;
+		frames -= count;
+	}
+}
+
+int SoftSoundRenderer::ResampleVoice(SoftVoice *voice, float *out, int frames)
+{
+	const SoftSample *sample = voice->Sample;
+	const int nch = sample->Channels;
+	const float *data = sample->Data.Data();
+	const bool loop = !!(voice->Flags & SNDF_LOOP);
+	const uint32_t end = loop ? sample->LoopEnd : sample->Frames;
+	const uint64_t looplen = uint64_t(sample->LoopEnd - sample->LoopStart) << 32;
+	uint64_t pos = voice->Position;
+	const uint64_t step = voice->Step;
+
+	for (int i = 0; i < frames; i++)
+	{
+		uint32_t idx = uint32_t(pos >> 32);
+		if (idx >= end)
+		{
+			if (!loop || looplen == 0)
+			{
+				voice->Position = uint64_t(sample->Frames) << 32;
+				return i;
+			}
+			while ((pos >> 32) >= end) pos -= looplen;
+			idx = uint32_t(pos >> 32);
+		}
+		uint32_t next = idx + 1;
+		if (next >= end) next = loop ? sample->LoopStart : idx;
+
+		float frac = (pos & 0xffffffff) * (1.f / 4294967296.f);
+		for (int c = 0; c < nch; c++)
+		{
+			float a = data[idx * nch + c];
+			float b = data[next * nch + c];
+			out[i * nch + c] = a + (b - a) * frac;
+		}
+		pos += step;
+	}
+	voice->Position = pos;
+	return frames;
+}
+
+void SoftSoundRenderer::MixBlock(float *out, int frames)
+{
+	memset(out, 0, frames * 2 * sizeof(float));
+	memset(WorldBuffer.Data(), 0, frames * 2 * sizeof(float));
+	memset(ReverbSend.Data(), 0, frames * sizeof(float));
+
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan == nullptr || voice.Ended)
+			continue;
+		if (Synced || (SFXPaused && !(voice.Flags & SNDF_NOPAUSE)))
+			continue;
+
+		int count = ResampleVoice(&voice, VoiceBuffer.Data(), frames);
+		if (count < frames)
+			voice.Ended = true;
+		if (count == 0)
+			continue;
+
+		// Everything that can be affected by the environment goes through the world bus.
+		float *dest = (voice.Flags & SNDF_NOREVERB) ? out : WorldBuffer.Data();
+		if (voice.Sample->Channels == 1)
+			MixMonoToStereo(dest, VoiceBuffer.Data(), count, voice.GainL, voice.GainR);
+		else
+			MixStereo(dest, VoiceBuffer.Data(), count, voice.GainL, voice.GainR);
+	}
+
+	float *world = WorldBuffer.Data();
+	if (WasInWater)
+	{
+		// Muffle everything underwater with a simple one pole lowpass.
+		for (int i = 0; i < frames; i++)
+		{
+			WaterFilter[0] += (world[i * 2] - WaterFilter[0]) * 0.125f;
+			WaterFilter[1] += (world[i * 2 + 1] - WaterFilter[1]) * 0.125f;
+			world[i * 2] = WaterFilter[0];
+			world[i * 2 + 1] = WaterFilter[1];
+		}
+	}
+	MixStereoToMono(ReverbSend.Data(), world, frames, 0.5f);
+	MixStereo(out, world, frames, 1.f, 1.f);
+	Reverb->Process(ReverbSend.Data(), out, frames);
+
+	for (auto stream : Streams)
+	{
+		stream->Mix(out, frames, OutputRate);
+	}
+}
+
+void SoftSoundRenderer::WriteOutput(const float *mix, int frames)
+{
+	float gain = Inactive == INACTIVE_Mute ? 0.f : 1.f;
+	for (int i = 0; i < frames * 2; i++)
+	{
+		PeakLevel = max(PeakLevel, fabsf(mix[i]));
+	}
+	if (WavFile != nullptr)
+	{
+		ConvertToInt16(OutputBuffer.Data(), mix, frames * 2, gain);
+		for (int i = 0; i < frames * 2; i++) OutputBuffer[i] = LittleShort(OutputBuffer[i]);
+		WavFile->Write(OutputBuffer.Data(), frames * 2 * sizeof(int16_t));
+		WavBytes += frames * 2 * sizeof(int16_t);
+	}
+}
+
+void SoftSoundRenderer::CloseOutput()
+{
+	if (WavFile == nullptr)
+		return;
+
+	struct
+	{
+		char riff[4];
+		uint32_t riffsize;
+		char wave[4];
+		char fmt[4];
+		uint32_t fmtsize;
+		uint16_t format, channels;
+		uint32_t rate, byterate;
+		uint16_t blockalign, bits;
+		char data[4];
+		uint32_t datasize;
+	} header =
+	{
+		{ 'R', 'I', 'F', 'F' }, LittleLong(WavBytes + 36), { 'W', 'A', 'V', 'E' },
+		{ 'f', 'm', 't', ' ' }, LittleLong(16u), LittleShort(uint16_t(1)), LittleShort(uint16_t(2)),
+		LittleLong(uint32_t(OutputRate)), LittleLong(uint32_t(OutputRate * 4)), LittleShort(uint16_t(4)), LittleShort(uint16_t(16)),
+		{ 'd', 'a', 't', 'a' }, LittleLong(WavBytes)
+	};
+	static_assert(sizeof(header) == 44, "WAV header must be packed");
+	WavFile->Seek(0, SEEK_SET);
+	WavFile->Write(&header, sizeof(header));
+	delete WavFile;
+	WavFile = nullptr;
+}
+
+//==========================================================================
+//
+// Diagnostics
+//
+//==========================================================================
+
+void SoftSoundRenderer::PrintStatus()
+{
+	Printf("Software mixer, no output device.\n");
+	Printf("Sample rate: " TEXTCOLOR_BLUE "%d" TEXTCOLOR_NORMAL "hz\n", OutputRate);
+	Printf("Voices: " TEXTCOLOR_BLUE "%u\n", Voices.Size());
+	Printf("Output: " TEXTCOLOR_ORANGE "%s\n", WavFile ? *snd_softwavfile : "memory");
+	Printf("Frames mixed: " TEXTCOLOR_BLUE "%llu\n", (unsigned long long)MixClock);
+}
+
+void SoftSoundRenderer::PrintDriversList()
+{
+	Printf("Software mixer uses no drivers.\n");
+}
+
+FString SoftSoundRenderer::GatherStats()
+{
+	int active = 0;
+	for (auto &voice : Voices)
+	{
+		if (voice.Chan != nullptr) active++;
+	}
+
+	FString out;
+	out.Format("%u voices (" TEXTCOLOR_YELLOW "%d" TEXTCOLOR_NORMAL " active), %u streams, " TEXTCOLOR_YELLOW "%d" TEXTCOLOR_NORMAL " frames in " TEXTCOLOR_YELLOW "%2.3f" TEXTCOLOR_NORMAL " ms, peak %.2f",
+		Voices.Size(), active, Streams.Size(), MixedLastUpdate, MixTime.TimeMS(), PeakLevel);
+	PeakLevel = 0.f;
+	return out;
+}
@@ -0,0 +1,135 @@
+//
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2026 The Redemption Team
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+
+#ifndef SOFTSOUND_H
+#define SOFTSOUND_H
+
+#include <atomic>
+
+#include "i_sound.h"
+#include "s_soundinternal.h"
+#include "stats.h"
+
+class SoftSoundStream;
+class SoftReverb;
+struct SoftSample;
+struct SoftVoice;
+
+namespace FileSys { class FileWriter; }
+
+// A sound renderer that does all mixing itself and writes the result to
+// memory or a WAV file instead of an audio device. Mixing happens in
+// UpdateSounds on the calling thread, so with snd_softmixframes set the
+// output only depends on the game, not on wall clock time.
+class SoftSoundRenderer : public SoundRenderer
+{
+public:
+	SoftSoundRenderer();
+	~SoftSoundRenderer();
+
+	void SetSfxVolume(float volume) override;
+	void SetMusicVolume(float volume) override;
+	SoundHandle LoadSound(uint8_t *sfxdata, int length, int def_loop_start, int def_loop_end) override;
+	SoundHandle LoadSoundRaw(uint8_t *sfxdata, int length, int frequency, int channels, int bits, int loopstart, int loopend = -1) override;
+	void UnloadSound(SoundHandle sfx) override;
+	unsigned int GetMSLength(SoundHandle sfx) override;
+	unsigned int GetSampleLength(SoundHandle sfx) override;
+	float GetOutputRate() override;
+
+	// Streaming sounds.
+	SoundStream *CreateStream(SoundStreamCallback callback, int buffbytes, int flags, int samplerate, void *userdata) override;
+
+	// Starts a sound.
+	FISoundChannel *StartSound(SoundHandle sfx, float vol, float pitch, int chanflags, FISoundChannel *reuse_chan, float startTime) override;
+	FISoundChannel *StartSound3D(SoundHandle sfx, SoundListener *listener, float vol, FRolloffInfo *rolloff, float distscale, float pitch, int priority, const FVector3 &pos, const FVector3 &vel, int channum, int chanflags, FISoundChannel *reuse_chan, float startTime) override;
+
+	void StopChannel(FISoundChannel *chan) override;
+	void ChannelVolume(FISoundChannel *chan, float volume) override;
+	void ChannelPitch(FISoundChannel *chan, float pitch) override;
+	void MarkStartTime(FISoundChannel *chan, float startTime) override;
+	unsigned int GetPosition(FISoundChannel *chan) override;
+	float GetAudibility(FISoundChannel *chan) override;
+	void Sync(bool sync) override;
+	void SetSfxPaused(bool paused, int slot) override;
+	void SetInactive(EInactiveState inactive) override;
+	void UpdateSoundParams3D(SoundListener *listener, FISoundChannel *chan, bool areasound, const FVector3 &pos, const FVector3 &vel) override;
+	void UpdateListener(SoundListener *) override;
+	void UpdateSounds() override;
+
+	bool IsValid() override;
+	void PrintStatus() override;
+	void PrintDriversList() override;
+	FString GatherStats() override;
+
+	// Renders the given number of output frames. UpdateSounds calls this with
+	// either the elapsed time or the fixed snd_softmixframes amount.
+	void Mix(int frames);
+
+private:
+	SoftVoice *AllocVoice(int priority, float dist_sqr);
+	FISoundChannel *StartVoice(SoftVoice *voice, SoundHandle sfx, float vol, float pitch, int chanflags, FISoundChannel *reuse_chan, float startTime);
+	void CalcVoiceGains(SoftVoice *voice);
+	void StopVoice(SoftVoice *voice);
+	int ResampleVoice(SoftVoice *voice, float *out, int frames);
+	void MixBlock(float *out, int frames);
+	void LoadReverb(const ReverbContainer *env);
+	void WriteOutput(const float *mix, int frames);
+	void CloseOutput();
+
+	void AddStream(SoftSoundStream *stream);
+	void RemoveStream(SoftSoundStream *stream);
+	friend class SoftSoundStream;
+
+	TArray<SoftVoice> Voices;
+	TArray<SoftSoundStream *> Streams;
+	SoftReverb *Reverb = nullptr;
+
+	int OutputRate;
+	float SfxVolume = 1.f;
+	float MusicVolume = 1.f;
+	int SFXPaused = 0;
+	bool Synced = false;
+	EInactiveState Inactive = INACTIVE_Active;
+
+	SoundListener Listener{};
+	bool WasInWater = false;
+	const ReverbContainer *PrevEnvironment = nullptr;
+	float WaterFilter[2] = {};
+
+	uint64_t MixClock = 0;		// output frames mixed so far
+	uint64_t LastUpdate = 0;	// wall clock of the previous mix in ns
+
+	TArray<float> MixBuffer;
+	TArray<float> WorldBuffer;
+	TArray<float> ReverbSend;
+	TArray<float> VoiceBuffer;
+	TArray<int16_t> OutputBuffer;
+
+	FileSys::FileWriter *WavFile = nullptr;
+	uint32_t WavBytes = 0;
+
+	cycle_t MixTime;
+	int MixedLastUpdate = 0;
+	float PeakLevel = 0.f;
+};
+
+#endif
@@ -863,6 +863,156 @@ FGameTexture *FFont::GetChar (int code, int translation, int *const width) const
 	return Chars[code].OriginalPic;
 }
 
+//==========================================================================
+//
+// FFont :: BuildAtlas
+//
+// Packs the character images into a few shared textures so that a string
+// can be drawn with a single texture instead of one per character.
+// Characters are packed in code order, so if a font is too large for the
+// page budget, like the Unicode console fonts, the more commonly used low
+// code points get in and the rest gets drawn from their own textures.
+//
+//==========================================================================
+
+enum
+{
+	AtlasPageSize = 1024,
+	AtlasMaxPages = 2,
+	AtlasMaxGlyphSize = 128,
+	AtlasPadding = 2,	// empty space around each character so that filtering cannot pick up a neighbor.
+};
+
+void FFont::BuildAtlas()
+{
+	AtlasBuilt = true;
+	AtlasGlyphs.Clear();
+	if (Chars.Size() < 2) return;
+
+	AtlasGlyphs.Resize(Chars.Size());
+
+	TArray<TexPartBuild> parts;
+	TArray<unsigned> partchars;
+	int pages = 0;
+	int x = 0, y = 0, rowheight = 0, pagewidth = 0;
+
+	auto finishPage = [&]()
+	{
+		if (parts.Size() > 0)
+		{
+			int pageheight = y + rowheight;
+			FStringf name("%s.atlas%d", FontName.GetChars(), pages);
+			FGameTexture *page = nullptr;
+			FTextureID pageid = TexMan.CheckForTexture(name.GetChars(), ETextureType::FontChar, 0);
+			auto base = pageid.isValid() ? dynamic_cast<FImageTexture*>(TexMan.GetGameTexture(pageid)->GetTexture()) : nullptr;
+			if (base != nullptr)
+			{
+				// A font that gets created again under the same name, e.g. when the fonts are
+				// reloaded, keeps its page textures. The packing only depends on the glyph images
+				// and their order, so if those are the same the page can be used as is.
+				page = TexMan.GetGameTexture(pageid);
+				auto oldimage = dynamic_cast<FMultiPatchTexture*>(base->GetImage());
+				bool same = oldimage != nullptr && oldimage->GetNumParts() == int(parts.Size()) &&
+					page->GetTexelWidth() == pagewidth && page->GetTexelHeight() == pageheight;
+				for (unsigned i = 0; same && i < parts.Size(); i++)
+				{
+					same = oldimage->GetImageForPart(i) == parts[i].TexImage->GetImage();
+				}
+				if (!same)
+				{
+					// Recomposite the existing texture, so that the texture list does not grow.
+					base->SetImage(new FMultiPatchTexture(pagewidth, pageheight, parts, false, false));
+					page->SetSize(pagewidth, pageheight);
+					page->CleanHardwareData();
+					delete page->GetSoftwareTexture();
+					page->SetSoftwareTexture(nullptr);
+				}
+			}
+			else
+			{
+				auto image = new FMultiPatchTexture(pagewidth, pageheight, parts, false, false);
+				page = MakeGameTexture(new FImageTexture(image), name.GetChars(), ETextureType::FontChar);
+				TexMan.AddGameTexture(page);
+			}
+
+			for (unsigned i = 0; i < parts.Size(); i++)
+			{
+				auto &glyph = AtlasGlyphs[partchars[i]];
+				auto img = parts[i].TexImage->GetImage();
+				glyph.Page = page;
+				glyph.U = parts[i].OriginX / float(pagewidth);
+				glyph.V = parts[i].OriginY / float(pageheight);
+				glyph.Width = img->GetWidth() / float(pagewidth);
+				glyph.Height = img->GetHeight() / float(pageheight);
+			}
+			pages++;
+		}
+		parts.Clear();
+		partchars.Clear();
+		x = y = rowheight = pagewidth = 0;
+	};
+
+	for (unsigned i = 0; i < Chars.Size() && pages < AtlasMaxPages; i++)
+	{
+		auto pic = Chars[i].OriginalPic;
+		if (pic == nullptr || pic->isWarped() || pic->isHardwareCanvas()) continue;
+
+		// Only plain image textures can be composited. Anything else keeps its own texture.
+		auto base = pic->GetTexture();
+		auto img = base ? base->GetImage() : nullptr;
+		if (img == nullptr) continue;
+
+		int w = img->GetWidth() + AtlasPadding * 2;
+		int h = img->GetHeight() + AtlasPadding * 2;
+		if (w <= AtlasPadding * 2 || h <= AtlasPadding * 2 || w > AtlasMaxGlyphSize || h > AtlasMaxGlyphSize) continue;
+
+		if (x + w > AtlasPageSize)
+		{
+			x = 0;
+			y += rowheight;
+			rowheight = 0;
+		}
+		if (y + h > AtlasPageSize)
+		{
+			finishPage();
+			if (pages == AtlasMaxPages) break;
+		}
+
+		auto &part = parts[parts.Reserve(1)];
+		part.TexImage = static_cast<FImageTexture*>(base);
+		part.OriginX = x + AtlasPadding;
+		part.OriginY = y + AtlasPadding;
+		partchars.Push(i);
+
+		x += w;
+		rowheight = max(rowheight, h);
+		pagewidth = max(pagewidth, x);
+	}
+	finishPage();
+}
+
+//==========================================================================
+//
+// FFont :: GetAtlasGlyph
+//
+// Returns null if the character is not on an atlas page. 'pic' must be
+// what GetChar returned for the character.
+//
+//==========================================================================
+
+const FFontAtlasGlyph *FFont::GetAtlasGlyph(int code, FGameTexture *pic)
+{
+	if (!AtlasBuilt) BuildAtlas();
+
+	code = GetCharCode(code, true);
+	if (code < 0 || unsigned(code - FirstChar) >= AtlasGlyphs.Size()) return nullptr;
+	code -= FirstChar;
+
+	// Subclasses which override GetChar may return something different from what's in Chars.
+	if (AtlasGlyphs[code].Page == nullptr || Chars[code].OriginalPic != pic) return nullptr;
+	return &AtlasGlyphs[code];
+}
+
 //==========================================================================
 //
 // FFont :: GetCharWidth
@@ -928,6 +928,7 @@ void V_LoadTranslations()
 
 void V_ClearFonts()
 {
+	V_ClearTextLayouts();
 	while (FFont::FirstFont != nullptr)
 	{
 		delete FFont::FirstFont;
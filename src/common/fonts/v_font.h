@@ -83,6 +83,13 @@ extern int NumTextColors;
 
 using GlyphSet = TMap<int, FGameTexture*>;
 
+// Where a character lives on one of its font's shared atlas textures.
+struct FFontAtlasGlyph
+{
+	FGameTexture *Page = nullptr;
+	float U = 0, V = 0, Width = 0, Height = 0;	// normalized source rectangle on the page
+};
+
 class FFont
 {
 	friend void V_LoadTranslations();
@@ -105,6 +112,7 @@ public:
 
 	virtual FGameTexture *GetChar (int code, int translation, int *const width) const;
 	virtual int GetCharWidth (int code) const;
+	const FFontAtlasGlyph *GetAtlasGlyph(int code, FGameTexture *pic);
 	FTranslationID GetColorTranslation (EColorRange range, PalEntry *color = nullptr) const;
 	int GetLump() const { return Lump; }
 	int GetSpaceWidth () const { return SpaceWidth; }
@@ -170,6 +178,8 @@ public:
 		Translations = other.Translations;
 		lowercaselatinonly = other.lowercaselatinonly;
 		Lump = other.Lump;
+		AtlasGlyphs.Clear();
+		AtlasBuilt = false;
 	}
 
 protected:
@@ -177,6 +187,7 @@ protected:
 	void FixXMoves();
 
 	void ReadSheetFont(std::vector<FileSys::FolderEntry> &folderdata, int width, int height, const DVector2 &Scale);
+	void BuildAtlas();
 
 	EFontType Type = EFontType::Unknown;
 	FName AltFontName = NAME_None;
@@ -199,6 +210,8 @@ protected:
 	};
 	TArray<CharData> Chars;
 	TArray<FTranslationID> Translations;
+	TArray<FFontAtlasGlyph> AtlasGlyphs;	// parallel to Chars, built on first use
+	bool AtlasBuilt = false;
 
 	int Lump;
 	FName FontName = NAME_None;
@@ -215,6 +228,7 @@ extern FFont *SmallFont, *SmallFont2, *BigFont, *BigUpper, *ConFont, *Intermissi
 
 void V_InitFonts();
 void V_ClearFonts();
+void V_ClearTextLayouts();
 EColorRange V_FindFontColor (FName name);
 PalEntry V_LogColorFromColorRange (EColorRange range);
 EColorRange V_ParseFontColor (const uint8_t *&color_value, int normalcolor, int boldcolor);
@@ -3,6 +3,35 @@
 #include "matrix.h"
 #include "model.h"
 
+// Everything a model's bone pose depends on. Models in the same pose can share one set of bones.
+struct FBonePoseKey
+{
+	FModel* model;
+	int frame1, frame2;
+	int frame1_prev, frame2_prev;
+	float inter, inter1_prev, inter2_prev;
+};
+
+template<> struct THashTraits<FBonePoseKey>
+{
+	hash_t Hash(const FBonePoseKey& key)
+	{
+		hash_t h = (hash_t)(((intptr_t)key.model) >> 4);
+		h = h * 31 + key.frame1;
+		h = h * 31 + key.frame2;
+		h = h * 31 + key.frame1_prev;
+		h = h * 31 + key.frame2_prev;
+		h = h * 31 + (hash_t)(int32_t)(key.inter * 65536.f);
+		return h;
+	}
+	int Compare(const FBonePoseKey& left, const FBonePoseKey& right)
+	{
+		return left.model != right.model || left.frame1 != right.frame1 || left.frame2 != right.frame2 ||
+			left.frame1_prev != right.frame1_prev || left.frame2_prev != right.frame2_prev ||
+			left.inter != right.inter || left.inter1_prev != right.inter1_prev || left.inter2_prev != right.inter2_prev;
+	}
+};
+
 class FModelRenderer
 {
 public:
@@ -25,5 +54,12 @@ public:
 	virtual void DrawArrays(int start, int count) = 0;
 	virtual void DrawElements(int numIndices, size_t offset) = 0;
 	virtual int SetupFrame(FModel* model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex) { return -1; };
+
+	// Bones uploaded earlier in the frame for the same pose, or -1.
+	virtual int FindBonePose(const FBonePoseKey& key) { return -1; }
+	virtual void AddBonePose(const FBonePoseKey& key, int boneStartIndex) {}
+
+	// A bone prepass only evaluates and uploads bones. It must not touch any render state because it runs on worker threads.
+	virtual bool IsBonePrepass() const { return false; }
 };
 
@@ -560,7 +560,16 @@ static TRS InterpolateBone(const TRS &from, const TRS &to, float t, float invt)
 	return bone;
 }
 
-const TArray<VSMatrix> IQMModel::CalculateBones(int frame1, int frame2, float inter, int frame1_prev, float inter1_prev, int frame2_prev, float inter2_prev, const TArray<TRS>* animationData, DBoneComponents* boneComponentData, int index)
+//===========================================================================
+//
+// Evaluates the pose straight into the actor's cached bone matrices,
+// so that bones which did not change keep their matrix and nothing
+// needs to be allocated per call. Can run on worker threads as long as
+// no two threads evaluate the same actor.
+//
+//===========================================================================
+
+const TArray<VSMatrix>* IQMModel::CalculateBones(int frame1, int frame2, float inter, int frame1_prev, float inter1_prev, int frame2_prev, float inter2_prev, const TArray<TRS>* animationData, DBoneComponents* boneComponentData, int index)
 {
 	const TArray<TRS>& animationFrames = animationData ? *animationData : TRSData;
 	if (Joints.Size() > 0)
@@ -591,8 +600,11 @@ const TArray<VSMatrix> IQMModel::CalculateBones(int frame1, int frame2, float in
 		swapYZ[2 + 1 * 4] = 1.0f;
 		swapYZ[3 + 3 * 4] = 1.0f;
 
-		TArray<VSMatrix> bones(numbones, true);
-		TArray<bool> modifiedBone(numbones, true);
+		TArray<TRS>& components = boneComponentData->trscomponents[index];
+		TArray<VSMatrix>& bones = boneComponentData->trsmatrix[index];
+
+		static thread_local TArray<bool> modifiedBone;
+		modifiedBone.Resize(numbones);
 		for (int i = 0; i < numbones; i++)
 		{
 			TRS prev;
@@ -618,18 +630,18 @@ const TArray<VSMatrix> IQMModel::CalculateBones(int frame1, int frame2, float in
 
 			if (Joints[i].Parent >= 0 && modifiedBone[Joints[i].Parent])
 			{
-				boneComponentData->trscomponents[index][i] = bone;
+				components[i] = bone;
 				modifiedBone[i] = true;
 			}
-			else if (boneComponentData->trscomponents[index][i].Equals(bone))
+			else if (components[i].Equals(bone))
 			{
-				bones[i] = boneComponentData->trsmatrix[index][i];
+				// bones[i] still holds the matrix for this transform
 				modifiedBone[i] = false;
 				continue;
 			}
 			else
 			{
-				boneComponentData->trscomponents[index][i] = bone;
+				components[i] = bone;
 				modifiedBone[i] = true;
 			}
 
@@ -657,9 +669,7 @@ const TArray<VSMatrix> IQMModel::CalculateBones(int frame1, int frame2, float in
 			result.multMatrix(swapYZ);
 		}
 
-		boneComponentData->trsmatrix[index] = bones;
-
-		return bones;
+		return &bones;
 	}
-	return {};
+	return nullptr;
 }
@@ -178,6 +178,7 @@ public: \
 #define _X_VMEXPORT_false(cls)		nullptr
 
 #include "dobjgc.h"
+#include "dobjpool.h"
 
 class DObject
 {
@@ -266,18 +267,18 @@ private:
 
 	void *operator new(size_t len, nonew&)
 	{
-		return M_Calloc(len, 1);
+		return ObjPool::Alloc(len, true);
 	}
 public:
 
 	void operator delete (void *mem, nonew&)
 	{
-		M_Free(mem);
+		ObjPool::Free(mem);
 	}
 
 	void operator delete (void *mem)
 	{
-		M_Free(mem);
+		ObjPool::Free(mem);
 	}
 
 	// GC fiddling
@@ -344,7 +345,7 @@ protected:
 
 	void operator delete (void *mem, EInPlace *)
 	{
-		M_Free (mem);
+		ObjPool::Free (mem);
 	}
 
 	template<typename T, typename... Args>
@@ -590,6 +590,9 @@ void FullGC()
 			ContinueCheck |= HadToDestroy;
 		} while (HadToDestroy);
 	}
+	// A full collection usually happens between levels, which is a good
+	// time to give back slabs that were only needed by the previous map.
+	ObjPool::Trim();
 }
 
 //==========================================================================
@@ -787,6 +790,8 @@ ADD_STAT(gc)
 		(GC::AllocBytes + 1023) >> 10,
 		(GC::Estimate + 1023) >> 10,
 		(GC::Threshold + 1023) >> 10);
+	out << "\n";
+	ObjPool::FormatSummary(out);
 	return out;
 }
 
@@ -842,7 +847,7 @@ CCMD(gc)
 {
 	if (argv.argc() == 1)
 	{
-		Printf ("Usage: gc stop|now|full|count|pause [size]|stepmul [size]\n");
+		Printf ("Usage: gc stop|now|full|count|pools|trim|pause [size]|stepmul [size]\n");
 		return;
 	}
 	if (stricmp(argv[1], "stop") == 0)
@@ -863,6 +868,15 @@ CCMD(gc)
 		for (DObject *obj = GC::Root; obj; obj = obj->ObjNext, cnt++);
 		Printf("%d active objects counted\n", cnt);
 	}
+	else if (stricmp(argv[1], "pools") == 0)
+	{
+		ObjPool::DumpStats();
+	}
+	else if (stricmp(argv[1], "trim") == 0)
+	{
+		size_t released = ObjPool::Trim();
+		Printf("%zuK of empty object slabs released\n", (released + 1023) >> 10);
+	}
 	else if (stricmp(argv[1], "pause") == 0)
 	{
 		if (argv.argc() == 2)
@@ -0,0 +1,317 @@
+//
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2026 The Redemption Team
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+/*
+** dobjpool.cpp
+** Size-class slab allocator for DObject instances
+**
+** Every allocation is preceded by a small header that records the slab it
+** was carved from (or null for heap allocations), so objects can be freed
+** without knowing their size and pooling may be toggled at any time.
+** Pooled objects are reported to the GC per cell, as M_Malloc would have
+** reported them, so the slabs themselves come straight from malloc.
+**
+*/
+
+#include <stdint.h>
+#include "dobjpool.h"
+#include "m_alloc.h"
+#include "dobjgc.h"
+#include "c_cvars.h"
+#include "printf.h"
+#include "zstring.h"
+
+CVARD(Bool, gc_objpool, true, 0, "allocate script objects and actors from size-class slabs")
+
+namespace ObjPool
+{
+
+struct FPoolClass;
+
+struct alignas(16) FSlab
+{
+	FSlab *Next;
+	FPoolClass *Owner;
+	uint32_t Live;
+	uint32_t Cells;
+};
+
+struct alignas(16) FCellHeader
+{
+	FSlab *Slab;
+	uint32_t Size;
+};
+
+struct FFreeCell
+{
+	FFreeCell *Next;
+};
+
+struct FPoolClass
+{
+	FSlab *Slabs;
+	FFreeCell *FreeList;
+	size_t NumSlabs;
+	size_t Live;
+	size_t Free;
+	size_t TotalAllocs;
+};
+
+// Plain zero-initialized storage, so objects created during static
+// initialization can already use it.
+static FPoolClass Classes[NumClasses];
+static size_t SlabBytes;
+static size_t HeapLive;
+static size_t HeapBytes;
+
+//==========================================================================
+//
+// CellSize
+//
+//==========================================================================
+
+static inline size_t CellSize(unsigned cls)
+{
+	return sizeof(FCellHeader) + (cls + 1) * Granularity;
+}
+
+//==========================================================================
+//
+// NewSlab
+//
+// Carves a fresh slab into cells and pushes them all onto the free list.
+// Cells are pushed in reverse so that consecutive allocations walk the
+// slab front to back.
+//
+//==========================================================================
+
+static void NewSlab(unsigned cls)
+{
+	FPoolClass &pc = Classes[cls];
+	size_t cellsize = CellSize(cls);
+	size_t cells = (SlabSize - sizeof(FSlab)) / cellsize;
+	if (cells < MinCellsPerSlab) cells = MinCellsPerSlab;
+	size_t bytes = sizeof(FSlab) + cells * cellsize;
+
+	auto slab = (FSlab *)malloc(bytes);
+	if (slab == nullptr)
+		I_FatalError("Could not malloc %zu bytes", bytes);
+	slab->Next = pc.Slabs;
+	slab->Owner = &pc;
+	slab->Live = 0;
+	slab->Cells = (uint32_t)cells;
+	pc.Slabs = slab;
+	pc.NumSlabs++;
+	pc.Free += cells;
+	SlabBytes += bytes;
+
+	uint8_t *base = (uint8_t *)(slab + 1);
+	for (size_t i = cells; i-- > 0; )
+	{
+		auto header = (FCellHeader *)(base + i * cellsize);
+		header->Slab = slab;
+		header->Size = uint32_t((cls + 1) * Granularity);
+		auto cell = (FFreeCell *)(header + 1);
+		cell->Next = pc.FreeList;
+		pc.FreeList = cell;
+	}
+}
+
+//==========================================================================
+//
+// Alloc
+//
+//==========================================================================
+
+void *Alloc(size_t size, bool zero)
+{
+	if (size == 0) size = 1;
+
+	if (size > MaxPooledSize || !gc_objpool)
+	{
+		auto header = (FCellHeader *)M_Malloc(sizeof(FCellHeader) + size);
+		header->Slab = nullptr;
+		header->Size = (uint32_t)size;
+		HeapLive++;
+		HeapBytes += size;
+		void *mem = header + 1;
+		if (zero) memset(mem, 0, size);
+		return mem;
+	}
+
+	unsigned cls = unsigned((size + Granularity - 1) / Granularity - 1);
+	FPoolClass &pc = Classes[cls];
+	if (pc.FreeList == nullptr)
+	{
+		NewSlab(cls);
+	}
+	FFreeCell *cell = pc.FreeList;
+	pc.FreeList = cell->Next;
+	pc.Free--;
+	pc.Live++;
+	pc.TotalAllocs++;
+	((FCellHeader *)cell - 1)->Slab->Live++;
+	GC::ReportAlloc(CellSize(cls));
+	if (zero) memset(cell, 0, size);
+	return cell;
+}
+
+//==========================================================================
+//
+// Free
+//
+//==========================================================================
+
+void Free(void *mem)
+{
+	if (mem == nullptr) return;
+
+	auto header = (FCellHeader *)mem - 1;
+	FSlab *slab = header->Slab;
+	if (slab == nullptr)
+	{
+		HeapLive--;
+		HeapBytes -= header->Size;
+		M_Free(header);
+		return;
+	}
+
+	FPoolClass &pc = *slab->Owner;
+	auto cell = (FFreeCell *)mem;
+	cell->Next = pc.FreeList;
+	pc.FreeList = cell;
+	pc.Free++;
+	pc.Live--;
+	slab->Live--;
+	GC::ReportDealloc(sizeof(FCellHeader) + header->Size);
+}
+
+//==========================================================================
+//
+// Trim
+//
+// Returns slabs without any live objects to the heap. Returns the number
+// of bytes released.
+//
+//==========================================================================
+
+size_t Trim()
+{
+	size_t released = 0;
+
+	for (unsigned cls = 0; cls < NumClasses; cls++)
+	{
+		FPoolClass &pc = Classes[cls];
+		bool anyempty = false;
+		for (FSlab *slab = pc.Slabs; slab != nullptr; slab = slab->Next)
+		{
+			if (slab->Live == 0)
+			{
+				anyempty = true;
+				break;
+			}
+		}
+		if (!anyempty) continue;
+
+		// Drop the free cells belonging to empty slabs from the free list.
+		FFreeCell **link = &pc.FreeList;
+		while (*link != nullptr)
+		{
+			FFreeCell *cell = *link;
+			if (((FCellHeader *)cell - 1)->Slab->Live == 0)
+			{
+				*link = cell->Next;
+			}
+			else
+			{
+				link = &cell->Next;
+			}
+		}
+
+		FSlab **slink = &pc.Slabs;
+		while (*slink != nullptr)
+		{
+			FSlab *slab = *slink;
+			if (slab->Live == 0)
+			{
+				size_t bytes = sizeof(FSlab) + slab->Cells * CellSize(cls);
+				*slink = slab->Next;
+				pc.Free -= slab->Cells;
+				pc.NumSlabs--;
+				SlabBytes -= bytes;
+				released += bytes;
+				free(slab);
+			}
+			else
+			{
+				slink = &slab->Next;
+			}
+		}
+	}
+	return released;
+}
+
+//==========================================================================
+//
+// FormatSummary
+//
+// One line summary for the gc stat.
+//
+//==========================================================================
+
+void FormatSummary(FString &out)
+{
+	size_t slabs = 0, live = 0, free = 0;
+	for (auto &pc : Classes)
+	{
+		slabs += pc.NumSlabs;
+		live += pc.Live;
+		free += pc.Free;
+	}
+	out.AppendFormat("Pools:%6zuK in %4zu slabs  Live:%6zu  Free:%6zu  Heap:%4zu (%zuK)",
+		(SlabBytes + 1023) >> 10, slabs, live, free, HeapLive, (HeapBytes + 1023) >> 10);
+}
+
+//==========================================================================
+//
+// DumpStats
+//
+// Per size class breakdown for 'gc pools'.
+//
+//==========================================================================
+
+void DumpStats()
+{
+	Printf("%5s %6s %8s %8s %10s %8s\n", "Size", "Slabs", "Live", "Free", "Allocs", "Fill");
+	for (unsigned cls = 0; cls < NumClasses; cls++)
+	{
+		const FPoolClass &pc = Classes[cls];
+		if (pc.NumSlabs == 0 && pc.TotalAllocs == 0) continue;
+		size_t total = pc.Live + pc.Free;
+		Printf("%5u %6zu %8zu %8zu %10zu %7.1f%%\n", (cls + 1) * Granularity, pc.NumSlabs, pc.Live, pc.Free, pc.TotalAllocs,
+			total > 0 ? pc.Live * 100. / total : 0.);
+	}
+	FString out;
+	FormatSummary(out);
+	Printf("%s\n", out.GetChars());
+}
+
+}
@@ -0,0 +1,53 @@
+//
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2026 The Redemption Team
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <stddef.h>
+
+class FString;
+
+// Slab allocator backing all DObject allocations. Objects are grouped into
+// 16 byte size classes, each of which carves its cells from large contiguous
+// slabs so that actors and thinkers of the same size end up next to each
+// other in memory. Anything larger than the biggest class goes to the heap.
+
+namespace ObjPool
+{
+	enum
+	{
+		Granularity = 16,
+		MaxPooledSize = 4096,
+		NumClasses = MaxPooledSize / Granularity,
+		SlabSize = 64 * 1024,
+		MinCellsPerSlab = 8,
+	};
+
+	void *Alloc(size_t size, bool zero = false);
+	void Free(void *mem);
+
+	// Releases slabs that no longer hold any live objects.
+	size_t Trim();
+
+	void FormatSummary(FString &out);
+	void DumpStats();
+}
@@ -135,6 +135,7 @@ bool FGLRenderState::ApplyShader()
 	activeShader->muAlphaThreshold.Set(mAlphaThreshold);
 	activeShader->muLightIndex.Set(-1);
 	activeShader->muBoneIndexBase.Set(-1);
+	activeShader->muInstanceIndexBase.Set(-1);
 	activeShader->muClipSplit.Set(mClipSplit);
 	activeShader->muSpecularMaterial.Set(mGlossiness, mSpecularLevel);
 	activeShader->muAddColor.Set(mStreamData.uAddColor);
@@ -204,28 +205,36 @@ bool FGLRenderState::ApplyShader()
 		size_t start, size;
 		index = screen->mLights->GetBinding(index, &start, &size);
 
-		if (start != mLastMappedLightIndex || screen->mPipelineNbr > 1) // If multiple buffers always bind
+		IDataBuffer *buffer = screen->mLights->GetBuffer();
+		if (start != mLastMappedLightIndex || buffer != mLastMappedLightBuffer)
 		{
 			mLastMappedLightIndex = start;
-			static_cast<GLDataBuffer*>(screen->mLights->GetBuffer())->BindRange(nullptr, start, size);
+			mLastMappedLightBuffer = buffer;
+			static_cast<GLDataBuffer*>(buffer)->BindRange(nullptr, start, size);
 		}
 	}
 
 	activeShader->muLightIndex.Set(index);
 
+	// Bones and model instances share the bone buffer. A draw never uses both.
 	index = mBoneIndexBase;
-	if (!screen->mBones->GetBufferType() && index >= 0) // Uniform buffer fallback support
+	int instanceindex = mInstanceIndexBase;
+	if (!screen->mBones->GetBufferType() && (index >= 0 || instanceindex >= 0)) // Uniform buffer fallback support
 	{
 		size_t start, size;
-		index = screen->mBones->GetBinding(index, &start, &size);
+		if (index >= 0) index = screen->mBones->GetBinding(index, &start, &size);
+		else instanceindex = screen->mBones->GetBinding(instanceindex, &start, &size);
 
-		if (start != mLastMappedBoneIndexBase || screen->mPipelineNbr > 1) // If multiple buffers always bind
+		IDataBuffer *buffer = screen->mBones->GetBuffer();
+		if (start != mLastMappedBoneIndexBase || buffer != mLastMappedBoneBuffer)
 		{
 			mLastMappedBoneIndexBase = start;
-			static_cast<GLDataBuffer*>(screen->mBones->GetBuffer())->BindRange(nullptr, start, size);
+			mLastMappedBoneBuffer = buffer;
+			static_cast<GLDataBuffer*>(buffer)->BindRange(nullptr, start, size);
 		}
 	}
 	activeShader->muBoneIndexBase.Set(index);
+	activeShader->muInstanceIndexBase.Set(instanceindex);
 
 	return true;
 }
@@ -439,6 +448,46 @@ void FGLRenderState::DrawIndexed(int dt, int index, int count, bool apply)
 	drawcalls.Unclock();
 }
 
+void FGLRenderState::DrawIndexedRanges(int dt, const FIndexedDrawRange *ranges, int count, bool apply)
+{
+	if (apply)
+	{
+		Apply();
+	}
+	drawcalls.Clock();
+	mMultiDrawCounts.Resize(count);
+	mMultiDrawIndices.Resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		mMultiDrawCounts[i] = ranges[i].count;
+		mMultiDrawIndices[i] = (void*)(intptr_t)(ranges[i].index * sizeof(uint32_t));
+	}
+	glMultiDrawElements(dt2gl[dt], mMultiDrawCounts.Data(), GL_UNSIGNED_INT, mMultiDrawIndices.Data(), count);
+	drawcalls.Unclock();
+}
+
+void FGLRenderState::DrawInstanced(int dt, int index, int count, int instances, bool apply)
+{
+	if (apply)
+	{
+		Apply();
+	}
+	drawcalls.Clock();
+	glDrawArraysInstanced(dt2gl[dt], index, count, instances);
+	drawcalls.Unclock();
+}
+
+void FGLRenderState::DrawIndexedInstanced(int dt, int index, int count, int instances, bool apply)
+{
+	if (apply)
+	{
+		Apply();
+	}
+	drawcalls.Clock();
+	glDrawElementsInstanced(dt2gl[dt], count, GL_UNSIGNED_INT, (void*)(intptr_t)(index * sizeof(uint32_t)), instances);
+	drawcalls.Unclock();
+}
+
 void FGLRenderState::SetDepthMask(bool on)
 {
 	glDepthMask(on);
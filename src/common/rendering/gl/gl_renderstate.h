@@ -67,11 +67,16 @@ class FGLRenderState final : public FRenderState
 	int maxBoundMaterial = -1;
 	size_t mLastMappedLightIndex = SIZE_MAX;
 	size_t mLastMappedBoneIndexBase = SIZE_MAX;
+	IDataBuffer *mLastMappedLightBuffer = nullptr;
+	IDataBuffer *mLastMappedBoneBuffer = nullptr;
 
 	IVertexBuffer *mCurrentVertexBuffer;
 	int mCurrentVertexOffsets[2];	// one per binding point
 	IIndexBuffer *mCurrentIndexBuffer;
 
+	TArray<GLsizei> mMultiDrawCounts;
+	TArray<const void*> mMultiDrawIndices;
+
 
 public:
 
@@ -123,6 +128,10 @@ public:
 	void ClearScreen() override;
 	void Draw(int dt, int index, int count, bool apply = true) override;
 	void DrawIndexed(int dt, int index, int count, bool apply = true) override;
+	void DrawIndexedRanges(int dt, const FIndexedDrawRange *ranges, int count, bool apply = true) override;
+	bool SupportsInstancing() const override { return true; }
+	void DrawInstanced(int dt, int index, int count, int instances, bool apply = true) override;
+	void DrawIndexedInstanced(int dt, int index, int count, int instances, bool apply = true) override;
 
 	bool SetDepthClamp(bool on) override;
 	void SetDepthMask(bool on) override;
@@ -282,6 +282,9 @@ bool FShader::Load(const char * name, const char * vert_prog_lump, const char *
 		// bone animation
 		uniform int uBoneIndexBase;
 
+		// model instancing
+		uniform int uInstanceIndexBase;
+
 		// Blinn glossiness and specular level
 		uniform vec2 uSpecularMaterial;
 
@@ -584,6 +587,7 @@ bool FShader::Load(const char * name, const char * vert_prog_lump, const char *
 	muClipSplit.Init(hShader, "uClipSplit");
 	muLightIndex.Init(hShader, "uLightIndex");
 	muBoneIndexBase.Init(hShader, "uBoneIndexBase");
+	muInstanceIndexBase.Init(hShader, "uInstanceIndexBase");
 	muFogColor.Init(hShader, "uFogColor");
 	muDynLightColor.Init(hShader, "uDynLightColor");
 	muObjectColor.Init(hShader, "uObjectColor");
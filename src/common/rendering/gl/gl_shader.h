@@ -242,6 +242,7 @@ class FShader
 	FBufferedUniform2f muClipSplit;
 	FBufferedUniform1i muLightIndex;
 	FBufferedUniform1i muBoneIndexBase;
+	FBufferedUniform1i muInstanceIndexBase;
 	FBufferedUniformPE muFogColor;
 	FBufferedUniform4f muDynLightColor;
 	FBufferedUniformPE muObjectColor;
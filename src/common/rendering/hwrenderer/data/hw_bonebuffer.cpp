@@ -26,18 +26,15 @@
 
 static const int BONE_SIZE = (16*sizeof(float));
 
-BoneBuffer::BoneBuffer(int pipelineNbr) : mPipelineNbr(pipelineNbr)
+BoneBuffer::BoneBuffer(int pipelineNbr)
 {
 	int maxNumberOfBones = 80000;
 
-	mBufferSize = maxNumberOfBones;
-	mByteSize = mBufferSize * BONE_SIZE;
-
 	if (screen->useSSBO())
 	{
 		mBufferType = true;
 		mBlockAlign = 0;
-		mBlockSize = mBufferSize;
+		mBlockSize = maxNumberOfBones;
 		mMaxUploadSize = mBlockSize;
 	}
 	else
@@ -48,54 +45,36 @@ BoneBuffer::BoneBuffer(int pipelineNbr) : mPipelineNbr(pipelineNbr)
 		mMaxUploadSize = (mBlockSize - mBlockAlign);
 	}
 
-	for (int n = 0; n < mPipelineNbr; n++)
-	{
-		mBufferPipeline[n] = screen->CreateDataBuffer(BONEBUF_BINDINGPOINT, mBufferType, false);
-		mBufferPipeline[n]->SetData(mByteSize, nullptr, BufferUsageType::Persistent);
-	}
-
-	Clear();
+	mRing.reset(new HWFrameRingBuffer(BONEBUF_BINDINGPOINT, mBufferType, false, BONE_SIZE, maxNumberOfBones, pipelineNbr));
 }
 
 BoneBuffer::~BoneBuffer()
 {
-	delete mBuffer;
 }
 
 void BoneBuffer::Clear()
 {
-	mIndex = 0;
-
-	mPipelinePos++;
-	mPipelinePos %= mPipelineNbr;
-
-	mBuffer = mBufferPipeline[mPipelinePos];
+	mRing->NextFrame();
 }
 
-int BoneBuffer::UploadBones(const TArray<VSMatrix>& bones)
+int BoneBuffer::UploadBones(const VSMatrix *bones, int count)
 {
-	int totalsize = bones.Size();
+	int totalsize = count;
 	if (totalsize > (int)mMaxUploadSize)
 	{
 		totalsize = mMaxUploadSize;
 	}
 
-	uint8_t *mBufferPointer = (uint8_t*)mBuffer->Memory();
-	assert(mBufferPointer != nullptr);
-	if (mBufferPointer == nullptr) return -1;
+	assert(GetBuffer()->Memory() != nullptr);
+	if (GetBuffer()->Memory() == nullptr) return -1;
 	if (totalsize <= 0) return -1;	// there are no bones
 
-	unsigned int thisindex = mIndex.fetch_add(totalsize);
+	// If the buffer is full there is not much we can do here since it is being used live, so abort.
+	int thisindex = mRing->Alloc(totalsize);
+	if (thisindex < 0) return -1;
 
-	if (thisindex + totalsize <= mBufferSize)
-	{
-		memcpy(mBufferPointer + thisindex * BONE_SIZE, bones.Data(), totalsize * BONE_SIZE);
-		return thisindex;
-	}
-	else
-	{
-		return -1;	// Buffer is full. Since it is being used live at the point of the upload we cannot do much here but to abort.
-	}
+	memcpy(mRing->GetElement(thisindex), bones, totalsize * BONE_SIZE);
+	return thisindex;
 }
 
 int BoneBuffer::GetBinding(unsigned int index, size_t* pOffset, size_t* pSize)
@@ -3,44 +3,41 @@
 #include "tarray.h"
 #include "hwrenderer/data/buffers.h"
 #include "common/utility/matrix.h"
-#include <atomic>
-#include <mutex>
+#include "hw_ringbuffer.h"
+#include <memory>
 
 class FRenderState;
 
 class BoneBuffer
 {
-	IDataBuffer *mBuffer;
-	IDataBuffer* mBufferPipeline[HW_MAX_PIPELINE_BUFFERS];
-	int mPipelineNbr;
-	int mPipelinePos = 0;
+	std::unique_ptr<HWFrameRingBuffer> mRing;
 
 	bool mBufferType;
-    std::atomic<unsigned int> mIndex;
 	unsigned int mBlockAlign;
 	unsigned int mBlockSize;
-	unsigned int mBufferSize;
-	unsigned int mByteSize;
-    unsigned int mMaxUploadSize;
+	unsigned int mMaxUploadSize;
 
 public:
 	BoneBuffer(int pipelineNbr = 1);
 	~BoneBuffer();
 
 	void Clear();
-	int UploadBones(const TArray<VSMatrix> &bones);
-	void Map() { mBuffer->Map(); }
-	void Unmap() { mBuffer->Unmap(); }
+	int UploadBones(const TArray<VSMatrix> &bones) { return UploadBones(bones.Data(), bones.Size()); }
+	int UploadBones(const VSMatrix *bones, int count);
+	void Map() { mRing->Map(); }
+	void Unmap() { mRing->Unmap(); }
 	unsigned int GetBlockSize() const { return mBlockSize; }
+	unsigned int GetMaxUploadSize() const { return mMaxUploadSize; }
 	bool GetBufferType() const { return mBufferType; }
 	int GetBinding(unsigned int index, size_t* pOffset, size_t* pSize);
+	const HWFrameRingBuffer& GetRing() const { return *mRing; }
 
 	// Only for GLES to determin how much data is in the buffer
-	int GetCurrentIndex() { return mIndex; };
+	int GetCurrentIndex() { return mRing->GetUsed(); };
 
 	// OpenGL needs the buffer to mess around with the binding.
 	IDataBuffer* GetBuffer() const
 	{
-		return mBuffer;
+		return mRing->GetBuffer();
 	}
 };
@@ -33,19 +33,16 @@ static const int ELEMENTS_PER_LIGHT = 4;			// each light needs 4 vec4's.
 static const int ELEMENT_SIZE = (4*sizeof(float));
 
 
-FLightBuffer::FLightBuffer(int pipelineNbr):
-	mPipelineNbr(pipelineNbr)
+FLightBuffer::FLightBuffer(int pipelineNbr)
 {
 	int maxNumberOfLights = 80000;
-
-	mBufferSize = maxNumberOfLights * ELEMENTS_PER_LIGHT;
-	mByteSize = mBufferSize * ELEMENT_SIZE;
+	unsigned int bufferSize = maxNumberOfLights * ELEMENTS_PER_LIGHT;
 
 	if (screen->useSSBO())
 	{
 		mBufferType = true;
 		mBlockAlign = 0;
-		mBlockSize = mBufferSize;
+		mBlockSize = bufferSize;
 		mMaxUploadSize = mBlockSize;
 	}
 	else
@@ -54,32 +51,18 @@ FLightBuffer::FLightBuffer(int pipelineNbr):
 		mBlockSize = screen->maxuniformblock / ELEMENT_SIZE;
 		mBlockAlign = screen->uniformblockalignment / ELEMENT_SIZE;
 		mMaxUploadSize = (mBlockSize - mBlockAlign);
-
-		//mByteSize += screen->maxuniformblock;	// to avoid mapping beyond the end of the buffer. REMOVED this...This can try to allocate 100's of MB..
 	}
 
-	for (int n = 0; n < mPipelineNbr; n++)
-	{
-		mBufferPipeline[n] = screen->CreateDataBuffer(LIGHTBUF_BINDINGPOINT, mBufferType, false);
-		mBufferPipeline[n]->SetData(mByteSize, nullptr, BufferUsageType::Persistent);
-	}
-
-	Clear();
+	mRing.reset(new HWFrameRingBuffer(LIGHTBUF_BINDINGPOINT, mBufferType, false, ELEMENT_SIZE, bufferSize, pipelineNbr));
 }
 
 FLightBuffer::~FLightBuffer()
 {
-	delete mBuffer;
 }
 
 void FLightBuffer::Clear()
 {
-	mIndex = 0;
-
-	mPipelinePos++;
-	mPipelinePos %= mPipelineNbr;
-
-	mBuffer = mBufferPipeline[mPipelinePos];
+	mRing->NextFrame();
 }
 
 int FLightBuffer::UploadLights(FDynLightData &data)
@@ -108,28 +91,22 @@ int FLightBuffer::UploadLights(FDynLightData &data)
 		totalsize = size0 + size1 + size2 + 1;
 	}
 
-	float *mBufferPointer = (float*)mBuffer->Memory();
-	assert(mBufferPointer != nullptr);
-	if (mBufferPointer == nullptr) return -1;
+	assert(GetBuffer()->Memory() != nullptr);
+	if (GetBuffer()->Memory() == nullptr) return -1;
 	if (totalsize <= 1) return -1;	// there are no lights
 
-	unsigned thisindex = mIndex.fetch_add(totalsize);
-	float parmcnt[] = { 0, float(size0), float(size0 + size1), float(size0 + size1 + size2) };
+	// If the buffer is full there is not much we can do here since it is being used live, so the surface just goes without lights.
+	int thisindex = mRing->Alloc(totalsize);
+	if (thisindex < 0) return -1;
 
-	if (thisindex + totalsize <= mBufferSize)
-	{
-		float *copyptr = mBufferPointer + thisindex*4;
+	float parmcnt[] = { 0, float(size0), float(size0 + size1), float(size0 + size1 + size2) };
+	float *copyptr = (float*)mRing->GetElement(thisindex);
 
-		memcpy(&copyptr[0], parmcnt, ELEMENT_SIZE);
-		memcpy(&copyptr[4], &data.arrays[0][0], size0 * ELEMENT_SIZE);
-		memcpy(&copyptr[4 + 4*size0], &data.arrays[1][0], size1 * ELEMENT_SIZE);
-		memcpy(&copyptr[4 + 4*(size0 + size1)], &data.arrays[2][0], size2 * ELEMENT_SIZE);
-		return thisindex;
-	}
-	else
-	{
-		return -1;	// Buffer is full. Since it is being used live at the point of the upload we cannot do much here but to abort.
-	}
+	memcpy(&copyptr[0], parmcnt, ELEMENT_SIZE);
+	memcpy(&copyptr[4], &data.arrays[0][0], size0 * ELEMENT_SIZE);
+	memcpy(&copyptr[4 + 4*size0], &data.arrays[1][0], size1 * ELEMENT_SIZE);
+	memcpy(&copyptr[4 + 4*(size0 + size1)], &data.arrays[2][0], size2 * ELEMENT_SIZE);
+	return thisindex;
 }
 
 int FLightBuffer::GetBinding(unsigned int index, size_t* pOffset, size_t* pSize)
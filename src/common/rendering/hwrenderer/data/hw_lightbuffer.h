@@ -4,27 +4,19 @@
 #include "tarray.h"
 #include "hw_dynlightdata.h"
 #include "hwrenderer/data/buffers.h"
-#include <atomic>
-#include <mutex>
+#include "hw_ringbuffer.h"
+#include <memory>
 
 class FRenderState;
 
 class FLightBuffer
 {
-	IDataBuffer *mBuffer;
-	IDataBuffer* mBufferPipeline[HW_MAX_PIPELINE_BUFFERS];
-	int mPipelineNbr;
-	int mPipelinePos = 0;
+	std::unique_ptr<HWFrameRingBuffer> mRing;
 
 	bool mBufferType;
-    std::atomic<unsigned int> mIndex;
 	unsigned int mBlockAlign;
 	unsigned int mBlockSize;
-	unsigned int mBufferSize;
-	unsigned int mByteSize;
-    unsigned int mMaxUploadSize;
-
-	void CheckSize();
+	unsigned int mMaxUploadSize;
 
 public:
 
@@ -32,16 +24,17 @@ public:
 	~FLightBuffer();
 	void Clear();
 	int UploadLights(FDynLightData &data);
-	void Map() { mBuffer->Map(); }
-	void Unmap() { mBuffer->Unmap(); }
+	void Map() { mRing->Map(); }
+	void Unmap() { mRing->Unmap(); }
 	unsigned int GetBlockSize() const { return mBlockSize; }
 	bool GetBufferType() const { return mBufferType; }
 	int GetBinding(unsigned int index, size_t* pOffset, size_t* pSize);
+	const HWFrameRingBuffer& GetRing() const { return *mRing; }
 
 	// OpenGL needs the buffer to mess around with the binding.
 	IDataBuffer* GetBuffer() const
 	{
-		return mBuffer;
+		return mRing->GetBuffer();
 	}
 
 };
@@ -204,6 +204,19 @@ struct StreamData
 	FVector4 padding1, padding2, padding3;
 };
 
+// One range of an indexed multi-draw
+struct FIndexedDrawRange
+{
+	int index;
+	int count;
+};
+
+enum
+{
+	// Matrices per instance in the bone buffer: model matrix, and normal matrix with the interpolation factor in its last element.
+	INSTANCE_DATA_SIZE = 2
+};
+
 class FRenderState
 {
 protected:
@@ -218,6 +231,7 @@ protected:
 
 	int mLightIndex;
 	int mBoneIndexBase;
+	int mInstanceIndexBase;
 	int mSpecialEffect;
 	int mTextureMode;
 	int mTextureClamp;
@@ -280,6 +294,7 @@ public:
 		mSpecialEffect = EFF_NONE;
 		mLightIndex = -1;
 		mBoneIndexBase = -1;
+		mInstanceIndexBase = -1;
 		mStreamData.uInterpolationFactor = 0;
 		mRenderStyle = DefaultRenderStyle();
 		mMaterial.Reset();
@@ -575,6 +590,11 @@ public:
 		mBoneIndexBase = index;
 	}
 
+	void SetInstanceIndexBase(int index)
+	{
+		mInstanceIndexBase = index;
+	}
+
 	void SetRenderStyle(FRenderStyle rs)
 	{
 		mRenderStyle = rs;
@@ -726,6 +746,40 @@ public:
 	virtual void Draw(int dt, int index, int count, bool apply = true) = 0;
 	virtual void DrawIndexed(int dt, int index, int count, bool apply = true) = 0;
 
+	// Draws several index ranges with the same state. Backends that can do so submit this as a single multi-draw.
+	virtual void DrawIndexedRanges(int dt, const FIndexedDrawRange *ranges, int count, bool apply = true)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			DrawIndexed(dt, ranges[i].index, ranges[i].count, apply && i == 0);
+		}
+	}
+
+	// Draws the same geometry once for each instance in the bone buffer, starting at the instance index base.
+	// This requires shaders that read the instance data. The fallback issues one draw per instance and moves the base itself.
+	virtual bool SupportsInstancing() const { return false; }
+	virtual void DrawInstanced(int dt, int index, int count, int instances, bool apply = true)
+	{
+		int base = mInstanceIndexBase;
+		for (int i = 0; i < instances; i++)
+		{
+			mInstanceIndexBase = base + i * INSTANCE_DATA_SIZE;
+			Draw(dt, index, count, true);
+		}
+		mInstanceIndexBase = base;
+	}
+
+	virtual void DrawIndexedInstanced(int dt, int index, int count, int instances, bool apply = true)
+	{
+		int base = mInstanceIndexBase;
+		for (int i = 0; i < instances; i++)
+		{
+			mInstanceIndexBase = base + i * INSTANCE_DATA_SIZE;
+			DrawIndexed(dt, index, count, true);
+		}
+		mInstanceIndexBase = base;
+	}
+
 	// Immediate render state change commands. These only change infrequently and should not clutter the render state.
 	virtual bool SetDepthClamp(bool on) = 0;					// Deactivated only by skyboxes.
 	virtual void SetDepthMask(bool on) = 0;						// Used by decals and indirectly by portal setup.
@@ -0,0 +1,134 @@
+// 
+//---------------------------------------------------------------------------
+//
+// Copyright(C) 2014-2016 Christoph Oelckers
+// All rights reserved.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//--------------------------------------------------------------------------
+//
+/*
+** hw_ringbuffer.cpp
+** Shared per-frame storage for lights, bones and viewpoints
+**
+**/
+
+#include "hw_ringbuffer.h"
+#include "hw_lightbuffer.h"
+#include "hw_bonebuffer.h"
+#include "hw_viewpointbuffer.h"
+#include "shaderuniforms.h"
+#include "stats.h"
+
+HWFrameRingBuffer::HWFrameRingBuffer(int bindingpoint, bool ssbo, bool growable, unsigned int elementsize, unsigned int capacity, int pipelineNbr) :
+	mPipelineNbr(pipelineNbr), mElementSize(elementsize), mCapacity(capacity)
+{
+	for (int n = 0; n < mPipelineNbr; n++)
+	{
+		mBufferPipeline[n] = screen->CreateDataBuffer(bindingpoint, ssbo, growable);
+		mBufferPipeline[n]->SetData((size_t)mCapacity * mElementSize, nullptr, BufferUsageType::Persistent);
+	}
+	mBuffer = mBufferPipeline[0];
+	mIndex = 0;
+	mFailed = 0;
+}
+
+HWFrameRingBuffer::~HWFrameRingBuffer()
+{
+	for (int n = 0; n < mPipelineNbr; n++)
+	{
+		delete mBufferPipeline[n];
+	}
+}
+
+//==========================================================================
+//
+// Starts a new frame. Only moves on to the next buffer if the current
+// one actually got used, because this may be called several times
+// before anything gets rendered. Returns true if it moved.
+//
+//==========================================================================
+
+bool HWFrameRingBuffer::NextFrame()
+{
+	unsigned int used = mIndex;
+	if (used == 0) return false;
+
+	mLastFrameUsed = min(used, mCapacity);
+	mPeakUsed = max(mPeakUsed, mLastFrameUsed);
+	mLastFrameFailed = mFailed;
+
+	mIndex = 0;
+	mFailed = 0;
+
+	mPipelinePos++;
+	mPipelinePos %= mPipelineNbr;
+	mBuffer = mBufferPipeline[mPipelinePos];
+	mGeneration++;
+	return true;
+}
+
+//==========================================================================
+//
+// Reserves 'count' elements for this frame and returns the index of the
+// first one, or -1 if the frame's space is exhausted.
+// Safe to call from multiple threads.
+//
+//==========================================================================
+
+int HWFrameRingBuffer::Alloc(unsigned int count)
+{
+	unsigned int index = mIndex.fetch_add(count);
+	if (index + count <= mCapacity)
+	{
+		return index;
+	}
+	mFailed++;
+	return -1;
+}
+
+//==========================================================================
+//
+// Doubles the capacity. This has to wait for the GPU so it is only
+// meant as a last resort for data that cannot just be dropped.
+//
+//==========================================================================
+
+void HWFrameRingBuffer::Grow()
+{
+	mIndex = min((unsigned int)mIndex, mCapacity);
+	mCapacity *= 2;
+	for (int n = 0; n < mPipelineNbr; n++)
+	{
+		mBufferPipeline[n]->Resize((size_t)mCapacity * mElementSize);
+	}
+	mGrowCount++;
+}
+
+FString HWFrameRingBuffer::GetStats(const char* name) const
+{
+	FString out;
+	out.Format("%s: %u/%u used, peak %u, dropped %u, grown %u\n", name, mLastFrameUsed, mCapacity, mPeakUsed, mLastFrameFailed, mGrowCount);
+	return out;
+}
+
+ADD_STAT(shaderdata)
+{
+	FString out;
+	if (screen->mLights) out += screen->mLights->GetRing().GetStats("Lights");
+	if (screen->mBones) out += screen->mBones->GetRing().GetStats("Bones");
+	if (screen->mViewpoints) out += screen->mViewpoints->GetRing().GetStats("Viewpoints");
+	return out;
+}
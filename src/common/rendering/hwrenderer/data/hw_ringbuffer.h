@@ -0,0 +1,54 @@
+#pragma once
+
+#include "hwrenderer/data/buffers.h"
+#include "zstring.h"
+#include <atomic>
+
+//==========================================================================
+//
+// Persistently mapped ring of per-frame shader data.
+// Space is handed out lock-free and the storage is never reallocated
+// behind the owner's back. Each frame moves on to the next pipeline
+// buffer so the GPU can still read the previous one.
+//
+//==========================================================================
+
+class HWFrameRingBuffer
+{
+	IDataBuffer* mBufferPipeline[HW_MAX_PIPELINE_BUFFERS];
+	IDataBuffer* mBuffer;
+	int mPipelineNbr;
+	int mPipelinePos = 0;
+	unsigned int mGeneration = 0;
+
+	std::atomic<unsigned int> mIndex;
+	unsigned int mElementSize;
+	unsigned int mCapacity;
+
+	// usage statistics
+	unsigned int mLastFrameUsed = 0;
+	unsigned int mPeakUsed = 0;
+	std::atomic<unsigned int> mFailed;
+	unsigned int mLastFrameFailed = 0;
+	unsigned int mGrowCount = 0;
+
+public:
+	HWFrameRingBuffer(int bindingpoint, bool ssbo, bool growable, unsigned int elementsize, unsigned int capacity, int pipelineNbr);
+	~HWFrameRingBuffer();
+
+	bool NextFrame();
+	int Alloc(unsigned int count);
+	void Grow();
+
+	void* GetElement(unsigned int index) const { return (uint8_t*)mBuffer->Memory() + (size_t)index * mElementSize; }
+	IDataBuffer* GetBuffer() const { return mBuffer; }
+	unsigned int GetCapacity() const { return mCapacity; }
+	unsigned int GetUsed() const { unsigned int used = mIndex; return used < mCapacity ? used : mCapacity; }
+	// Changes whenever previously handed out indices become invalid.
+	unsigned int GetGeneration() const { return mGeneration; }
+
+	void Map() { mBuffer->Map(); }
+	void Unmap() { mBuffer->Unmap(); }
+
+	FString GetStats(const char* name) const;
+};
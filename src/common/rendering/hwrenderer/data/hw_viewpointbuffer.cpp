@@ -33,40 +33,30 @@
 
 static const int INITIAL_BUFFER_SIZE = 100;	// 100 viewpoints per frame should nearly always be enough
 
-HWViewpointBuffer::HWViewpointBuffer(int pipelineNbr):
-	mPipelineNbr(pipelineNbr)
+HWViewpointBuffer::HWViewpointBuffer(int pipelineNbr)
 {
-	mBufferSize = INITIAL_BUFFER_SIZE;
 	mBlockAlign = ((sizeof(HWViewpointUniforms) / screen->uniformblockalignment) + 1) * screen->uniformblockalignment;
-	mByteSize = mBufferSize * mBlockAlign;
-
-	for (int n = 0; n < mPipelineNbr; n++)
-	{
-		mBufferPipeline[n] = screen->CreateDataBuffer(VIEWPOINT_BINDINGPOINT, false, true);
-		mBufferPipeline[n]->SetData(mByteSize, nullptr, BufferUsageType::Persistent);
-	}
-
-	Clear();
+	mRing.reset(new HWFrameRingBuffer(VIEWPOINT_BINDINGPOINT, false, true, mBlockAlign, INITIAL_BUFFER_SIZE, pipelineNbr));
 	mLastMappedIndex = UINT_MAX;
 }
 
 HWViewpointBuffer::~HWViewpointBuffer()
 {
-	delete mBuffer;
 }
 
-
-void HWViewpointBuffer::CheckSize()
+unsigned int HWViewpointBuffer::Upload(const HWViewpointUniforms *vp)
 {
-	if (mUploadIndex >= mBufferSize)
+	int index = mRing->Alloc(1);
+	if (index < 0)
 	{
-		mBufferSize *= 2;
-		mByteSize *= 2;
-		for (int n = 0; n < mPipelineNbr; n++)
-		{
-			mBufferPipeline[n]->Resize(mByteSize);
-		}
+		// Unlike lights a viewpoint cannot be dropped, so this is the one case where the storage has to grow.
+		mRing->Grow();
+		index = mRing->Alloc(1);
 	}
+	mRing->Map();
+	memcpy(mRing->GetElement(index), vp, sizeof(*vp));
+	mRing->Unmap();
+	return index;
 }
 
 int HWViewpointBuffer::Bind(FRenderState &di, unsigned int index)
@@ -74,7 +64,7 @@ int HWViewpointBuffer::Bind(FRenderState &di, unsigned int index)
 	if (index != mLastMappedIndex)
 	{
 		mLastMappedIndex = index;
-		mBuffer->BindRange(&di, index * mBlockAlign, mBlockAlign);
+		mRing->GetBuffer()->BindRange(&di, index * mBlockAlign, mBlockAlign);
 		di.EnableClipDistance(0, mClipPlaneInfo[index]);
 	}
 	return index;
@@ -96,42 +86,26 @@ void HWViewpointBuffer::Set2D(FRenderState &di, int width, int height, int pll)
 	matrices.mProjectionMatrix.ortho(0, (float)width, (float)height, 0, -1.0f, 1.0f);
 	matrices.CalcDependencies();
 
-	CheckSize();
-	mBuffer->Map();
-	memcpy(((char*)mBuffer->Memory()) + mUploadIndex * mBlockAlign, &matrices, sizeof(matrices));
-	mBuffer->Unmap();
-
+	unsigned int index = Upload(&matrices);
 	mClipPlaneInfo.Push(0);
 
-	Bind(di, mUploadIndex++);
+	Bind(di, index);
 }
 
 int HWViewpointBuffer::SetViewpoint(FRenderState &di, HWViewpointUniforms *vp)
 {
-	CheckSize();
-	mBuffer->Map();
-	memcpy(((char*)mBuffer->Memory()) + mUploadIndex * mBlockAlign, vp, sizeof(*vp));
-	mBuffer->Unmap();
-
+	unsigned int index = Upload(vp);
 	mClipPlaneInfo.Push(vp->mClipHeightDirection != 0.f || vp->mClipLine.X > -10000000.0f);
-	return Bind(di, mUploadIndex++);
+	return Bind(di, index);
 }
 
 void HWViewpointBuffer::Clear()
 {
-	bool needNewPipeline = mUploadIndex > 0; // Clear might be called multiple times before any actual rendering
-
-	mUploadIndex = 0;
-	mClipPlaneInfo.Clear();
-
-	if (needNewPipeline)
+	// Clear might be called multiple times before any actual rendering
+	if (mRing->NextFrame())
 	{
 		mLastMappedIndex = UINT_MAX;
-
-		mPipelinePos++;
-		mPipelinePos %= mPipelineNbr;
 	}
-
-	mBuffer = mBufferPipeline[mPipelinePos];
+	mClipPlaneInfo.Clear();
 }
 
@@ -1,27 +1,23 @@
 #pragma once
 #include "tarray.h"
 #include "hwrenderer/data/buffers.h"
+#include "hw_ringbuffer.h"
+#include <memory>
 
 struct HWViewpointUniforms;
 class FRenderState;
 
 class HWViewpointBuffer
 {
-	IDataBuffer *mBuffer;
-	IDataBuffer* mBufferPipeline[HW_MAX_PIPELINE_BUFFERS];
-	int mPipelineNbr;
-	int mPipelinePos = 0;
+	std::unique_ptr<HWFrameRingBuffer> mRing;
 
-	unsigned int mBufferSize;
 	unsigned int mBlockAlign;
-	unsigned int mUploadIndex;
 	unsigned int mLastMappedIndex;
-	unsigned int mByteSize;
 	TArray<bool> mClipPlaneInfo;
 
 	unsigned int mBlockSize;
 
-	void CheckSize();
+	unsigned int Upload(const HWViewpointUniforms *vp);
 
 public:
 
@@ -32,5 +28,6 @@ public:
 	void Set2D(FRenderState &di, int width, int height, int pll = 0);
 	int SetViewpoint(FRenderState &di, HWViewpointUniforms *vp);
 	unsigned int GetBlockSize() const { return mBlockSize; }
+	const HWFrameRingBuffer& GetRing() const { return *mRing; }
 };
 
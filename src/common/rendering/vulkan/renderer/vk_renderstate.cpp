@@ -71,6 +71,41 @@ void VkRenderState::DrawIndexed(int dt, int index, int count, bool apply)
 	mCommandBuffer->drawIndexed(count, 1, index, 0, 0);
 }
 
+void VkRenderState::DrawInstanced(int dt, int index, int count, int instances, bool apply)
+{
+	if (apply || mNeedApply)
+		Apply(dt);
+
+	mCommandBuffer->draw(count, instances, index, 0);
+}
+
+void VkRenderState::DrawIndexedInstanced(int dt, int index, int count, int instances, bool apply)
+{
+	if (apply || mNeedApply)
+		Apply(dt);
+
+	mCommandBuffer->drawIndexed(count, instances, index, 0, 0);
+}
+
+void VkRenderState::DrawIndexedRanges(int dt, const FIndexedDrawRange *ranges, int count, bool apply)
+{
+	if (apply || mNeedApply)
+		Apply(dt);
+
+	auto indirect = fb->GetBufferManager()->IndirectBuffer.get();
+	uint32_t offset = indirect->Write(ranges, count);
+	if (offset != 0xffffffff)
+	{
+		mCommandBuffer->drawIndexedIndirect(indirect->Buffer->mBuffer->buffer, offset, count, sizeof(VkDrawIndexedIndirectCommand));
+	}
+	else
+	{
+		// Out of indirect buffer space for this frame. The state is already applied, so just draw the ranges individually.
+		for (int i = 0; i < count; i++)
+			mCommandBuffer->drawIndexed(ranges[i].count, 1, ranges[i].index, 0, 0);
+	}
+}
+
 bool VkRenderState::SetDepthClamp(bool on)
 {
 	bool lastValue = mDepthClamp;
@@ -392,6 +427,7 @@ void VkRenderState::ApplyPushConstants()
 
 	mPushConstants.uLightIndex = mLightIndex;
 	mPushConstants.uBoneIndexBase = mBoneIndexBase;
+	mPushConstants.uInstanceIndexBase = mInstanceIndexBase;
 	mPushConstants.uDataIndex = mStreamBufferWriter.DataIndex();
 
 	auto passManager = fb->GetRenderPassManager();
@@ -470,6 +506,7 @@ void VkRenderState::WaitForStreamBuffers()
 	mApplyCount = 0;
 	mStreamBufferWriter.Reset();
 	mMatrixBufferWriter.Reset();
+	fb->GetBufferManager()->IndirectBuffer->Reset();
 }
 
 void VkRenderState::Bind(int bindingpoint, uint32_t offset)
@@ -507,6 +544,7 @@ void VkRenderState::EndFrame()
 {
 	mMatrixBufferWriter.Reset();
 	mStreamBufferWriter.Reset();
+	fb->GetBufferManager()->IndirectBuffer->Reset();
 }
 
 void VkRenderState::EnableDrawBuffers(int count, bool apply)
@@ -25,6 +25,10 @@ public:
 	void ClearScreen() override;
 	void Draw(int dt, int index, int count, bool apply = true) override;
 	void DrawIndexed(int dt, int index, int count, bool apply = true) override;
+	void DrawIndexedRanges(int dt, const FIndexedDrawRange *ranges, int count, bool apply = true) override;
+	bool SupportsInstancing() const override { return true; }
+	void DrawInstanced(int dt, int index, int count, int instances, bool apply = true) override;
+	void DrawIndexedInstanced(int dt, int index, int count, int instances, bool apply = true) override;
 
 	// Immediate render state change commands. These only change infrequently and should not clutter the render state.
 	bool SetDepthClamp(bool on) override;
@@ -273,6 +273,9 @@ static const char *shaderBindings = R"(
 		int uBoneIndexBase;
 
 		int uDataIndex;
+
+		// model instancing
+		int uInstanceIndexBase;
 		int padding2, padding3;
 	};
 
@@ -54,7 +54,10 @@ struct PushConstants
 	int uBoneIndexBase;
 
 	int uDataIndex;
-	int padding1, padding2, padding3;
+
+	// model instancing
+	int uInstanceIndexBase;
+	int padding2, padding3;
 };
 
 class VkShaderProgram
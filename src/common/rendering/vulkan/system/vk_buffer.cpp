@@ -24,6 +24,7 @@
 #include "vk_hwbuffer.h"
 #include "vulkan/renderer/vk_streambuffer.h"
 #include "hwrenderer/data/shaderuniforms.h"
+#include "hw_renderstate.h"
 
 VkBufferManager::VkBufferManager(VulkanRenderDevice* fb) : fb(fb)
 {
@@ -37,6 +38,7 @@ void VkBufferManager::Init()
 {
 	MatrixBuffer.reset(new VkStreamBuffer(this, sizeof(MatricesUBO), 50000));
 	StreamBuffer.reset(new VkStreamBuffer(this, sizeof(StreamUBO), 300));
+	IndirectBuffer.reset(new VkIndirectBuffer(this, 65536));
 
 	CreateFanToTrisIndexBuffer();
 }
@@ -93,6 +95,11 @@ IDataBuffer* VkBufferManager::CreateDataBuffer(int bindingpoint, bool ssbo, bool
 	return buffer;
 }
 
+VkHardwareIndirectBuffer* VkBufferManager::CreateIndirectBuffer()
+{
+	return new VkHardwareIndirectBuffer(fb);
+}
+
 void VkBufferManager::CreateFanToTrisIndexBuffer()
 {
 	TArray<uint32_t> data;
@@ -132,3 +139,37 @@ uint32_t VkStreamBuffer::NextStreamDataBlock()
 	}
 	return mStreamDataOffset;
 }
+
+/////////////////////////////////////////////////////////////////////////////
+
+VkIndirectBuffer::VkIndirectBuffer(VkBufferManager* buffers, size_t count)
+{
+	Buffer = buffers->CreateIndirectBuffer();
+	Buffer->SetData(sizeof(VkDrawIndexedIndirectCommand) * count, nullptr, BufferUsageType::Persistent);
+}
+
+VkIndirectBuffer::~VkIndirectBuffer()
+{
+	delete Buffer;
+}
+
+uint32_t VkIndirectBuffer::Write(const FIndexedDrawRange* ranges, int count)
+{
+	size_t size = sizeof(VkDrawIndexedIndirectCommand) * count;
+	if (mOffset + size > Buffer->Size())
+		return 0xffffffff;
+
+	auto commands = (VkDrawIndexedIndirectCommand*)((uint8_t*)Buffer->Memory() + mOffset);
+	for (int i = 0; i < count; i++)
+	{
+		commands[i].indexCount = ranges[i].count;
+		commands[i].instanceCount = 1;
+		commands[i].firstIndex = ranges[i].index;
+		commands[i].vertexOffset = 0;
+		commands[i].firstInstance = 0;
+	}
+
+	uint32_t offset = mOffset;
+	mOffset += (uint32_t)size;
+	return offset;
+}
@@ -8,6 +8,9 @@ class VulkanRenderDevice;
 class VkHardwareBuffer;
 class VkHardwareDataBuffer;
 class VkStreamBuffer;
+class VkIndirectBuffer;
+class VkHardwareIndirectBuffer;
+struct FIndexedDrawRange;
 class IIndexBuffer;
 class IVertexBuffer;
 class IDataBuffer;
@@ -24,6 +27,7 @@ public:
 	IVertexBuffer* CreateVertexBuffer();
 	IIndexBuffer* CreateIndexBuffer();
 	IDataBuffer* CreateDataBuffer(int bindingpoint, bool ssbo, bool needsresize);
+	VkHardwareIndirectBuffer* CreateIndirectBuffer();
 
 	void AddBuffer(VkHardwareBuffer* buffer);
 	void RemoveBuffer(VkHardwareBuffer* buffer);
@@ -37,6 +41,7 @@ public:
 
 	std::unique_ptr<VkStreamBuffer> MatrixBuffer;
 	std::unique_ptr<VkStreamBuffer> StreamBuffer;
+	std::unique_ptr<VkIndirectBuffer> IndirectBuffer;
 
 	std::unique_ptr<IIndexBuffer> FanToTrisIndexBuffer;
 
@@ -63,3 +68,18 @@ private:
 	uint32_t mBlockSize = 0;
 	uint32_t mStreamDataOffset = 0;
 };
+
+class VkIndirectBuffer
+{
+public:
+	VkIndirectBuffer(VkBufferManager* buffers, size_t count);
+	~VkIndirectBuffer();
+
+	uint32_t Write(const FIndexedDrawRange* ranges, int count);
+	void Reset() { mOffset = 0; }
+
+	VkHardwareIndirectBuffer* Buffer = nullptr;
+
+private:
+	uint32_t mOffset = 0;
+};
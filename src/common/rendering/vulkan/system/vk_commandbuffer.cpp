@@ -37,6 +37,9 @@ extern bool gpuStatActive;
 extern bool keepGpuStatActive;
 extern FString gpuStatOutput;
 
+// Lets the GPU finish a frame while the game thread runs the next tic, instead of waiting for it at the end of the frame
+CVAR(Bool, vk_framepipelining, false, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
+
 VkCommandBufferManager::VkCommandBufferManager(VulkanRenderDevice* fb) : fb(fb)
 {
 	mCommandPool = CommandPoolBuilder()
@@ -131,6 +134,9 @@ void VkCommandBufferManager::FlushCommands(VulkanCommandBuffer** commands, size_
 
 void VkCommandBufferManager::FlushCommands(bool finish, bool lastsubmit, bool uploadOnly)
 {
+	// The last submit of a pipelined frame signalled no semaphore for the next one to wait on, so that frame has to complete first.
+	WaitForFrameInFlight();
+
 	if (!uploadOnly)
 		fb->GetRenderState()->EndRenderPass();
 
@@ -161,6 +167,8 @@ void VkCommandBufferManager::FlushCommands(bool finish, bool lastsubmit, bool up
 
 void VkCommandBufferManager::WaitForCommands(bool finish, bool uploadOnly)
 {
+	WaitForFrameInFlight();
+
 	if (finish)
 	{
 		Finish.Reset();
@@ -177,16 +185,20 @@ void VkCommandBufferManager::WaitForCommands(bool finish, bool uploadOnly)
 		fb->GetFramebufferManager()->QueuePresent();
 	}
 
-	int numWaitFences = min(mNextSubmit, (int)maxConcurrentSubmitCount);
-
-	if (numWaitFences > 0)
+	if (finish && vk_framepipelining)
 	{
-		vkWaitForFences(fb->device->device, numWaitFences, mSubmitWaitFences, VK_TRUE, std::numeric_limits<uint64_t>::max());
-		vkResetFences(fb->device->device, numWaitFences, mSubmitWaitFences);
+		// Nothing is written into the frame's buffers again until the next BeginFrame or submit, which waits for it.
+		// Anything released from here on may be used by commands that have not been submitted yet, so it goes into fresh lists.
+		mInFlightTransferDeleteList = std::move(TransferDeleteList);
+		mInFlightDrawDeleteList = std::move(DrawDeleteList);
+		TransferDeleteList = std::make_unique<DeleteList>();
+		DrawDeleteList = std::make_unique<DeleteList>();
+		mFrameInFlight = true;
+	}
+	else
+	{
+		WaitForSubmits(uploadOnly);
 	}
-
-	DeleteFrameObjects(uploadOnly);
-	mNextSubmit = 0;
 
 	if (finish)
 	{
@@ -196,11 +208,47 @@ void VkCommandBufferManager::WaitForCommands(bool finish, bool uploadOnly)
 	}
 }
 
+void VkCommandBufferManager::WaitForFrameInFlight()
+{
+	if (!mFrameInFlight)
+		return;
+
+	WaitForSubmitFences();
+	mInFlightTransferDeleteList.reset();
+	mInFlightDrawDeleteList.reset();
+	mFrameInFlight = false;
+
+	// The timestamp queries of a pipelined frame are only complete now
+	UpdateGpuStats();
+}
+
+void VkCommandBufferManager::WaitForSubmits(bool uploadOnly)
+{
+	WaitForSubmitFences();
+	DeleteFrameObjects(uploadOnly);
+}
+
+void VkCommandBufferManager::WaitForSubmitFences()
+{
+	int numWaitFences = min(mNextSubmit, (int)maxConcurrentSubmitCount);
+
+	if (numWaitFences > 0)
+	{
+		vkWaitForFences(fb->device->device, numWaitFences, mSubmitWaitFences, VK_TRUE, std::numeric_limits<uint64_t>::max());
+		vkResetFences(fb->device->device, numWaitFences, mSubmitWaitFences);
+	}
+	mNextSubmit = 0;
+}
+
 void VkCommandBufferManager::DeleteFrameObjects(bool uploadOnly)
 {
 	TransferDeleteList = std::make_unique<DeleteList>();
 	if (!uploadOnly)
+	{
 		DrawDeleteList = std::make_unique<DeleteList>();
+		mInFlightTransferDeleteList.reset();
+		mInFlightDrawDeleteList.reset();
+	}
 }
 
 void VkCommandBufferManager::PushGroup(const FString& name)
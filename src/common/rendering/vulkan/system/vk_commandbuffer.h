@@ -22,6 +22,10 @@ public:
 	void WaitForCommands(bool finish) { WaitForCommands(finish, false); }
 	void WaitForCommands(bool finish, bool uploadOnly);
 
+	// Waits for a frame that WaitForCommands left running on the GPU
+	void WaitForFrameInFlight();
+	bool IsFrameInFlight() const { return mFrameInFlight; }
+
 	void PushGroup(const FString& name);
 	void PopGroup();
 	void UpdateGpuStats();
@@ -60,6 +64,8 @@ public:
 
 private:
 	void FlushCommands(VulkanCommandBuffer** commands, size_t count, bool finish, bool lastsubmit);
+	void WaitForSubmits(bool uploadOnly);
+	void WaitForSubmitFences();
 
 	VulkanRenderDevice* fb = nullptr;
 
@@ -73,6 +79,11 @@ private:
 	std::unique_ptr<VulkanFence> mSubmitFence[maxConcurrentSubmitCount];
 	VkFence mSubmitWaitFences[maxConcurrentSubmitCount];
 	int mNextSubmit = 0;
+	bool mFrameInFlight = false;
+
+	// Objects released while recording a pipelined frame. They are only deleted once that frame has completed.
+	std::unique_ptr<DeleteList> mInFlightTransferDeleteList;
+	std::unique_ptr<DeleteList> mInFlightDrawDeleteList;
 
 	struct TimestampQuery
 	{
@@ -56,6 +56,12 @@ public:
 	VkHardwareIndexBuffer(VulkanRenderDevice* fb) : VkHardwareBuffer(fb) { mBufferType = VK_BUFFER_USAGE_INDEX_BUFFER_BIT; }
 };
 
+class VkHardwareIndirectBuffer : public VkHardwareBuffer
+{
+public:
+	VkHardwareIndirectBuffer(VulkanRenderDevice* fb) : VkHardwareBuffer(fb) { mBufferType = VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT; }
+};
+
 class VkHardwareDataBuffer : public IDataBuffer, public VkHardwareBuffer
 {
 public:
@@ -228,7 +228,8 @@ void VulkanRenderDevice::Update()
 	Flush3D.Unclock();
 
 	mCommands->WaitForCommands(true);
-	mCommands->UpdateGpuStats();
+	if (!mCommands->IsFrameInFlight())
+		mCommands->UpdateGpuStats();
 
 	Super::Update();
 }
@@ -462,6 +463,7 @@ TArray<uint8_t> VulkanRenderDevice::GetScreenshotBuffer(int &pitch, ESSType &col
 
 void VulkanRenderDevice::BeginFrame()
 {
+	mCommands->WaitForFrameInFlight();
 	SetViewportRects(nullptr);
 	mViewpoints->Clear();
 	mCommands->BeginFrame();
@@ -100,6 +100,7 @@
 #include "r_data/r_vanillatrans.h"
 #include "s_music.h"
 #include "swrenderer/r_swcolormaps.h"
+#include "swrenderer/drawers/r_draw_bench.h"
 #include "findfile.h"
 #include "md5.h"
 #include "c_buttons.h"
@@ -3832,6 +3833,15 @@ int GameMain()
 	C_InstallHandlers(&cb);
 	SetConsoleNotifyBuffer();
 
+	// -benchdrawers runs the software renderer drawer benchmark without loading any game data
+	if (Args->CheckParm("-benchdrawers"))
+	{
+		const char *iterations = Args->CheckValue("-benchdrawers");
+		CheckCPUID(&CPU);
+		swrenderer::SetupDrawerBenchmarkPalette();
+		return swrenderer::RunDrawerBenchmark(1920, 1080, iterations ? max(atoi(iterations), 1) : 20);
+	}
+
 	try
 	{
 		ret = D_DoomMain_Internal();
@@ -337,6 +337,7 @@ bool EventManager::RegisterHandler(DStaticEventHandler* handler)
 		handler->ObjectFlags |= OF_Transient;
 	}
 
+	UpdateSubscriptions();
 	return true;
 }
 
@@ -370,6 +371,7 @@ bool EventManager::UnregisterHandler(DStaticEventHandler* handler)
 		LastEventHandler = handler->prev;
 		GC::WriteBarrier(handler->prev);
 	}
+	UpdateSubscriptions();
 	if (handler->IsStatic())
 	{
 		handler->ObjectFlags &= ~OF_Transient;
@@ -378,6 +380,24 @@ bool EventManager::UnregisterHandler(DStaticEventHandler* handler)
 	return true;
 }
 
+//==========================================================================
+//
+// Collects the often sent events that the registered handlers override,
+// so that the dispatchers don't need to look at handlers that leave them
+// empty.
+//
+//==========================================================================
+
+void EventManager::UpdateSubscriptions()
+{
+	Subscribed = 0;
+	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+	{
+		handler->UpdateSubscriptions();
+		Subscribed |= handler->Subscriptions;
+	}
+}
+
 bool EventManager::SendNetworkEvent(FString name, int arg1, int arg2, int arg3, bool manual)
 {
 	if (gamestate != GS_LEVEL && gamestate != GS_TITLELEVEL)
@@ -633,13 +653,15 @@ void EventManager::Shutdown()
 		handler->Destroy();
 	}
 	FirstEventHandler = LastEventHandler = nullptr;
+	Subscribed = 0;
 }
 
-#define DEFINE_EVENT_LOOPER(name, play) void EventManager::name() \
+#define DEFINE_EVENT_LOOPER(name, play, mask) void EventManager::name() \
 { \
 	if (ShouldCallStatic(play)) staticEventManager.name(); \
+	if (!(Subscribed & mask)) return; \
 	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next) \
-		handler->name(); \
+		if (handler->Subscriptions & mask) handler->name(); \
 }
 
 void EventManager::OnEngineInitialize()
@@ -685,8 +707,12 @@ void EventManager::WorldThingSpawned(AActor* actor)
 
 	if (ShouldCallStatic(true)) staticEventManager.WorldThingSpawned(actor);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldThingSpawned(actor);
+	if (Subscribed & EVS_WorldThingSpawned)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldThingSpawned)
+				handler->WorldThingSpawned(actor);
+	}
 }
 
 void EventManager::WorldThingDied(AActor* actor, AActor* inflictor)
@@ -697,8 +723,12 @@ void EventManager::WorldThingDied(AActor* actor, AActor* inflictor)
 
 	if (ShouldCallStatic(true)) staticEventManager.WorldThingDied(actor, inflictor);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldThingDied(actor, inflictor);
+	if (Subscribed & EVS_WorldThingDied)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldThingDied)
+				handler->WorldThingDied(actor, inflictor);
+	}
 }
 
 void EventManager::WorldThingGround(AActor* actor, FState* st)
@@ -709,8 +739,12 @@ void EventManager::WorldThingGround(AActor* actor, FState* st)
 
 	if (ShouldCallStatic(true)) staticEventManager.WorldThingGround(actor, st);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldThingGround(actor, st);
+	if (Subscribed & EVS_WorldThingGround)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldThingGround)
+				handler->WorldThingGround(actor, st);
+	}
 }
 
 void EventManager::WorldThingRevived(AActor* actor)
@@ -721,8 +755,12 @@ void EventManager::WorldThingRevived(AActor* actor)
 
 	if (ShouldCallStatic(true)) staticEventManager.WorldThingRevived(actor);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldThingRevived(actor);
+	if (Subscribed & EVS_WorldThingRevived)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldThingRevived)
+				handler->WorldThingRevived(actor);
+	}
 }
 
 void EventManager::WorldThingDamaged(AActor* actor, AActor* inflictor, AActor* source, int damage, FName mod, int flags, DAngle angle)
@@ -733,8 +771,12 @@ void EventManager::WorldThingDamaged(AActor* actor, AActor* inflictor, AActor* s
 
 	if (ShouldCallStatic(true)) staticEventManager.WorldThingDamaged(actor, inflictor, source, damage, mod, flags, angle);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldThingDamaged(actor, inflictor, source, damage, mod, flags, angle);
+	if (Subscribed & EVS_WorldThingDamaged)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldThingDamaged)
+				handler->WorldThingDamaged(actor, inflictor, source, damage, mod, flags, angle);
+	}
 }
 
 void EventManager::WorldThingDestroyed(AActor* actor)
@@ -747,8 +789,12 @@ void EventManager::WorldThingDestroyed(AActor* actor)
 	if (!(actor->ObjectFlags & OF_Spawned))
 		return;
 
-	for (DStaticEventHandler* handler = LastEventHandler; handler; handler = handler->prev)
-		handler->WorldThingDestroyed(actor);
+	if (Subscribed & EVS_WorldThingDestroyed)
+	{
+		for (DStaticEventHandler* handler = LastEventHandler; handler; handler = handler->prev)
+			if (handler->Subscriptions & EVS_WorldThingDestroyed)
+				handler->WorldThingDestroyed(actor);
+	}
 
 	if (ShouldCallStatic(true)) staticEventManager.WorldThingDestroyed(actor);
 }
@@ -757,24 +803,36 @@ void EventManager::WorldLinePreActivated(line_t* line, AActor* actor, int activa
 {
 	if (ShouldCallStatic(true)) staticEventManager.WorldLinePreActivated(line, actor, activationType, shouldactivate);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldLinePreActivated(line, actor, activationType, shouldactivate);
+	if (Subscribed & EVS_WorldLinePreActivated)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldLinePreActivated)
+				handler->WorldLinePreActivated(line, actor, activationType, shouldactivate);
+	}
 }
 
 void EventManager::WorldLineActivated(line_t* line, AActor* actor, int activationType)
 {
 	if (ShouldCallStatic(true)) staticEventManager.WorldLineActivated(line, actor, activationType);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->WorldLineActivated(line, actor, activationType);
+	if (Subscribed & EVS_WorldLineActivated)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldLineActivated)
+				handler->WorldLineActivated(line, actor, activationType);
+	}
 }
 
 int EventManager::WorldSectorDamaged(sector_t* sector, AActor* source, int damage, FName damagetype, int part, DVector3 position, bool isradius)
 {
 	if (ShouldCallStatic(true)) staticEventManager.WorldSectorDamaged(sector, source, damage, damagetype, part, position, isradius);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		damage = handler->WorldSectorDamaged(sector, source, damage, damagetype, part, position, isradius);
+	if (Subscribed & EVS_WorldSectorDamaged)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldSectorDamaged)
+				damage = handler->WorldSectorDamaged(sector, source, damage, damagetype, part, position, isradius);
+	}
 	return damage;
 }
 
@@ -782,8 +840,12 @@ int EventManager::WorldLineDamaged(line_t* line, AActor* source, int damage, FNa
 {
 	if (ShouldCallStatic(true)) staticEventManager.WorldLineDamaged(line, source, damage, damagetype, side, position, isradius);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		damage = handler->WorldLineDamaged(line, source, damage, damagetype, side, position, isradius);
+	if (Subscribed & EVS_WorldLineDamaged)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_WorldLineDamaged)
+				damage = handler->WorldLineDamaged(line, source, damage, damagetype, side, position, isradius);
+	}
 	return damage;
 }
 
@@ -906,16 +968,24 @@ void EventManager::RenderOverlay(EHudState state)
 {
 	if (ShouldCallStatic(false)) staticEventManager.RenderOverlay(state);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->RenderOverlay(state);
+	if (Subscribed & EVS_RenderOverlay)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_RenderOverlay)
+				handler->RenderOverlay(state);
+	}
 }
 
 void EventManager::RenderUnderlay(EHudState state)
 {
 	if (ShouldCallStatic(false)) staticEventManager.RenderUnderlay(state);
 
-	for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
-		handler->RenderUnderlay(state);
+	if (Subscribed & EVS_RenderUnderlay)
+	{
+		for (DStaticEventHandler* handler = FirstEventHandler; handler; handler = handler->next)
+			if (handler->Subscriptions & EVS_RenderUnderlay)
+				handler->RenderUnderlay(state);
+	}
 }
 
 bool EventManager::CheckUiProcessors()
@@ -978,11 +1048,11 @@ void EventManager::NewGame()
 }
 
 // normal event loopers (non-special, argument-less)
-DEFINE_EVENT_LOOPER(RenderFrame, false)
-DEFINE_EVENT_LOOPER(WorldLightning, true)
-DEFINE_EVENT_LOOPER(WorldTick, true)
-DEFINE_EVENT_LOOPER(UiTick, false)
-DEFINE_EVENT_LOOPER(PostUiTick, false)
+DEFINE_EVENT_LOOPER(RenderFrame, false, EVS_RenderFrame)
+DEFINE_EVENT_LOOPER(WorldLightning, true, EVS_All)
+DEFINE_EVENT_LOOPER(WorldTick, true, EVS_WorldTick)
+DEFINE_EVENT_LOOPER(UiTick, false, EVS_UiTick)
+DEFINE_EVENT_LOOPER(PostUiTick, false, EVS_PostUiTick)
 
 // declarations
 IMPLEMENT_CLASS(DStaticEventHandler, false, true);
@@ -1628,6 +1698,48 @@ static bool isEmptyInt(VMFunction *func)
 	return (code == nullptr || code->word == (0x00048000|OP_RET));
 }
 
+//==========================================================================
+//
+// Checks which of the often sent events this handler's class overrides.
+// The virtuals for these are skipped anyway if they are empty, so the
+// dispatchers can leave them out without calling them at all.
+//
+//==========================================================================
+
+void DStaticEventHandler::UpdateSubscriptions()
+{
+	static const char *const SubscriptionNames[] =
+	{
+		"WorldThingSpawned", "WorldThingDied", "WorldThingGround", "WorldThingRevived",
+		"WorldThingDamaged", "WorldThingDestroyed", "WorldLinePreActivated", "WorldLineActivated",
+		"WorldSectorDamaged", "WorldLineDamaged", "WorldTick", "RenderFrame",
+		"RenderOverlay", "RenderUnderlay", "UiTick", "PostUiTick",
+	};
+	static unsigned VIndices[countof(SubscriptionNames)];
+	static bool initialized = false;
+
+	if (!initialized)
+	{
+		for (unsigned i = 0; i < countof(SubscriptionNames); i++)
+		{
+			VIndices[i] = GetVirtualIndex(RUNTIME_CLASS(DStaticEventHandler), SubscriptionNames[i]);
+			assert(VIndices[i] != ~0u);
+		}
+		initialized = true;
+	}
+
+	auto clss = GetClass();
+	Subscriptions = 0;
+	for (unsigned i = 0; i < countof(SubscriptionNames); i++)
+	{
+		VMFunction *func = clss->Virtuals.Size() > VIndices[i] ? clss->Virtuals[VIndices[i]] : nullptr;
+		if (func != nullptr && !isEmpty(func))
+		{
+			Subscriptions |= 1u << i;
+		}
+	}
+}
+
 // ===========================================
 //
 //  Event handlers
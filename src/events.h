@@ -249,6 +249,31 @@ public:
 //
 // ==============================================
 
+// Events that can be sent very often (per actor, per tic or per frame).
+// For these, each handler records which of them its class actually overrides,
+// so that the dispatchers can skip handlers (or the whole list) that don't care.
+enum EEventSubscription : uint32_t
+{
+	EVS_WorldThingSpawned		= 1 << 0,
+	EVS_WorldThingDied			= 1 << 1,
+	EVS_WorldThingGround		= 1 << 2,
+	EVS_WorldThingRevived		= 1 << 3,
+	EVS_WorldThingDamaged		= 1 << 4,
+	EVS_WorldThingDestroyed		= 1 << 5,
+	EVS_WorldLinePreActivated	= 1 << 6,
+	EVS_WorldLineActivated		= 1 << 7,
+	EVS_WorldSectorDamaged		= 1 << 8,
+	EVS_WorldLineDamaged		= 1 << 9,
+	EVS_WorldTick				= 1 << 10,
+	EVS_RenderFrame				= 1 << 11,
+	EVS_RenderOverlay			= 1 << 12,
+	EVS_RenderUnderlay			= 1 << 13,
+	EVS_UiTick					= 1 << 14,
+	EVS_PostUiTick				= 1 << 15,
+
+	EVS_All						= ~0u
+};
+
 class DStaticEventHandler : public DObject // make it a part of normal GC process
 {
 	DECLARE_CLASS(DStaticEventHandler, DObject);
@@ -271,6 +296,9 @@ public:
 	int Order;
 	bool IsUiProcessor;
 	bool RequireMouse;
+	uint32_t Subscriptions = EVS_All;	// not serialized, recalculated on registration and after loading
+
+	void UpdateSubscriptions();
 
 	// serialization handler. let's keep it here so that I don't get lost in serialized/not serialized fields
 	void Serialize(FSerializer& arc) override
@@ -436,6 +464,7 @@ struct EventManager
 	FLevelLocals *Level = nullptr;
 	DStaticEventHandler* FirstEventHandler = nullptr;
 	DStaticEventHandler* LastEventHandler = nullptr;
+	uint32_t Subscribed = EVS_All;	// union of all handlers' subscriptions
 
 	EventManager() = default;
 	EventManager(FLevelLocals *l) { Level = l; }
@@ -544,8 +573,12 @@ struct EventManager
 		{
 			existinghandler->owner = this;
 		}
+		UpdateSubscriptions();
 	}
 
+	// recalculates the subscription masks after the handler list has changed.
+	void UpdateSubscriptions();
+
 };
 
  extern EventManager staticEventManager;
@@ -45,6 +45,7 @@
 #include "gstrings.h"
 #include "texturemanager.h"
 #include "d_main.h"
+#include "types.h"
 
 //==========================================================================
 //
@@ -421,3 +422,49 @@ CCMD(listsnapshots)
 		}
 	}
 }
+
+//==========================================================================
+//
+// Prints the memory layout of AActor's exported fields, so that changes
+// which push hot simulation state out of the first cache lines are easy
+// to spot. 'dumpactorlayout hot' restricts the output to the hot block.
+//
+//==========================================================================
+
+CCMD(dumpactorlayout)
+{
+	struct FieldInfo
+	{
+		FName Name;
+		size_t Offset;
+		unsigned Size;
+	};
+	enum { CacheLine = 64 };
+
+	const size_t hotstart = myoffsetof(AActor, snext);
+	const size_t hotend = myoffsetof(AActor, flags9) + sizeof(ActorFlags9);
+	const bool hotonly = argv.argc() > 1 && !stricmp(argv[1], "hot");
+
+	TArray<FieldInfo> fields;
+	auto it = RUNTIME_CLASS(AActor)->VMType->Symbols.GetIterator();
+	PSymbolTable::MapType::Pair *pair;
+	while (it.NextPair(pair))
+	{
+		auto field = dyn_cast<PField>(pair->Value);
+		// Skip flag aliases and meta data, which live elsewhere.
+		if (field == nullptr || field->BitValue != -1 || (field->Flags & VARF_Meta) || !(field->Flags & VARF_Native)) continue;
+		if (field->Offset >= sizeof(AActor)) continue;
+		if (hotonly && (field->Offset < hotstart || field->Offset >= hotend)) continue;
+		fields.Push({ pair->Key, field->Offset, field->Type->Size });
+	}
+	std::sort(fields.begin(), fields.end(), [](const FieldInfo &a, const FieldInfo &b) { return a.Offset < b.Offset; });
+
+	Printf("%-28s %6s %5s %5s\n", "Field", "Offset", "Size", "Line");
+	for (auto &f : fields)
+	{
+		bool hot = f.Offset >= hotstart && f.Offset < hotend;
+		Printf("%s%-28s %6zu %5u %5zu\n", hot ? TEXTCOLOR_GOLD : "", f.Name.GetChars(), f.Offset, f.Size, f.Offset / CacheLine);
+	}
+	Printf("AActor is %zu bytes (%zu cache lines); hot block is bytes %zu-%zu, lines %zu-%zu\n",
+		sizeof(AActor), (sizeof(AActor) + CacheLine - 1) / CacheLine, hotstart, hotend - 1, hotstart / CacheLine, (hotend - 1) / CacheLine);
+}
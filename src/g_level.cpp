@@ -2238,6 +2238,7 @@ void FLevelLocals::Tick ()
 	{
 		memset (&Scrolls[0], 0, sizeof(Scrolls[0])*Scrolls.Size());
 	}
+	flowFields.Tick();
 }
 
 //==========================================================================
@@ -2285,6 +2286,10 @@ void FLevelLocals::Mark()
 	{
 		GC::Mark(s.mSkybox);
 	}
+	for (auto &b : ParticleBatches)
+	{
+		GC::Mark(b.Handler);
+	}
 	// Mark dead bodies.
 	for (auto &p : bodyque)
 	{
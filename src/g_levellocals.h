@@ -41,6 +41,8 @@
 #include "r_sky.h"
 #include "portal.h"
 #include "p_blockmap.h"
+#include "p_linetree.h"
+#include "p_flowfield.h"
 #include "p_local.h"
 #include "po_man.h"
 #include "p_acs.h"
@@ -498,6 +500,8 @@ public:
 	TMap<int, FHealthGroup> healthGroups;
 
 	FBlockmap blockmap;
+	FLineTree lineTree;
+	FFlowFields flowFields;
 	TArray<polyblock_t *> PolyBlockMap;
 	FUDMFKeyMap UDMFKeys[4];
 
@@ -677,6 +681,8 @@ public:
 	uint32_t			ActiveParticles;
 	uint32_t			InactiveParticles;
 	TArray<particle_t>	Particles;
+	TArray<FParticleBatch>	ParticleBatches;
+	uint16_t			ParticleBatchGeneration;
 	TArray<uint16_t>	ParticlesInSubsec;
 	FThinkerCollection Thinkers;
 
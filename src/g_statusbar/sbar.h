@@ -437,6 +437,7 @@ public:
 	double CrosshairSize;
 	double Displacement;
 	bool ShowLog;
+	bool CacheDraw = false;	// Draw's output only depends on the game state, not on TicFrac or the real time.
 	int artiflashTick = 0;
 	double itemflashFade = 0.75;
 
@@ -451,6 +452,20 @@ private:
 	void DrawWaiting () const;
 
 	TObjPtr<DHUDMessageBase*> Messages[NUM_HUDMSGLAYERS];
+
+	// Everything Draw's output depends on, apart from the interpolation fraction.
+	struct DrawCacheKey
+	{
+		int RealTic, GameTic;
+		int State;
+		int Width, Height;
+		int ScreenBlocks;
+		bool ViewActive, AutomapActive;
+		player_t *Player;
+	};
+	DrawCacheKey LastDrawKey = {};
+	bool DrawCacheValid = false;
+	F2DDrawer::DrawListCache DrawCache;
 };
 
 extern DBaseStatusBar *StatusBar;
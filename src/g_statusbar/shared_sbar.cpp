@@ -58,6 +58,7 @@
 #include "sbarinfo.h"
 #include "gstrings.h"
 #include "events.h"
+#include "i_time.h"
 #include "g_game.h"
 #include "utf8.h"
 #include "texturemanager.h"
@@ -87,10 +88,12 @@ EXTERN_CVAR (Bool, am_showtime)
 EXTERN_CVAR (Bool, am_showtotaltime)
 EXTERN_CVAR(Bool, inter_subtitles)
 EXTERN_CVAR(Bool, ui_screenborder_classic_scaling)
+EXTERN_CVAR(Int, screenblocks)
 
 CVAR(Int, hud_scale, 0, CVAR_ARCHIVE);
 CVAR(Bool, log_vgafont, false, CVAR_ARCHIVE)
 CVAR(Bool, hud_oldscale, true, CVAR_ARCHIVE)
+CVARD(Bool, hud_cachedraw, false, CVAR_ARCHIVE, "reuse the status bar's drawing for all frames within the same tic")
 
 DBaseStatusBar *StatusBar;
 
@@ -1091,14 +1094,52 @@ void DBaseStatusBar::Draw (EHudState state, double ticFrac)
 	}
 }
 
+//---------------------------------------------------------------------------
+//
+// CallDraw
+//
+// Status bars that declare that they only change when the game ticks
+// (CacheDraw) can have the draw list from the first frame of a tic reused
+// instead of running the scripted Draw function again on every frame.
+// The real time tic counter is part of the key, so animations driven by
+// the menu or a paused game still get redrawn at the game's tic rate.
+//
+//---------------------------------------------------------------------------
+
 void DBaseStatusBar::CallDraw(EHudState state, double ticFrac)
 {
-	IFVIRTUAL(DBaseStatusBar, Draw)
+	DrawCacheKey key;
+	memset(&key, 0, sizeof(key));	// this gets compared as raw memory.
+	key.RealTic = I_GetTime();
+	key.GameTic = gametic;
+	key.State = state;
+	key.Width = twod->GetWidth();
+	key.Height = twod->GetHeight();
+	key.ScreenBlocks = screenblocks;
+	key.ViewActive = viewactive;
+	key.AutomapActive = automapactive;
+	key.Player = CPlayer;
+
+	bool cache = hud_cachedraw && CacheDraw;
+	if (cache && DrawCacheValid && !memcmp(&key, &LastDrawKey, sizeof(key)))
+	{
+		twod->ReplayDrawList(DrawCache);
+	}
+	else
 	{
-		VMValue params[] = { (DObject*)this, state, ticFrac };
-		VMCall(func, params, countof(params), nullptr, 0);
+		// Marking the list keeps the status bar's commands from merging with older ones, so it is only done when capturing.
+		F2DDrawer::DrawListMark mark = {};
+		if (cache) mark = twod->MarkDrawList();
+		IFVIRTUAL(DBaseStatusBar, Draw)
+		{
+			VMValue params[] = { (DObject*)this, state, ticFrac };
+			VMCall(func, params, countof(params), nullptr, 0);
+		}
+		else Draw(state, ticFrac);
+
+		DrawCacheValid = cache && twod->CaptureDrawList(mark, DrawCache);
+		LastDrawKey = key;
 	}
-	else Draw(state, ticFrac);
 	twod->ClearClipRect();	// make sure the scripts don't leave a valid clipping rect behind.
 	BeginStatusBar(BaseSBarHorizontalResolution, BaseSBarVerticalResolution, BaseRelTop, false);
 }
@@ -2,6 +2,7 @@
 #define __P_BLOCKMAP_H
 
 #include "doomtype.h"
+#include "tarray.h"
 
 class AActor;
 
@@ -11,6 +12,7 @@ struct FBlockNode
 	AActor *Me;						// actor this node references
 	int BlockIndex;					// index into blocklinks for the block this node is in
 	int Group;						// portal group this link belongs to (can be different than the actor's own group
+	int ThingIndex;					// position of this node's entry in its block's thing array
 	FBlockNode **PrevActor;			// previous actor in this block
 	FBlockNode *NextActor;			// next actor in this block
 	FBlockNode **PrevBlock;			// previous block this actor is in
@@ -22,6 +24,25 @@ struct FBlockNode
 	static FBlockNode *FreeBlocks;
 };
 
+// Contiguous copy of a block's thing chain. Entries are stored in link order
+// (newest last), so walking an array backwards visits the actors in exactly
+// the same order as following the FBlockNode chain from blocklinks.
+struct FBlockThing
+{
+	AActor *Me;
+	FBlockNode *Node;
+	bool Single;					// actor is not linked into any other block
+};
+
+// Unlinking only clears an entry (Me becomes null) so that the others keep
+// their positions; the array gets compacted once half of it is dead.
+struct FBlockThings
+{
+	TArray<FBlockThing> Things;
+	unsigned Version = 0;			// changes whenever a thing gets linked into or unlinked from this block
+	unsigned Dead = 0;				// number of cleared entries in Things
+};
+
 // BLOCKMAP
 // Created from axis aligned bounding box
 // of the map, a rectangular array of
@@ -40,6 +61,7 @@ struct FBlockmap
 	double				bmaporgx;
 	double				bmaporgy;		// origin of block map
 	FBlockNode**		blocklinks; 	// for thing chains
+	FBlockThings*		blockthings;	// same as blocklinks, but as arrays for fast iteration
 
 	// mapblocks are used to check movement
 	// against lines and things
@@ -72,6 +94,11 @@ struct FBlockmap
 
 	bool VerifyBlockMap(int count, unsigned numlines);
 
+	void LinkThing(FBlockNode *node, bool single = false);
+	void UnlinkThing(FBlockNode *node);
+	void RelinkThing(FBlockNode *node, bool single);
+	void SetSingle(FBlockNode *node);
+
 	void Clear()
 	{
 		if (blockmaplump != nullptr)
@@ -84,6 +111,11 @@ struct FBlockmap
 			delete[] blocklinks;
 			blocklinks = nullptr;
 		}
+		if (blockthings != nullptr)
+		{
+			delete[] blockthings;
+			blockthings = nullptr;
+		}
 	}
 
 	~FBlockmap()
@@ -897,3 +897,4 @@ xx(frictionfactor)
 xx(movefactor)
 
 xx(Corona)
+xx(ParticleBatchHandler)
@@ -1051,6 +1051,9 @@ void FLevelLocals::Serialize(FSerializer &arc, bool hubload)
 	Thinkers.SerializeThinkers(arc, hubload);
 	arc("polyobjs", Polyobjects);
 	SerializeSubsectors(arc, "subsectors");
+	flowFields.Serialize(arc);
+	arc("particlebatches", ParticleBatches)
+		("particlebatchgeneration", ParticleBatchGeneration);
 	StatusBar->SerializeMessages(arc);
 	canvasTextureInfo.Serialize(arc);
 	SerializePlayers(arc, hubload);
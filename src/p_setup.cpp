@@ -327,6 +327,8 @@ void FLevelLocals::ClearLevelData(bool fullgc)
 	ClearPortals();
 
 	PathNodes.Clear();
+	ParticleBatches.Clear();
+	ParticleBatchGeneration = 0;
 	tagManager.Clear();
 	ClearTIDHashes();
 	if (SpotState) SpotState->Destroy();
@@ -355,6 +357,8 @@ void FLevelLocals::ClearLevelData(bool fullgc)
 	rejectmatrix.Clear();
 	Zones.Clear();
 	blockmap.Clear();
+	lineTree.Clear();
+	flowFields.Clear();
 	Polyobjects.Clear();
 
 	for (auto &pb : PolyBlockMap)
@@ -404,7 +404,7 @@ void FDynamicLight::UpdateLocation()
 		radius = intensity * 2.0f;
 		if (radius < m_currentRadius * 2) radius = m_currentRadius * 2;
 
-		if (X() != oldx || Y() != oldy || radius != oldradius)
+		if ((X() != oldx || Y() != oldy || radius != oldradius) && !StillLinked())
 		{
 			//Update the light lists
 			LinkLight();
@@ -412,36 +412,92 @@ void FDynamicLight::UpdateLocation()
 	}
 }
 
+//==========================================================================
+//
+// Lights get linked with some extra room around them, so that small moves,
+// which is what most attached lights do every tic, don't need to relink
+// them. The light lists are only used to find the lights that may affect
+// something; the actual light falloff only depends on the real radius.
+// Sides are only linked when the light is in front of them, so a light
+// that got to the other side of any side it checked must be relinked.
+//
+//==========================================================================
+
+CVARD(Int, r_dynlightlinkmargin, 32, CVAR_ARCHIVE | CVAR_GLOBALCONFIG, "extra distance dynamic lights are linked with to avoid relinking them on every move")
+
+static inline double PointOnSide(const DVector2 &pos, const side_t *side)
+{
+	auto line = side->linedef;
+	const vertex_t *v1 = line->v1, *v2 = line->v2;
+	if (line->sidedef[0] != side) std::swap(v1, v2);
+	return (pos.Y - v1->fY()) * (v2->fX() - v1->fX()) + (v1->fX() - pos.X) * (v2->fY() - v1->fY());
+}
+
+bool FDynamicLight::StillLinked() const
+{
+	if (linkradius <= 0 || isglobal) return false;
+	if ((Pos.XY() - linkpos.XY()).Length() + radius > linkradius) return false;
+
+	for (auto node = touching_sides; node; node = node->nextTarget)
+	{
+		if (PointOnSide(Pos.XY(), node->targLine) > 0) return false;
+	}
+	for (auto node = facing_away_sides; node; node = node->nextTarget)
+	{
+		if (PointOnSide(Pos.XY(), node->targLine) <= 0) return false;
+	}
+	return true;
+}
+
 //=============================================================================
 //
 // These have been copied from the secnode code and modified for the light links
 //
-// P_AddSecnode() searches the current list to see if this sector is
-// already there. If not, it adds a sector node at the head of the list of
-// sectors this object appears in. This is called when creating a list of
-// nodes that will get linked in later. Returns a pointer to the new node.
+// LinkNewLightNode() adds a node at the head of the list of targets this
+// light touches and at the head of the target's light list. The callers
+// check with their lookup table that the target is not in the list yet.
+// Returns a pointer to the new node.
 //
 //=============================================================================
 
-FLightNode * AddLightNode(FLightNode ** thread, void * linkto, FDynamicLight * light, FLightNode *& nextnode)
+// Light nodes come and go with every moving light, so they are kept on a
+// freelist instead of going through the heap each time.
+static FMemArena LightNodeArena;
+static FLightNode *FreeLightNodes;
+
+static FLightNode *GetLightNode()
 {
-	FLightNode * node;
+	FLightNode *node = FreeLightNodes;
+	if (node != nullptr)
+	{
+		FreeLightNodes = node->nextTarget;
+	}
+	else
+	{
+		node = (FLightNode *)LightNodeArena.Alloc(sizeof(FLightNode));
+	}
+	return node;
+}
 
-	node = nextnode;
-	while (node)
-    {
-		if (node->targ==linkto)   // Already have a node for this sector?
-		{
-			node->lightsource = light; // Yes. Setting m_thing says 'keep it'.
-			return(nextnode);
-		}
-		node = node->nextTarget;
-    }
+static void PutLightNode(FLightNode *node)
+{
+	node->nextTarget = FreeLightNodes;
+	FreeLightNodes = node;
+}
 
-	// Couldn't find an existing node for this sector. Add one at the head
-	// of the list.
-	
-	node = new FLightNode;
+static void PutLightNodeList(FLightNode *&list)
+{
+	while (list)
+	{
+		auto next = list->nextTarget;
+		PutLightNode(list);
+		list = next;
+	}
+}
+
+static FLightNode * LinkNewLightNode(FLightNode ** thread, void * linkto, FDynamicLight * light, FLightNode *& nextnode)
+{
+	FLightNode * node = GetLightNode();
 	
 	node->targ = linkto;
 	node->lightsource = light; 
@@ -484,7 +540,7 @@ static FLightNode * DeleteLightNode(FLightNode * node)
 		
 		// Return this node to the freelist
 		tn=node->nextTarget;
-		delete node;
+		PutLightNode(node);
 		return(tn);
 	}
 	return(nullptr);
@@ -492,6 +548,56 @@ static FLightNode * DeleteLightNode(FLightNode * node)
 
 
 
+//==========================================================================
+//
+// While a light is being relinked, these map each side and section to
+// the light's node for it, so that finding out whether the light already
+// touches it doesn't need to search the entire node list.
+//
+//==========================================================================
+
+struct FLightNodeLookup
+{
+	TArray<FLightNode *> Nodes;
+	TArray<unsigned> Stamps;
+
+	void Prepare(unsigned size, unsigned stamp)
+	{
+		if (Stamps.Size() < size || stamp == 1)
+		{
+			Nodes.Resize(max(size, Nodes.Size()));
+			Stamps.Resize(max(size, Stamps.Size()));
+			memset(Stamps.Data(), 0, Stamps.Size() * sizeof(unsigned));
+		}
+	}
+};
+
+static FLightNodeLookup SideLookup, SectionLookup;
+static unsigned LightLinkStamp;
+
+static FLightNode *AddLightNodeLookup(FLightNodeLookup &lookup, unsigned index, FLightNode ** thread, void * linkto, FDynamicLight * light, FLightNode *& nextnode)
+{
+	if (lookup.Stamps[index] == LightLinkStamp)
+	{
+		lookup.Nodes[index]->lightsource = light;	// 'keep it'
+		return nextnode;
+	}
+	FLightNode *node = LinkNewLightNode(thread, linkto, light, nextnode);
+	lookup.Nodes[index] = node;
+	lookup.Stamps[index] = LightLinkStamp;
+	return node;
+}
+
+FLightNode *FDynamicLight::AddSideNode(side_t *side)
+{
+	return AddLightNodeLookup(SideLookup, side->Index(), &side->lighthead, side, this, touching_sides);
+}
+
+FLightNode *FDynamicLight::AddSectionNode(FSection *section)
+{
+	return AddLightNodeLookup(SectionLookup, unsigned(section - Level->sections.allSections.Data()), &section->lighthead, section, this, touching_sector);
+}
+
 //==========================================================================
 //
 // Gets the light's distance to a line
@@ -546,7 +652,10 @@ void FDynamicLight::CollectWithinRadius(const DVector3 &opos, FSection *section,
 		auto pos = collected_ss[i].pos;
 		section = collected_ss[i].sect;
 
-		touching_sector = AddLightNode(&section->lighthead, section, this, touching_sector);
+		// StillLinked only checks the sides from the light's own position, so anything seen through a portal needs a relink on every move.
+		if (pos != opos) linkradius = 0;
+
+		touching_sector = AddSectionNode(section);
 
 
 		auto processSide = [&](side_t *sidedef, const vertex_t *v1, const vertex_t *v2)
@@ -558,11 +667,22 @@ void FDynamicLight::CollectWithinRadius(const DVector3 &opos, FSection *section,
 				if ((pos.Y - v1->fY()) * (v2->fX() - v1->fX()) + (v1->fX() - pos.X) * (v2->fY() - v1->fY()) <= 0)
 				{
 					linedef->validcount = ::validcount;
-					touching_sides = AddLightNode(&sidedef->lighthead, sidedef, this, touching_sides);
+					touching_sides = AddSideNode(sidedef);
 				}
-				else if (linedef->sidedef[0] == sidedef && linedef->sidedef[1] == nullptr)
+				else
 				{
-					hitonesidedback = true;
+					if (linedef->sidedef[0] == sidedef && linedef->sidedef[1] == nullptr)
+					{
+						hitonesidedback = true;
+					}
+					if (linkradius > 0)
+					{
+						// remember it so that StillLinked notices the light getting in front of it.
+						auto node = GetLightNode();
+						node->targLine = sidedef;
+						node->nextTarget = facing_away_sides;
+						facing_away_sides = node;
+					}
 				}
 			}
 			if (linedef)
@@ -656,11 +776,11 @@ void FDynamicLight::CollectAll(const DVector3 &opos)
 {
 	for (int i = 0 ; i < Level->sections.allSections.Size() ; i++)
 	{
-		touching_sector = AddLightNode(&Level->sections.allSections[i].lighthead, &Level->sections.allSections[i], this, touching_sector);
+		touching_sector = AddSectionNode(&Level->sections.allSections[i]);
 	}
 	for (int i = 0 ; i < Level->sides.Size(); i++)
 	{
-		touching_sides = AddLightNode(&Level->sides[i].lighthead, &Level->sides[i], this, touching_sides);
+		touching_sides = AddSideNode(&Level->sides[i]);
 	}
 	shadowmapped = false;
 }
@@ -676,6 +796,10 @@ void FDynamicLight::LinkLight()
 	if (isglobal)
 		return;
 
+	if (++LightLinkStamp == 0) LightLinkStamp = 1;
+	SideLookup.Prepare(Level->sides.Size(), LightLinkStamp);
+	SectionLookup.Prepare(Level->sections.allSections.Size(), LightLinkStamp);
+
 	// mark the old light nodes
 	FLightNode * node;
 	
@@ -683,15 +807,23 @@ void FDynamicLight::LinkLight()
 	while (node)
     {
 		node->lightsource = nullptr;
+		unsigned index = node->targLine->Index();
+		SideLookup.Nodes[index] = node;
+		SideLookup.Stamps[index] = LightLinkStamp;
 		node = node->nextTarget;
     }
 	node = touching_sector;
 	while (node)
 	{
 		node->lightsource = nullptr;
+		unsigned index = unsigned((FSection *)node->targ - Level->sections.allSections.Data());
+		SectionLookup.Nodes[index] = node;
+		SectionLookup.Stamps[index] = LightLinkStamp;
 		node = node->nextTarget;
 	}
 
+	linkradius = 0;
+	PutLightNodeList(facing_away_sides);
 	if (radius>0)
 	{
 		// passing in radius*radius allows us to do a distance check without any calls to sqrt
@@ -706,8 +838,12 @@ void FDynamicLight::LinkLight()
 		}
 		else
 		{
+			float reach = radius + max(0, *r_dynlightlinkmargin);
+			linkpos = Pos;
+			linkradius = reach;
 			FSection *sect = Level->PointInRenderSubsector(Pos)->section;
-			CollectWithinRadius(Pos, sect, float(radius*radius));
+			CollectWithinRadius(Pos, sect, float(reach*reach));
+			if (linkradius <= 0) PutLightNodeList(facing_away_sides);
 		}
 
 	}
@@ -748,8 +884,10 @@ void FDynamicLight::UnlinkLight ()
 {
 	while (touching_sides) touching_sides = DeleteLightNode(touching_sides);
 	while (touching_sector) touching_sector = DeleteLightNode(touching_sector);
+	PutLightNodeList(facing_away_sides);
 	shadowmapped = false;
 	isglobal = false;
+	linkradius = 0;
 }
 
 //==========================================================================
@@ -253,6 +253,9 @@ private:
 	double DistToSeg(const DVector3 &pos, vertex_t *start, vertex_t *end);
 	void CollectWithinRadius(const DVector3 &pos, FSection *section, float radius);
 	void CollectAll(const DVector3 &pos);
+	bool StillLinked() const;
+	FLightNode *AddSideNode(side_t *side);
+	FLightNode *AddSectionNode(FSection *section);
 
 public:
 	FCycler m_cycler;
@@ -275,6 +278,9 @@ public:
 	FLightNode * touching_sides;
 	FLightNode * touching_sector;
 	float radius;			// The maximum size the light can be with its current settings.
+	FLightNode * facing_away_sides;	// Sides in reach the light was behind when it was linked. Not linked to the sides.
+	DVector3 linkpos;		// Where the light was when it was last linked,
+	float linkradius;		// and the radius it was linked with (0 if not linked).
 	float m_currentRadius;	// The current light size.
 	int m_tickCount;
 	int m_lastUpdate;
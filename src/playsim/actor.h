@@ -1114,6 +1114,30 @@ public:
 	AActor			*snext, **sprev;	// links in sector (if needed)
 	DVector3		__Pos;		// double underscores so that it won't get used by accident. Access to this should be exclusively through the designated access functions.
 
+// Hot simulation state. Tick, P_XYMovement, P_ZMovement and the blockmap
+// iterators read little beyond these, so they are kept together right after
+// the sector links and the position where they share a handful of cache
+// lines. Use 'dumpactorlayout' to check the result after adding fields.
+	DVector3		Vel;
+	double			radius, Height;		// for movement checking
+	double			floorz, ceilingz;	// closest together of contacted secs
+	double			dropoffz;		// killough 11/98: the lowest floor over all contacted Sectors.
+	struct sector_t	*Sector;
+	subsector_t *		subsector;
+	FBlockNode		*BlockNode;			// links in blocks (if needed)
+	FState			*state;
+	int32_t			tics;				// state tic counter
+	uint32_t		freezetics;	// actor has actions completely frozen (including movement) for this many tics, but they still get Tick() calls
+	ActorFlags		flags;
+	ActorFlags2		flags2;			// Heretic flags
+	ActorFlags3		flags3;			// [RH] Hexen/Heretic actor-dependant behavior made flaggable
+	ActorFlags4		flags4;			// [RH] Even more flags!
+	ActorFlags5		flags5;			// OMG! We need another one.
+	ActorFlags6		flags6;			// Shit! Where did all the flags go?
+	ActorFlags7		flags7;			// WHO WANTS TO BET ON 8!?
+	ActorFlags8		flags8;			// I see your 8, and raise you a bet for 9.
+	ActorFlags9		flags9;			// Happy ninth actor flag field GZDoom !
+
 	DAngle			SpriteAngle;
 	DAngle			SpriteRotation;
 	DVector2		AutomapOffsets;		// Offset the actors' sprite view on the automap by these coordinates.
@@ -1138,17 +1162,7 @@ public:
 	bool				NoLocalRender;		// DO NOT EXPORT THIS! This is a way to disable rendering such that the playsim cannot access it.
 	ActorRenderFlags	renderflags;		// Different rendering flags
 	ActorRenderFlags2	renderflags2;		// More rendering flags...
-	ActorFlags		flags;
-	ActorFlags2		flags2;			// Heretic flags
-	ActorFlags3		flags3;			// [RH] Hexen/Heretic actor-dependant behavior made flaggable
-	ActorFlags4		flags4;			// [RH] Even more flags!
-	ActorFlags5		flags5;			// OMG! We need another one.
-	ActorFlags6		flags6;			// Shit! Where did all the flags go?
-	ActorFlags7		flags7;			// WHO WANTS TO BET ON 8!?
-	ActorFlags8		flags8;			// I see your 8, and raise you a bet for 9.
-	ActorFlags9		flags9;			// Happy ninth actor flag field GZDoom !
 	double			Floorclip;		// value to use for floor clipping
-	double			radius, Height;		// for movement checking
 
 	FAngle			VisibleStartAngle;
 	FAngle			VisibleStartPitch;
@@ -1156,7 +1170,6 @@ public:
 	FAngle			VisibleEndPitch;
 
 	DVector3		OldRenderPos;
-	DVector3		Vel;
 	DVector2		SpriteOffset;
 	DVector3		WorldOffset;
 	double			Speed;
@@ -1166,12 +1179,7 @@ public:
 
 // interaction info
 	TArray<TObjPtr<AActor*> > Path;
-	FBlockNode		*BlockNode;			// links in blocks (if needed)
-	struct sector_t	*Sector;
-	subsector_t *		subsector;
 	FSection *			section;
-	double			floorz, ceilingz;	// closest together of contacted secs
-	double			dropoffz;		// killough 11/98: the lowest floor over all contacted Sectors.
 
 	uint32_t		ThruBits;
 	FTextureID		floorpic;			// contacted sec floorpic
@@ -1191,8 +1199,6 @@ public:
 	double			StealthAlpha;	// Minmum alpha for MF_STEALTH.
 	int				WoundHealth;		// Health needed to enter wound state
 
-	int32_t			tics;				// state tic counter
-	FState			*state;
 	//VMFunction		*Damage;			// For missiles and monster railgun
 	int				DamageVal;
 	int				projectileKickback;
@@ -1283,8 +1289,6 @@ public:
 	sector_t		*BlockingCeiling;	// Sector that blocked the last move (ceiling plane slope)
 	sector_t		*BlockingFloor;		// Sector that blocked the last move (floor plane slope)
 
-	uint32_t		freezetics;	// actor has actions completely frozen (including movement) for this many tics, but they still get Tick() calls
-
 	int PoisonDamage; // Damage received per tic from poison.
 	FName PoisonDamageType; // Damage type dealt by poison.
 	int PoisonDuration; // Duration left for receiving poison damage.
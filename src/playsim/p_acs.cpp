@@ -78,6 +78,8 @@
 #include "s_music.h"
 #include "v_video.h"
 #include "texturemanager.h"
+#include "vmbuilder.h"
+#include "m_crc32.h"
 
 	// P-codes for ACS scripts
 	enum
@@ -546,6 +548,9 @@ FRandom pr_acs ("ACS");
 // potentially get used with recursive functions.
 #define STACK_SIZE 4096
 
+// Number of p-codes a script may execute in one tic before it is considered stuck.
+#define RUNAWAY_LIMIT 2000000
+
 // HUD message flags
 #define HUDMSG_LOG					(0x80000000)
 #define HUDMSG_COLORSTRING			(0x40000000)
@@ -697,6 +702,8 @@ public:
 	FLevelLocals	*Level;
 
 protected:
+	friend struct FACSJit;
+
 	DLevelScript	*next, *prev;
 	int				script;
 	TArray<int32_t>	Localvars;
@@ -2206,7 +2213,9 @@ FBehavior::FBehavior()
 	memset (MapVarStore, 0, sizeof(MapVarStore));
 	ModuleName[0] = 0;
 	FunctionProfileData = NULL;
-
+	Checksum = 0;
+	ChecksumValid = false;
+	JitImage = -1;
 }
 	
 	
@@ -2723,6 +2732,24 @@ FBehavior::~FBehavior ()
 	}
 }
 
+//============================================================================
+//
+// FBehavior :: GetChecksum
+//
+// Lets the JIT quickly tell apart modules with different contents.
+//
+//============================================================================
+
+uint32_t FBehavior::GetChecksum()
+{
+	if (!ChecksumValid)
+	{
+		Checksum = CalcCRC32(Data, DataSize);
+		ChecksumValid = true;
+	}
+	return Checksum;
+}
+
 void FBehavior::LoadScriptsDirectory ()
 {
 	union
@@ -6871,100 +6898,1428 @@ PClass *DLevelScript::GetClassForIndex(int index) const
 	return PClass::FindActor(Level->Behaviors.LookupString(index));
 }
 
-int DLevelScript::RunScript()
+//============================================================================
+//
+// ACS to VM translation
+//
+// With acs_jit enabled, the code a script runs from the point where
+// RunScript picks it up is translated into a VMScriptFunction, so that it
+// goes through the JIT like compiled ZScript does. The ACS stack is kept in
+// VM registers. The translated code returns to RunScript when the script
+// stops running or when it reaches a p-code it cannot translate. In that case
+// it writes the stack back and the interpreter carries on from that p-code.
+//
+// A script always resumes with an empty stack, so the only entry points are
+// script starts and the p-codes following a delay. Translations are cached
+// by module checksum and entry offset so that reloading a map reuses them.
+//
+//============================================================================
+
+CVAR(Bool, acs_jit, false, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)
+
+enum
 {
-	DACSThinker *controller = Level->ACSThinker;
-	ACSLocalVariables locals(Localvars);
-	ACSLocalArrays noarrays;
-	ACSLocalArrays *localarrays = &noarrays;
-	ScriptFunction *activeFunction = NULL;
-	FRemapTable *translation = 0;
-	int resultValue = 1;
-	int transi = -1;
+	ACSJIT_MaxStack = 32,		// deepest stack kept in registers
+	ACSJIT_MaxOps = 16384,		// p-codes translated per entry point
+	ACSJIT_MaxCases = 256,		// largest sorted case table translated
+};
 
-	if (InModuleScriptNumber >= 0)
+// Shared between RunScript and the translated code.
+struct FACSJitContext
+{
+	DLevelScript *Script;
+	int32_t *Locals;
+	int32_t **MapVars;
+	int32_t *Stack;				// the interpreter's stack, written back on exit and before calls
+	int *SP;
+	int Runaway;
+	int SpecialArgMask;
+	int Running;				// cleared by the helpers when the script stopped running
+};
+
+struct FACSJitOp
+{
+	uint32_t Ofs, Next;
+	int PCode;
+	int Depth;					// stack depth before this p-code
+	int Pop, Push;
+	int BranchPop;				// additionally popped when a case jump is taken
+	int Arg[4];
+	TArray<int> Values;			// pushed constants, direct special arguments, case values
+	TArray<uint32_t> Targets;
+	bool Supported;
+	bool FallsThrough;
+	bool Leader;				// starts a block for runaway counting
+};
+
+struct FACSJit
+{
+	enum
 	{
-		ScriptPtr *ptr = activeBehavior->GetScriptPtr(InModuleScriptNumber);
-		assert(ptr != NULL);
-		if (ptr != NULL)
+		VAR_Script,
+		VAR_Map,
+		VAR_World,
+		VAR_Global,
+
+		VOP_Push = 0,
+		VOP_Assign,
+		VOP_Inc,
+		VOP_Dec,
+		VOP_Binary,
+
+		HELPER_LSpec = 0,
+		HELPER_CallFunc,
+		HELPER_Random,
+		HELPER_Delay,
+		HELPER_SetState,
+		NUM_HELPERS
+	};
+
+	struct CacheEntry
+	{
+		VMScriptFunction *Func;
+		int NumLocals;
+	};
+
+	struct ModuleImage
+	{
+		uint32_t Checksum;
+		TArray<uint8_t> Data;
+	};
+
+	struct Fixup
+	{
+		size_t Jump;
+		uint32_t Target;
+	};
+
+	struct Exit
+	{
+		size_t Jump;
+		uint32_t Resume;
+		int Depth;
+		int Adjust;
+		int State;
+	};
+
+	static VMFunction *Helpers[NUM_HELPERS];
+	static TMap<uint64_t, CacheEntry> Cache;
+	static TArray<ModuleImage> Images;
+
+	FBehavior *Module;
+	ACSFormat Fmt;
+	int NumLocals;
+	int MaxDepth = 0;
+	TArray<FACSJitOp> Ops;
+	TMap<uint32_t, unsigned> OpIndex;
+	TMap<uint32_t, size_t> Labels;
+	TArray<Fixup> Fixups;
+	TArray<Exit> Exits;
+	VMFunctionBuilder Build;
+
+	int Ctx, LocalsReg, MapVarsReg, StackReg, SPReg, AddrReg;
+	int Runaway, Temp, StackBase;
+	int BlockCount = 0, Executed = 0;
+
+	FACSJit(FBehavior *module, int numlocals)
+		: Module(module), Fmt(module->GetFormat()), NumLocals(numlocals), Build(0)
+	{
+	}
+
+	static VMFunction *GetFunction(FBehavior *module, uint32_t ofs, int numlocals);
+	static int FindImage(FBehavior *module);
+
+	static int LSpec(FACSJitContext *ctx, int special, int arg1, int arg2, int arg3, int arg4, int arg5);
+	static int CallFunc(FACSJitContext *ctx, int argCount, int funcIndex);
+	static int Random(FACSJitContext *ctx, int min, int max);
+	static int Delay(FACSJitContext *ctx, int tics);
+	static int SetState(FACSJitContext *ctx, int state);
+
+private:
+	static void CreateHelpers();
+
+	VMScriptFunction *Compile(uint32_t entry);
+	bool Decode(uint32_t ofs, FACSJitOp &op);
+	bool DecodeVarOp(int pcd, int *&pc, FACSJitOp &op);
+	int CountBlock(const TArray<unsigned> &order, unsigned i);
+
+	int S(int slot) const { return StackBase + slot; }
+	int K(int val) { return Build.GetConstantInt(val); }
+
+	void EmitOp(const FACSJitOp &op, const FACSJitOp *branch);
+	void EmitBinary(int pcd, int dest, int a, int b);
+	size_t EmitCompare(int pcd, int a, int b, bool when);
+	size_t EmitTest(int reg, bool nonzero);
+	void EmitVarAddress(int varclass, int index, int &areg, int &ofs);
+	void EmitCall(int helper, int numparams, int result);
+	void EmitSpill(int depth);
+	void EmitAddRunaway(int count);
+	void EmitExit(uint32_t resume, int depth, int adjust, int state);
+	void AddExit(size_t jump, uint32_t resume, int depth, int state = 0);
+};
+
+VMFunction *FACSJit::Helpers[FACSJit::NUM_HELPERS];
+TMap<uint64_t, FACSJit::CacheEntry> FACSJit::Cache;
+TArray<FACSJit::ModuleImage> FACSJit::Images;
+
+//============================================================================
+//
+// Helpers called from translated code
+//
+// Anything that goes beyond plain arithmetic and variable access is done by
+// calling back into the script, the same way the interpreter does it.
+//
+//============================================================================
+
+int FACSJit::LSpec(FACSJitContext *ctx, int special, int arg1, int arg2, int arg3, int arg4, int arg5)
+{
+	DLevelScript *script = ctx->Script;
+	const int mask = ctx->SpecialArgMask;
+	int res = P_ExecuteSpecial(script->Level, special, script->activationline, script->activator, script->backSide,
+		arg1 & mask, arg2 & mask, arg3 & mask, arg4 & mask, arg5 & mask);
+	ctx->Running = script->state == DLevelScript::SCRIPT_Running;
+	return res;
+}
+
+int FACSJit::CallFunc(FACSJitContext *ctx, int argCount, int funcIndex)
+{
+	DLevelScript *script = ctx->Script;
+	int minCount = 0;
+	int retval = script->CallFunction(argCount, funcIndex, &ctx->Stack[*ctx->SP - argCount], minCount);
+	if (minCount != 0)
+	{
+		Printf("Called ACS function index %d with too few args: %d (need %d)\n", funcIndex, argCount, minCount);
+	}
+	ctx->Running = script->state == DLevelScript::SCRIPT_Running;
+	return retval;
+}
+
+int FACSJit::Random(FACSJitContext *ctx, int min, int max)
+{
+	return ctx->Script->Random(min, max);
+}
+
+int FACSJit::Delay(FACSJitContext *ctx, int tics)
+{
+	DLevelScript *script = ctx->Script;
+	script->statedata = tics + (script->activeBehavior->GetFormat() == ACS_Old && gameinfo.gametype == GAME_Hexen);
+	if (script->statedata > 0)
+	{
+		script->state = DLevelScript::SCRIPT_Delayed;
+	}
+	return ctx->Running = script->state == DLevelScript::SCRIPT_Running;
+}
+
+int FACSJit::SetState(FACSJitContext *ctx, int state)
+{
+	DLevelScript *script = ctx->Script;
+	if (state == DLevelScript::SCRIPT_PleaseRemove)
+	{
+		DPrintf (DMSG_NOTIFY, "%s finished\n", ScriptPresentation(script->script).GetChars());
+	}
+	script->state = DLevelScript::EScriptState(state);
+	return ctx->Running = 0;
+}
+
+static int ACSJit_LSpec(VM_ARGS)
+{
+	PARAM_PROLOGUE;
+	PARAM_POINTER(ctx, FACSJitContext);
+	PARAM_INT(special);
+	PARAM_INT(arg1);
+	PARAM_INT(arg2);
+	PARAM_INT(arg3);
+	PARAM_INT(arg4);
+	PARAM_INT(arg5);
+	ACTION_RETURN_INT(FACSJit::LSpec(ctx, special, arg1, arg2, arg3, arg4, arg5));
+}
+
+static int ACSJit_CallFunc(VM_ARGS)
+{
+	PARAM_PROLOGUE;
+	PARAM_POINTER(ctx, FACSJitContext);
+	PARAM_INT(argcount);
+	PARAM_INT(funcindex);
+	ACTION_RETURN_INT(FACSJit::CallFunc(ctx, argcount, funcindex));
+}
+
+static int ACSJit_Random(VM_ARGS)
+{
+	PARAM_PROLOGUE;
+	PARAM_POINTER(ctx, FACSJitContext);
+	PARAM_INT(min);
+	PARAM_INT(max);
+	ACTION_RETURN_INT(FACSJit::Random(ctx, min, max));
+}
+
+static int ACSJit_Delay(VM_ARGS)
+{
+	PARAM_PROLOGUE;
+	PARAM_POINTER(ctx, FACSJitContext);
+	PARAM_INT(tics);
+	ACTION_RETURN_INT(FACSJit::Delay(ctx, tics));
+}
+
+static int ACSJit_SetState(VM_ARGS)
+{
+	PARAM_PROLOGUE;
+	PARAM_POINTER(ctx, FACSJitContext);
+	PARAM_INT(state);
+	ACTION_RETURN_INT(FACSJit::SetState(ctx, state));
+}
+
+void FACSJit::CreateHelpers()
+{
+	static const struct
+	{
+		VMNativeFunction::NativeCallType Call;
+		void *Direct;
+		const char *Name;
+		int NumArgs;
+	} helpers[NUM_HELPERS] =
+	{
+		{ ACSJit_LSpec,		(void *)&FACSJit::LSpec,		"ACSJit.LSpec",		6 },
+		{ ACSJit_CallFunc,	(void *)&FACSJit::CallFunc,		"ACSJit.CallFunc",	2 },
+		{ ACSJit_Random,	(void *)&FACSJit::Random,		"ACSJit.Random",	2 },
+		{ ACSJit_Delay,		(void *)&FACSJit::Delay,		"ACSJit.Delay",		1 },
+		{ ACSJit_SetState,	(void *)&FACSJit::SetState,		"ACSJit.SetState",	1 },
+	};
+
+	for (int i = 0; i < NUM_HELPERS; i++)
+	{
+		auto func = new VMNativeFunction(helpers[i].Call, FName(helpers[i].Name));
+		func->DirectNativeCall = helpers[i].Direct;
+		func->QualifiedName = func->PrintableName = helpers[i].Name;
+
+		TArray<PType *> rets, args;
+		rets.Push(TypeSInt32);
+		args.Push(TypeVoidPtr);
+		for (int j = 0; j < helpers[i].NumArgs; j++)
 		{
-			localarrays = &ptr->LocalArrays;
+			args.Push(TypeSInt32);
 		}
+		func->Proto = NewPrototype(rets, args);
+
+		auto regtypes = (uint8_t *)ClassDataAllocator.Alloc(args.Size());
+		regtypes[0] = REGT_POINTER;
+		memset(regtypes + 1, REGT_INT, helpers[i].NumArgs);
+		func->RegTypes = regtypes;
+
+		Helpers[i] = func;
+		// Shutting down the VM clears these, which is also the signal that
+		// all cached translations are gone.
+		PClass::FunctionPtrList.Push(&Helpers[i]);
 	}
+}
 
-	// Hexen truncates all special arguments to bytes (only when using an old MAPINFO and old ACS format
-	const int specialargmask = ((Level->flags2 & LEVEL2_HEXENHACK) && activeBehavior->GetFormat() == ACS_Old) ? 255 : ~0;
+//============================================================================
+//
+// FACSJit :: GetFunction
+//
+// Returns the translation of the code starting at ofs, or NULL if the
+// interpreter has to run it.
+//
+//============================================================================
 
-	switch (state)
+VMFunction *FACSJit::GetFunction(FBehavior *module, uint32_t ofs, int numlocals)
+{
+	if (Helpers[0] == nullptr)
 	{
-	case SCRIPT_Delayed:
-		// Decrement the delay counter and enter state running
-		// if it hits 0
-		if (--statedata == 0)
-			state = SCRIPT_Running;
-		break;
+		Cache.Clear();
+		CreateHelpers();
+	}
 
-	case SCRIPT_TagWait:
-		// Wait for tagged sector(s) to go inactive, then enter
-		// state running
+	int image = module->GetJitImage();
+	if (image < 0)
 	{
-		int secnum;
-		auto it = Level->GetSectorTagIterator(statedata);
-		while ((secnum = it.Next()) >= 0)
+		image = FindImage(module);
+		module->SetJitImage(image);
+	}
+
+	const uint64_t key = ((uint64_t)image << 32) | ofs;
+	CacheEntry *entry = Cache.CheckKey(key);
+	if (entry == nullptr)
+	{
+		FACSJit jit(module, numlocals);
+		entry = &Cache.Insert(key, { jit.Compile(ofs), numlocals });
+	}
+	return entry->NumLocals == numlocals ? entry->Func : nullptr;
+}
+
+//============================================================================
+//
+// FACSJit :: FindImage
+//
+// Translations are shared by all modules with identical contents, so that
+// they survive loading the same module again. A matching checksum is not
+// enough to tell that, so each distinct module's data is kept and compared.
+//
+//============================================================================
+
+int FACSJit::FindImage(FBehavior *module)
+{
+	const uint32_t checksum = module->GetChecksum();
+	const unsigned size = module->GetDataSize();
+	const uint8_t *data = (const uint8_t *)module->Ofs2PC(0);
+
+	for (unsigned i = 0; i < Images.Size(); i++)
+	{
+		if (Images[i].Checksum == checksum && Images[i].Data.Size() == size && !memcmp(Images[i].Data.Data(), data, size))
 		{
-			if (Level->sectors[secnum].floordata || Level->sectors[secnum].ceilingdata)
-				return resultValue;
+			return i;
 		}
+	}
+	auto &image = Images[Images.Reserve(1)];
+	image.Checksum = checksum;
+	image.Data.Resize(size);
+	memcpy(image.Data.Data(), data, size);
+	return Images.Size() - 1;
+}
 
-		// If we got here, none of the tagged sectors were busy
-		state = SCRIPT_Running;
+//============================================================================
+//
+// FACSJit :: Decode
+//
+// Reads one p-code the same way the interpreter does and records its stack
+// effect and immediates. Returns false for p-codes that are left to the
+// interpreter.
+//
+//============================================================================
+
+bool FACSJit::Decode(uint32_t ofs, FACSJitOp &op)
+{
+	const uint32_t size = Module->GetDataSize();
+
+	// Enough room for the longest fixed size p-code. Case tables are checked separately.
+	if (ofs + 32 > size)
+	{
+		return false;
 	}
-	break;
 
-	case SCRIPT_PolyWait:
-		// Wait for polyobj(s) to stop moving, then enter state running
-		if (!PO_Busy (Level, statedata))
+	int *pc = Module->Ofs2PC(ofs);
+	const ACSFormat fmt = Fmt;
+	int pcd;
+
+	if (fmt == ACS_LittleEnhanced)
+	{
+		pcd = getbyte(pc);
+		if (pcd >= 256-16)
 		{
-			state = SCRIPT_Running;
+			pcd = (256-16) + ((pcd - (256-16)) << 8) + getbyte(pc);
+		}
+	}
+	else
+	{
+		pcd = NEXTWORD;
+	}
+
+	op.PCode = pcd;
+	op.Pop = op.Push = op.BranchPop = 0;
+	op.FallsThrough = true;
+
+	switch (pcd)
+	{
+	case PCD_NOP:
+		break;
+
+	case PCD_TERMINATE:
+		op.FallsThrough = false;
+		break;
+
+	case PCD_PUSHNUMBER:
+		op.Values.Push(uallong(pc[0]));
+		op.Push = 1;
+		pc++;
+		break;
+
+	case PCD_PUSHBYTE:
+	case PCD_PUSH2BYTES:
+	case PCD_PUSH3BYTES:
+	case PCD_PUSH4BYTES:
+	case PCD_PUSH5BYTES:
+		op.Push = pcd == PCD_PUSHBYTE ? 1 : pcd - PCD_PUSH2BYTES + 2;
+		for (int i = 0; i < op.Push; i++)
+		{
+			op.Values.Push(((uint8_t *)pc)[i]);
 		}
+		pc = (int *)((uint8_t *)pc + op.Push);
 		break;
 
-	case SCRIPT_ScriptWaitPre:
-		// Wait for a script to start running, then enter state scriptwait
-		if (controller->RunningScripts.CheckKey(statedata) != NULL)
-			state = SCRIPT_ScriptWait;
+	case PCD_PUSHBYTES:
+		op.Push = *(uint8_t *)pc;
+		for (int i = 0; i < op.Push; i++)
+		{
+			op.Values.Push(((uint8_t *)pc)[i + 1]);
+		}
+		pc = (int *)((uint8_t *)pc + op.Push + 1);
 		break;
 
-	case SCRIPT_ScriptWait:
-		// Wait for a script to stop running, then enter state running
-		if (controller->RunningScripts.CheckKey(statedata) != NULL)
-			return resultValue;
+	case PCD_DUP:
+		op.Pop = 1;
+		op.Push = 2;
+		break;
 
-		state = SCRIPT_Running;
-		PutFirst ();
+	case PCD_SWAP:
+		op.Pop = op.Push = 2;
 		break;
 
-	default:
+	case PCD_DROP:
+		op.Pop = 1;
 		break;
-	}
 
-	FACSStack stackobj;
-	FACSStackMemory& Stack = stackobj.buffer;
-	int &sp = stackobj.sp;
+	case PCD_LSPEC1:
+	case PCD_LSPEC2:
+	case PCD_LSPEC3:
+	case PCD_LSPEC4:
+	case PCD_LSPEC5:
+		op.Arg[0] = NEXTBYTE;
+		op.Pop = pcd - PCD_LSPEC1 + 1;
+		break;
 
-	int *pc = this->pc;
-	ACSFormat fmt = activeBehavior->GetFormat();
-	FBehavior* const savedActiveBehavior = activeBehavior;
-	unsigned int runaway = 0;	// used to prevent infinite loops
-	int pcd;
-	FString work;
-	const char *lookup;
-	int optstart = -1;
-	int temp;
+	case PCD_LSPEC5RESULT:
+		op.Arg[0] = NEXTBYTE;
+		op.Pop = 5;
+		op.Push = 1;
+		break;
+
+	case PCD_LSPEC5EX:
+		op.Arg[0] = NEXTWORD;
+		op.Pop = 5;
+		break;
+
+	case PCD_LSPEC5EXRESULT:
+		op.Arg[0] = NEXTWORD;
+		op.Pop = 5;
+		op.Push = 1;
+		break;
+
+	case PCD_LSPEC1DIRECT:
+	case PCD_LSPEC2DIRECT:
+	case PCD_LSPEC3DIRECT:
+	case PCD_LSPEC4DIRECT:
+	case PCD_LSPEC5DIRECT:
+		op.Arg[0] = NEXTBYTE;
+		for (int i = 0; i <= pcd - PCD_LSPEC1DIRECT; i++)
+		{
+			op.Values.Push(uallong(pc[i]));
+		}
+		pc += op.Values.Size();
+		break;
+
+	case PCD_LSPEC1DIRECTB:
+	case PCD_LSPEC2DIRECTB:
+	case PCD_LSPEC3DIRECTB:
+	case PCD_LSPEC4DIRECTB:
+	case PCD_LSPEC5DIRECTB:
+		op.Arg[0] = ((uint8_t *)pc)[0];
+		for (int i = 1; i <= pcd - PCD_LSPEC1DIRECTB + 1; i++)
+		{
+			op.Values.Push(((uint8_t *)pc)[i]);
+		}
+		pc = (int *)((uint8_t *)pc + op.Values.Size() + 1);
+		break;
+
+	case PCD_CALLFUNC:
+		op.Arg[0] = NEXTBYTE;
+		op.Arg[1] = NEXTSHORT;
+		op.Pop = op.Arg[0];
+		op.Push = 1;
+		break;
+
+	case PCD_ADD:
+	case PCD_SUBTRACT:
+	case PCD_MULTIPLY:
+	case PCD_DIVIDE:
+	case PCD_MODULUS:
+	case PCD_EQ:
+	case PCD_NE:
+	case PCD_LT:
+	case PCD_GT:
+	case PCD_LE:
+	case PCD_GE:
+	case PCD_ANDLOGICAL:
+	case PCD_ORLOGICAL:
+	case PCD_ANDBITWISE:
+	case PCD_ORBITWISE:
+	case PCD_EORBITWISE:
+	case PCD_LSHIFT:
+	case PCD_RSHIFT:
+		op.Pop = 2;
+		op.Push = 1;
+		break;
+
+	case PCD_NEGATELOGICAL:
+	case PCD_NEGATEBINARY:
+	case PCD_UNARYMINUS:
+		op.Pop = op.Push = 1;
+		break;
+
+	case PCD_GOTO:
+		op.Targets.Push(LittleLong(*pc));
+		op.FallsThrough = false;
+		pc++;
+		break;
+
+	case PCD_IFGOTO:
+	case PCD_IFNOTGOTO:
+		op.Targets.Push(LittleLong(*pc));
+		op.Pop = 1;
+		pc++;
+		break;
+
+	case PCD_CASEGOTO:
+		// The value stays on the stack unless the jump is taken.
+		op.Values.Push(uallong(pc[0]));
+		op.Targets.Push(uallong(pc[1]));
+		op.Pop = op.Push = op.BranchPop = 1;
+		pc += 2;
+		break;
+
+	case PCD_CASEGOTOSORTED:
+	{
+		// The count and jump table are 4-byte aligned
+		pc = (int *)(((size_t)pc + 3) & ~3);
+		int numcases = uallong(pc[0]); pc++;
+		if (numcases < 0 || numcases > ACSJIT_MaxCases || Module->PC2Ofs(pc) + numcases * 8 > size)
+		{
+			return false;
+		}
+		for (int i = 0; i < numcases; i++)
+		{
+			int32_t caseval = LittleLong(pc[i*2]);
+			// The interpreter does a binary search, which only matches a
+			// linear one if the table really is sorted.
+			if (i > 0 && caseval <= op.Values.Last())
+			{
+				return false;
+			}
+			op.Values.Push(caseval);
+			op.Targets.Push(LittleLong(pc[i*2+1]));
+		}
+		op.Pop = op.Push = op.BranchPop = 1;
+		pc += numcases * 2;
+		break;
+	}
+
+	case PCD_DELAY:
+		op.Pop = 1;
+		break;
+
+	case PCD_DELAYDIRECT:
+		op.Values.Push(uallong(pc[0]));
+		pc++;
+		break;
+
+	case PCD_DELAYDIRECTB:
+		op.Values.Push(*(uint8_t *)pc);
+		pc = (int *)((uint8_t *)pc + 1);
+		break;
+
+	case PCD_RANDOM:
+		op.Pop = 2;
+		op.Push = 1;
+		break;
+
+	case PCD_RANDOMDIRECT:
+		op.Values.Push(uallong(pc[0]));
+		op.Values.Push(uallong(pc[1]));
+		op.Push = 1;
+		pc += 2;
+		break;
+
+	case PCD_RANDOMDIRECTB:
+		op.Values.Push(((uint8_t *)pc)[0]);
+		op.Values.Push(((uint8_t *)pc)[1]);
+		op.Push = 1;
+		pc = (int *)((uint8_t *)pc + 2);
+		break;
+
+	default:
+		if (!DecodeVarOp(pcd, pc, op))
+		{
+			return false;
+		}
+		break;
+	}
+
+	op.Next = Module->PC2Ofs(pc);
+	return op.Next <= size;
+}
+
+//============================================================================
+//
+// FACSJit :: DecodeVarOp
+//
+// Script, map, world and global variable access. Out of range indices are
+// left to the interpreter, which reports them.
+//
+//============================================================================
+
+#define ACSJIT_VAROP(name, vop, binop) \
+	{ PCD_##name##SCRIPTVAR, FACSJit::VAR_Script, vop, binop }, \
+	{ PCD_##name##MAPVAR, FACSJit::VAR_Map, vop, binop }, \
+	{ PCD_##name##WORLDVAR, FACSJit::VAR_World, vop, binop }, \
+	{ PCD_##name##GLOBALVAR, FACSJit::VAR_Global, vop, binop },
+
+static const struct
+{
+	int PCode;
+	int Class;
+	int Op;
+	int BinaryOp;
+} ACSJitVarOps[] =
+{
+	ACSJIT_VAROP(PUSH, FACSJit::VOP_Push, 0)
+	ACSJIT_VAROP(ASSIGN, FACSJit::VOP_Assign, 0)
+	ACSJIT_VAROP(INC, FACSJit::VOP_Inc, 0)
+	ACSJIT_VAROP(DEC, FACSJit::VOP_Dec, 0)
+	ACSJIT_VAROP(ADD, FACSJit::VOP_Binary, PCD_ADD)
+	ACSJIT_VAROP(SUB, FACSJit::VOP_Binary, PCD_SUBTRACT)
+	ACSJIT_VAROP(MUL, FACSJit::VOP_Binary, PCD_MULTIPLY)
+	ACSJIT_VAROP(DIV, FACSJit::VOP_Binary, PCD_DIVIDE)
+	ACSJIT_VAROP(MOD, FACSJit::VOP_Binary, PCD_MODULUS)
+	ACSJIT_VAROP(AND, FACSJit::VOP_Binary, PCD_ANDBITWISE)
+	ACSJIT_VAROP(EOR, FACSJit::VOP_Binary, PCD_EORBITWISE)
+	ACSJIT_VAROP(OR, FACSJit::VOP_Binary, PCD_ORBITWISE)
+	ACSJIT_VAROP(LS, FACSJit::VOP_Binary, PCD_LSHIFT)
+	ACSJIT_VAROP(RS, FACSJit::VOP_Binary, PCD_RSHIFT)
+};
+
+#undef ACSJIT_VAROP
+
+bool FACSJit::DecodeVarOp(int pcd, int *&pc, FACSJitOp &op)
+{
+	const ACSFormat fmt = Fmt;
+
+	for (auto &varop : ACSJitVarOps)
+	{
+		if (varop.PCode != pcd)
+		{
+			continue;
+		}
+
+		const unsigned index = NEXTBYTE;
+		const unsigned limits[] = { (unsigned)NumLocals, NUM_MAPVARS, NUM_WORLDVARS, NUM_GLOBALVARS };
+		if (index >= limits[varop.Class])
+		{
+			return false;
+		}
+		op.Arg[0] = varop.Class;
+		op.Arg[1] = index;
+		op.Arg[2] = varop.Op;
+		op.Arg[3] = varop.BinaryOp;
+		op.Pop = varop.Op == VOP_Assign || varop.Op == VOP_Binary;
+		op.Push = varop.Op == VOP_Push;
+		return true;
+	}
+	return false;
+}
+
+//============================================================================
+//
+// FACSJit :: Compile
+//
+//============================================================================
+
+VMScriptFunction *FACSJit::Compile(uint32_t entry)
+{
+	// Find every p-code reachable from the entry point along with the stack
+	// depth it runs at. Whatever cannot be translated becomes an exit to the
+	// interpreter.
+	struct Pending
+	{
+		uint32_t Ofs;
+		int Depth;
+	};
+	TArray<Pending> pending;
+	Pending cur;
+
+	pending.Push({ entry, 0 });
+	while (pending.Pop(cur))
+	{
+		if (unsigned *index = OpIndex.CheckKey(cur.Ofs))
+		{
+			if (Ops[*index].Depth != cur.Depth)
+			{
+				return nullptr;
+			}
+			continue;
+		}
+
+		FACSJitOp op;
+		op.Ofs = cur.Ofs;
+		op.Depth = cur.Depth;
+		op.Leader = false;
+		op.Supported = Ops.Size() < ACSJIT_MaxOps && Decode(cur.Ofs, op) &&
+			op.Pop <= cur.Depth && cur.Depth - op.Pop + op.Push <= ACSJIT_MaxStack;
+		if (!op.Supported)
+		{
+			op.FallsThrough = false;
+			op.Targets.Clear();
+		}
+		OpIndex[cur.Ofs] = Ops.Push(op);
+		if (!op.Supported)
+		{
+			continue;
+		}
+
+		const int after = cur.Depth - op.Pop + op.Push;
+		MaxDepth = max(MaxDepth, max(cur.Depth, after));
+		if (op.FallsThrough)
+		{
+			pending.Push({ op.Next, after });
+		}
+		for (auto target : op.Targets)
+		{
+			pending.Push({ target, after - op.BranchPop });
+		}
+	}
+
+	if (!Ops[0].Supported)
+	{
+		return nullptr;
+	}
+
+	// Lay the code out in module order. Runaway checks are done once per
+	// block, so find where the blocks start.
+	TArray<unsigned> order;
+	for (unsigned i = 0; i < Ops.Size(); i++)
+	{
+		order.Push(i);
+	}
+	std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) { return Ops[a].Ofs < Ops[b].Ofs; });
+
+	Ops[0].Leader = true;
+	for (auto &op : Ops)
+	{
+		for (auto target : op.Targets)
+		{
+			Ops[*OpIndex.CheckKey(target)].Leader = true;
+		}
+		if (op.Targets.Size() > 0 && op.FallsThrough)
+		{
+			Ops[*OpIndex.CheckKey(op.Next)].Leader = true;
+		}
+	}
+	for (unsigned i = 0; i < order.Size(); i++)
+	{
+		auto &prev = Ops[order[max(i, 1u) - 1]];
+		if (i == 0 || !prev.Supported || !prev.FallsThrough || prev.Next != Ops[order[i]].Ofs)
+		{
+			Ops[order[i]].Leader = true;
+		}
+	}
+
+	Ctx = Build.Registers[REGT_POINTER].Get(1);
+	LocalsReg = Build.Registers[REGT_POINTER].Get(1);
+	MapVarsReg = Build.Registers[REGT_POINTER].Get(1);
+	StackReg = Build.Registers[REGT_POINTER].Get(1);
+	SPReg = Build.Registers[REGT_POINTER].Get(1);
+	AddrReg = Build.Registers[REGT_POINTER].Get(1);
+	Runaway = Build.Registers[REGT_INT].Get(1);
+	Temp = Build.Registers[REGT_INT].Get(1);
+	StackBase = Build.Registers[REGT_INT].Get(max(MaxDepth, 1));
+
+	Build.Emit(OP_LP, LocalsReg, Ctx, K(offsetof(FACSJitContext, Locals)));
+	Build.Emit(OP_LP, MapVarsReg, Ctx, K(offsetof(FACSJitContext, MapVars)));
+	Build.Emit(OP_LP, StackReg, Ctx, K(offsetof(FACSJitContext, Stack)));
+	Build.Emit(OP_LP, SPReg, Ctx, K(offsetof(FACSJitContext, SP)));
+	Build.Emit(OP_LW, Runaway, Ctx, K(offsetof(FACSJitContext, Runaway)));
+	if (order[0] != 0)
+	{
+		Fixups.Push({ Build.Emit(OP_JMP, 0), entry });
+	}
+
+	for (unsigned i = 0; i < order.Size(); i++)
+	{
+		const FACSJitOp &op = Ops[order[i]];
+
+		Labels[op.Ofs] = Build.GetAddress();
+		if (op.Leader)
+		{
+			BlockCount = CountBlock(order, i);
+			Executed = 0;
+			if (BlockCount > 0)
+			{
+				// Leave it to the interpreter to stop a runaway script at the exact same p-code.
+				Build.Emit(OP_LE_RK, 0, Runaway, K(RUNAWAY_LIMIT - BlockCount));
+				Exits.Push({ Build.Emit(OP_JMP, 0), op.Ofs, op.Depth, 0, 0 });
+				EmitAddRunaway(BlockCount);
+			}
+		}
+		if (!op.Supported)
+		{
+			EmitExit(op.Ofs, op.Depth, Executed - BlockCount, 0);
+			continue;
+		}
+
+		// A comparison followed by a conditional jump becomes a single VM compare.
+		const FACSJitOp *last = &op;
+		const FACSJitOp *branch = nullptr;
+		Executed++;
+		if (op.PCode >= PCD_EQ && op.PCode <= PCD_GE && i + 1 < order.Size())
+		{
+			const FACSJitOp &next = Ops[order[i + 1]];
+			if (!next.Leader && next.Supported && next.Ofs == op.Next &&
+				(next.PCode == PCD_IFGOTO || next.PCode == PCD_IFNOTGOTO))
+			{
+				branch = last = &next;
+				Executed++;
+				i++;
+			}
+		}
+		EmitOp(op, branch);
+
+		if (last->FallsThrough && (i + 1 >= order.Size() || Ops[order[i + 1]].Ofs != last->Next))
+		{
+			Fixups.Push({ Build.Emit(OP_JMP, 0), last->Next });
+		}
+	}
+
+	for (auto &exit : Exits)
+	{
+		Build.BackpatchToHere(exit.Jump);
+		EmitExit(exit.Resume, exit.Depth, exit.Adjust, exit.State);
+	}
+	for (auto &fixup : Fixups)
+	{
+		Build.Backpatch(fixup.Jump, *Labels.CheckKey(fixup.Target));
+	}
+
+	static const uint8_t argtypes[] = { REGT_POINTER };
+	FString name;
+	name.Format("ACS %s:%u", Module->GetModuleName(), entry);
+
+	auto func = new VMScriptFunction;
+	func->QualifiedName = func->PrintableName = ClassDataAllocator.Strdup(name.GetChars());
+	Build.MakeFunction(func);
+
+	TArray<PType *> rets, args;
+	rets.Push(TypeSInt32);
+	args.Push(TypeVoidPtr);
+	func->Proto = NewPrototype(rets, args);
+	func->ArgFlags.Push(0);
+	func->NumArgs = 1;
+	func->RegTypes = argtypes;
+	return func;
+}
+
+//============================================================================
+//
+// FACSJit :: CountBlock
+//
+// Returns the number of p-codes executed when running the block that
+// starts at order[i] to its end.
+//
+//============================================================================
+
+int FACSJit::CountBlock(const TArray<unsigned> &order, unsigned i)
+{
+	int count = 0;
+	for (unsigned j = i; j < order.Size(); j++)
+	{
+		const FACSJitOp &op = Ops[order[j]];
+		if ((j > i && op.Leader) || !op.Supported)
+		{
+			break;
+		}
+		count++;
+		if (!op.FallsThrough)
+		{
+			break;
+		}
+	}
+	return count;
+}
+
+//============================================================================
+//
+// FACSJit :: EmitOp
+//
+// Stack slot n lives in register S(n). branch is the IFGOTO or IFNOTGOTO
+// fused with a comparison.
+//
+//============================================================================
+
+void FACSJit::EmitOp(const FACSJitOp &op, const FACSJitOp *branch)
+{
+	const int d = op.Depth;
+	const int after = d - op.Pop + op.Push;
+
+	switch (op.PCode)
+	{
+	case PCD_NOP:
+	case PCD_DROP:
+		break;
+
+	case PCD_TERMINATE:
+		EmitExit(op.Next, d, Executed - BlockCount, DLevelScript::SCRIPT_PleaseRemove);
+		break;
+
+	case PCD_PUSHNUMBER:
+	case PCD_PUSHBYTE:
+	case PCD_PUSH2BYTES:
+	case PCD_PUSH3BYTES:
+	case PCD_PUSH4BYTES:
+	case PCD_PUSH5BYTES:
+	case PCD_PUSHBYTES:
+		for (unsigned i = 0; i < op.Values.Size(); i++)
+		{
+			Build.EmitLoadInt(S(d + i), op.Values[i]);
+		}
+		break;
+
+	case PCD_DUP:
+		Build.Emit(OP_MOVE, S(d), S(d - 1));
+		break;
+
+	case PCD_SWAP:
+		Build.Emit(OP_MOVE, Temp, S(d - 2));
+		Build.Emit(OP_MOVE, S(d - 2), S(d - 1));
+		Build.Emit(OP_MOVE, S(d - 1), Temp);
+		break;
+
+	case PCD_LSPEC1:
+	case PCD_LSPEC2:
+	case PCD_LSPEC3:
+	case PCD_LSPEC4:
+	case PCD_LSPEC5:
+	case PCD_LSPEC5RESULT:
+	case PCD_LSPEC5EX:
+	case PCD_LSPEC5EXRESULT:
+	case PCD_LSPEC1DIRECT:
+	case PCD_LSPEC2DIRECT:
+	case PCD_LSPEC3DIRECT:
+	case PCD_LSPEC4DIRECT:
+	case PCD_LSPEC5DIRECT:
+	case PCD_LSPEC1DIRECTB:
+	case PCD_LSPEC2DIRECTB:
+	case PCD_LSPEC3DIRECTB:
+	case PCD_LSPEC4DIRECTB:
+	case PCD_LSPEC5DIRECTB:
+		EmitSpill(d);
+		Build.Emit(OP_PARAM, REGT_POINTER, Ctx);
+		Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(op.Arg[0]));
+		for (int i = 0; i < 5; i++)
+		{
+			if (i < op.Pop) Build.Emit(OP_PARAM, REGT_INT, S(d - op.Pop + i));
+			else if (i < (int)op.Values.Size()) Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(op.Values[i]));
+			else Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(0));
+		}
+		EmitCall(HELPER_LSpec, 7, op.Push ? S(d - op.Pop) : Temp);
+		Build.Emit(OP_LW, Temp, Ctx, K(offsetof(FACSJitContext, Running)));
+		Build.Emit(OP_EQ_K, 1, Temp, K(0));
+		AddExit(Build.Emit(OP_JMP, 0), op.Next, after);
+		break;
+
+	case PCD_CALLFUNC:
+		EmitSpill(d);
+		Build.Emit(OP_PARAM, REGT_POINTER, Ctx);
+		Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(op.Arg[0]));
+		Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(op.Arg[1]));
+		EmitCall(HELPER_CallFunc, 3, S(d - op.Pop));
+		Build.Emit(OP_LW, Temp, Ctx, K(offsetof(FACSJitContext, Running)));
+		Build.Emit(OP_EQ_K, 1, Temp, K(0));
+		AddExit(Build.Emit(OP_JMP, 0), op.Next, after);
+		break;
+
+	case PCD_DIVIDE:
+	case PCD_MODULUS:
+		Build.Emit(OP_EQ_K, 1, S(d - 1), K(0));
+		AddExit(Build.Emit(OP_JMP, 0), op.Next, d,
+			op.PCode == PCD_DIVIDE ? DLevelScript::SCRIPT_DivideBy0 : DLevelScript::SCRIPT_ModulusBy0);
+		EmitBinary(op.PCode, S(d - 2), S(d - 2), S(d - 1));
+		break;
+
+	case PCD_ADD:
+	case PCD_SUBTRACT:
+	case PCD_MULTIPLY:
+	case PCD_ANDBITWISE:
+	case PCD_ORBITWISE:
+	case PCD_EORBITWISE:
+	case PCD_LSHIFT:
+	case PCD_RSHIFT:
+		EmitBinary(op.PCode, S(d - 2), S(d - 2), S(d - 1));
+		break;
+
+	case PCD_EQ:
+	case PCD_NE:
+	case PCD_LT:
+	case PCD_GT:
+	case PCD_LE:
+	case PCD_GE:
+		if (branch != nullptr)
+		{
+			Fixups.Push({ EmitCompare(op.PCode, S(d - 2), S(d - 1), branch->PCode == PCD_IFGOTO), branch->Targets[0] });
+		}
+		else
+		{
+			Build.Emit(OP_LI, Temp, 1);
+			size_t jump = EmitCompare(op.PCode, S(d - 2), S(d - 1), true);
+			Build.Emit(OP_LI, Temp, 0);
+			Build.BackpatchToHere(jump);
+			Build.Emit(OP_MOVE, S(d - 2), Temp);
+		}
+		break;
+
+	case PCD_ANDLOGICAL:
+	case PCD_ORLOGICAL:
+	{
+		// Both operands have already been evaluated, so there is no short circuit to take care of.
+		const bool isand = op.PCode == PCD_ANDLOGICAL;
+		Build.Emit(OP_LI, Temp, !isand);
+		size_t jump1 = EmitTest(S(d - 2), !isand);
+		size_t jump2 = EmitTest(S(d - 1), !isand);
+		Build.Emit(OP_LI, Temp, isand);
+		Build.BackpatchToHere(jump1);
+		Build.BackpatchToHere(jump2);
+		Build.Emit(OP_MOVE, S(d - 2), Temp);
+		break;
+	}
+
+	case PCD_NEGATELOGICAL:
+	{
+		Build.Emit(OP_LI, Temp, 0);
+		size_t jump = EmitTest(S(d - 1), true);
+		Build.Emit(OP_LI, Temp, 1);
+		Build.BackpatchToHere(jump);
+		Build.Emit(OP_MOVE, S(d - 1), Temp);
+		break;
+	}
+
+	case PCD_NEGATEBINARY:
+		Build.Emit(OP_NOT, S(d - 1), S(d - 1));
+		break;
+
+	case PCD_UNARYMINUS:
+		Build.Emit(OP_NEG, S(d - 1), S(d - 1));
+		break;
+
+	case PCD_GOTO:
+		Fixups.Push({ Build.Emit(OP_JMP, 0), op.Targets[0] });
+		break;
+
+	case PCD_IFGOTO:
+	case PCD_IFNOTGOTO:
+		Fixups.Push({ EmitTest(S(d - 1), op.PCode == PCD_IFGOTO), op.Targets[0] });
+		break;
+
+	case PCD_CASEGOTO:
+	case PCD_CASEGOTOSORTED:
+		for (unsigned i = 0; i < op.Targets.Size(); i++)
+		{
+			Build.Emit(OP_EQ_K, 1, S(d - 1), K(op.Values[i]));
+			Fixups.Push({ Build.Emit(OP_JMP, 0), op.Targets[i] });
+		}
+		break;
+
+	case PCD_DELAY:
+	case PCD_DELAYDIRECT:
+	case PCD_DELAYDIRECTB:
+		Build.Emit(OP_PARAM, REGT_POINTER, Ctx);
+		if (op.Pop) Build.Emit(OP_PARAM, REGT_INT, S(d - 1));
+		else Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(op.Values[0]));
+		EmitCall(HELPER_Delay, 2, Temp);
+		Build.Emit(OP_EQ_K, 1, Temp, K(0));
+		AddExit(Build.Emit(OP_JMP, 0), op.Next, after);
+		break;
+
+	case PCD_RANDOM:
+	case PCD_RANDOMDIRECT:
+	case PCD_RANDOMDIRECTB:
+		Build.Emit(OP_PARAM, REGT_POINTER, Ctx);
+		for (int i = 0; i < 2; i++)
+		{
+			if (op.Pop) Build.Emit(OP_PARAM, REGT_INT, S(d - 2 + i));
+			else Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(op.Values[i]));
+		}
+		EmitCall(HELPER_Random, 3, S(after - 1));
+		break;
+
+	default:
+	{
+		// Variable access
+		const int vop = op.Arg[2], binop = op.Arg[3];
+		int areg, ofs;
+
+		if (binop == PCD_DIVIDE || binop == PCD_MODULUS)
+		{
+			Build.Emit(OP_EQ_K, 1, S(d - 1), K(0));
+			AddExit(Build.Emit(OP_JMP, 0), op.Next, d,
+				binop == PCD_DIVIDE ? DLevelScript::SCRIPT_DivideBy0 : DLevelScript::SCRIPT_ModulusBy0);
+		}
+		EmitVarAddress(op.Arg[0], op.Arg[1], areg, ofs);
+		switch (vop)
+		{
+		case VOP_Push:
+			Build.Emit(OP_LW, S(d), areg, K(ofs));
+			break;
+
+		case VOP_Assign:
+			Build.Emit(OP_SW, areg, S(d - 1), K(ofs));
+			break;
+
+		case VOP_Inc:
+		case VOP_Dec:
+			Build.Emit(OP_LW, Temp, areg, K(ofs));
+			Build.Emit(OP_ADDI, Temp, Temp, uint8_t(vop == VOP_Inc ? 1 : -1));
+			Build.Emit(OP_SW, areg, Temp, K(ofs));
+			break;
+
+		default:
+			Build.Emit(OP_LW, Temp, areg, K(ofs));
+			EmitBinary(binop, Temp, Temp, S(d - 1));
+			Build.Emit(OP_SW, areg, Temp, K(ofs));
+			break;
+		}
+		break;
+	}
+	}
+}
+
+void FACSJit::EmitBinary(int pcd, int dest, int a, int b)
+{
+	int opcode;
+	switch (pcd)
+	{
+	default:
+	case PCD_ADD:			opcode = OP_ADD_RR; break;
+	case PCD_SUBTRACT:		opcode = OP_SUB_RR; break;
+	case PCD_MULTIPLY:		opcode = OP_MUL_RR; break;
+	case PCD_DIVIDE:		opcode = OP_DIV_RR; break;
+	case PCD_MODULUS:		opcode = OP_MOD_RR; break;
+	case PCD_ANDBITWISE:	opcode = OP_AND_RR; break;
+	case PCD_ORBITWISE:		opcode = OP_OR_RR; break;
+	case PCD_EORBITWISE:	opcode = OP_XOR_RR; break;
+	case PCD_LSHIFT:		opcode = OP_SLL_RR; break;
+	case PCD_RSHIFT:		opcode = OP_SRA_RR; break;
+	}
+	Build.Emit(opcode, dest, a, b);
+}
+
+// Emits a jump to be patched that is taken if 'a <pcd> b' equals when.
+size_t FACSJit::EmitCompare(int pcd, int a, int b, bool when)
+{
+	switch (pcd)
+	{
+	default:
+	case PCD_EQ:	Build.Emit(OP_EQ_R, when, a, b); break;
+	case PCD_NE:	Build.Emit(OP_EQ_R, !when, a, b); break;
+	case PCD_LT:	Build.Emit(OP_LT_RR, when, a, b); break;
+	case PCD_GT:	Build.Emit(OP_LT_RR, when, b, a); break;
+	case PCD_LE:	Build.Emit(OP_LE_RR, when, a, b); break;
+	case PCD_GE:	Build.Emit(OP_LE_RR, when, b, a); break;
+	}
+	return Build.Emit(OP_JMP, 0);
+}
+
+// Emits a jump to be patched that is taken if (reg != 0) equals nonzero.
+size_t FACSJit::EmitTest(int reg, bool nonzero)
+{
+	Build.Emit(OP_EQ_K, !nonzero, reg, K(0));
+	return Build.Emit(OP_JMP, 0);
+}
+
+void FACSJit::EmitVarAddress(int varclass, int index, int &areg, int &ofs)
+{
+	switch (varclass)
+	{
+	default:
+	case VAR_Script:
+		areg = LocalsReg;
+		ofs = index * sizeof(int32_t);
+		return;
+
+	case VAR_Map:
+		Build.Emit(OP_LP, AddrReg, MapVarsReg, K(index * sizeof(int32_t *)));
+		break;
+
+	case VAR_World:
+		Build.Emit(OP_LKP, AddrReg, Build.GetConstantAddress(&ACS_WorldVars[index]));
+		break;
+
+	case VAR_Global:
+		Build.Emit(OP_LKP, AddrReg, Build.GetConstantAddress(&ACS_GlobalVars[index]));
+		break;
+	}
+	areg = AddrReg;
+	ofs = 0;
+}
+
+void FACSJit::EmitCall(int helper, int numparams, int result)
+{
+	Build.Emit(OP_CALL_K, Build.GetConstantAddress(Helpers[helper]), numparams, 1);
+	Build.Emit(OP_RESULT, 0, REGT_INT, result);
+}
+
+// Writes the stack back so that the helpers and the string garbage collector can see it.
+void FACSJit::EmitSpill(int depth)
+{
+	for (int i = 0; i < depth; i++)
+	{
+		Build.Emit(OP_SW, StackReg, S(i), K(i * sizeof(int32_t)));
+	}
+	Build.EmitLoadInt(Temp, depth);
+	Build.Emit(OP_SW, SPReg, Temp, K(0));
+}
+
+void FACSJit::EmitAddRunaway(int count)
+{
+	if (count >= -128 && count <= 127)
+	{
+		Build.Emit(OP_ADDI, Runaway, Runaway, uint8_t(count));
+	}
+	else
+	{
+		Build.Emit(OP_ADD_RK, Runaway, Runaway, K(count));
+	}
+}
+
+// Hands the script back to RunScript at resume with depth values on the stack.
+// adjust corrects the runaway count for the part of the block not executed.
+void FACSJit::EmitExit(uint32_t resume, int depth, int adjust, int state)
+{
+	if (state != DLevelScript::SCRIPT_Running)
+	{
+		Build.Emit(OP_PARAM, REGT_POINTER, Ctx);
+		Build.Emit(OP_PARAM, REGT_INT | REGT_KONST, K(state));
+		EmitCall(HELPER_SetState, 2, Temp);
+	}
+	EmitSpill(depth);
+	if (adjust != 0)
+	{
+		EmitAddRunaway(adjust);
+	}
+	Build.Emit(OP_SW, Ctx, Runaway, K(offsetof(FACSJitContext, Runaway)));
+	Build.EmitRetInt(0, true, resume);
+}
+
+void FACSJit::AddExit(size_t jump, uint32_t resume, int depth, int state)
+{
+	Exits.Push({ jump, resume, depth, Executed - BlockCount, state });
+}
+
+int DLevelScript::RunScript()
+{
+	// Most scripts are just waiting at any given time. Don't set up
+	// the interpreter for those if they aren't going to run this tic.
+	if (state == SCRIPT_Suspended)
+	{
+		return 1;
+	}
+	if (state == SCRIPT_Delayed && statedata > 1)
+	{
+		statedata--;
+		return 1;
+	}
+
+	DACSThinker *controller = Level->ACSThinker;
+	ACSLocalVariables locals(Localvars);
+	ACSLocalArrays noarrays;
+	ACSLocalArrays *localarrays = &noarrays;
+	ScriptFunction *activeFunction = NULL;
+	FRemapTable *translation = 0;
+	int resultValue = 1;
+	int transi = -1;
+
+	if (InModuleScriptNumber >= 0)
+	{
+		ScriptPtr *ptr = activeBehavior->GetScriptPtr(InModuleScriptNumber);
+		assert(ptr != NULL);
+		if (ptr != NULL)
+		{
+			localarrays = &ptr->LocalArrays;
+		}
+	}
+
+	// Hexen truncates all special arguments to bytes (only when using an old MAPINFO and old ACS format
+	const int specialargmask = ((Level->flags2 & LEVEL2_HEXENHACK) && activeBehavior->GetFormat() == ACS_Old) ? 255 : ~0;
+
+	switch (state)
+	{
+	case SCRIPT_Delayed:
+		// Decrement the delay counter and enter state running
+		// if it hits 0
+		if (--statedata == 0)
+			state = SCRIPT_Running;
+		break;
+
+	case SCRIPT_TagWait:
+		// Wait for tagged sector(s) to go inactive, then enter
+		// state running
+	{
+		int secnum;
+		auto it = Level->GetSectorTagIterator(statedata);
+		while ((secnum = it.Next()) >= 0)
+		{
+			if (Level->sectors[secnum].floordata || Level->sectors[secnum].ceilingdata)
+				return resultValue;
+		}
+
+		// If we got here, none of the tagged sectors were busy
+		state = SCRIPT_Running;
+	}
+	break;
+
+	case SCRIPT_PolyWait:
+		// Wait for polyobj(s) to stop moving, then enter state running
+		if (!PO_Busy (Level, statedata))
+		{
+			state = SCRIPT_Running;
+		}
+		break;
+
+	case SCRIPT_ScriptWaitPre:
+		// Wait for a script to start running, then enter state scriptwait
+		if (controller->RunningScripts.CheckKey(statedata) != NULL)
+			state = SCRIPT_ScriptWait;
+		break;
+
+	case SCRIPT_ScriptWait:
+		// Wait for a script to stop running, then enter state running
+		if (controller->RunningScripts.CheckKey(statedata) != NULL)
+			return resultValue;
+
+		state = SCRIPT_Running;
+		PutFirst ();
+		break;
+
+	default:
+		break;
+	}
+
+	FACSStack stackobj;
+	FACSStackMemory& Stack = stackobj.buffer;
+	int &sp = stackobj.sp;
+
+	int *pc = this->pc;
+	ACSFormat fmt = activeBehavior->GetFormat();
+	FBehavior* const savedActiveBehavior = activeBehavior;
+	unsigned int runaway = 0;	// used to prevent infinite loops
+	int pcd;
+	FString work;
+	const char *lookup;
+	int optstart = -1;
+	int temp;
+
+	if (acs_jit && state == SCRIPT_Running)
+	{
+		VMFunction *func = FACSJit::GetFunction(activeBehavior, activeBehavior->PC2Ofs(pc), Localvars.Size());
+		if (func != nullptr)
+		{
+			FACSJitContext ctx = { this, Localvars.Data(), activeBehavior->MapVars.Pointer(), Stack.Pointer(), &sp, 0, specialargmask, 1 };
+			int resume;
+			VMValue param(&ctx);
+			VMReturn ret(&resume);
+			VMCall(func, &param, 1, &ret, 1);
+			pc = activeBehavior->Ofs2PC(resume);
+			runaway = ctx.Runaway;
+		}
+	}
 
 	while (state == SCRIPT_Running)
 	{
-		if (++runaway > 2000000)
+		if (++runaway > RUNAWAY_LIMIT)
 		{
 			Printf ("Runaway %s terminated\n", ScriptPresentation(script).GetChars());
 			state = SCRIPT_PleaseRemove;
@@ -375,6 +375,9 @@ public:
 	ScriptPtr *GetScriptPtr(int index) const { return index >= 0 && index < NumScripts ? &Scripts[index] : NULL; }
 	int GetLumpNum() const { return LumpNum; }
 	int GetDataSize() const { return DataSize; }
+	uint32_t GetChecksum();
+	int GetJitImage() const { return JitImage; }
+	void SetJitImage(int image) { JitImage = image; }
 	const char *GetModuleName() const { return ModuleName; }
 	ACSProfileInfo *GetFunctionProfileData(int index) { return index >= 0 && index < NumFunctions ? &FunctionProfileData[index] : NULL; }
 	ACSProfileInfo *GetFunctionProfileData(ScriptFunction *func) { return GetFunctionProfileData((int)(func - (ScriptFunction *)Functions)); }
@@ -404,6 +407,9 @@ private:
 	int NumTotalArrays;
 	uint32_t StringTable;
 	uint32_t LibraryID;
+	uint32_t Checksum;
+	bool ChecksumValid;
+	int JitImage;
 	bool ShouldLocalize;
 
 	int32_t MapVarStore[NUM_MAPVARS];
@@ -106,6 +106,20 @@ static const struct ColorList {
 	{NULL, 0, 0, 0 }
 };
 
+static int MakeParticleBatchID(unsigned index, uint16_t generation)
+{
+	return (generation << 16) | (index + 1);
+}
+
+inline void RemoveFromBatch(FLevelLocals *Level, particle_t *particle)
+{
+	if (particle->batch != 0)
+	{
+		auto &batch = Level->ParticleBatches[particle->batch - 1];
+		if (batch.Count > 0) batch.Count--;
+	}
+}
+
 inline particle_t *NewParticle (FLevelLocals *Level, bool replace = false)
 {
 	particle_t *result = nullptr;
@@ -138,6 +152,7 @@ inline particle_t *NewParticle (FLevelLocals *Level, bool replace = false)
 				ntop->tprev = Level->ActiveParticles;
 			}
 			// [MC] Future proof this by resetting everything when replacing a particle.
+			RemoveFromBatch(Level, result);
 			auto tnext = result->tnext;
 			auto tprev = result->tprev;
 			*result = {};
@@ -196,6 +211,10 @@ void P_ClearParticles (FLevelLocals *Level)
 	Level->OldestParticle = NO_PARTICLE;
 	Level->ActiveParticles = NO_PARTICLE;
 	Level->InactiveParticles = 0;
+	for (auto &batch : Level->ParticleBatches)
+	{
+		batch.Count = 0;
+	}
 	for (auto &p : Level->Particles)
 	{
 		p = {};
@@ -310,6 +329,7 @@ void P_ThinkParticles (FLevelLocals *Level)
 		particle->size += particle->sizestep;
 		if (particle->alpha <= 0 || --particle->ttl <= 0 || (particle->size <= 0))
 		{ // The particle has expired, so free it
+			RemoveFromBatch(Level, particle);
 			*particle = {};
 			if (prev)
 				prev->tnext = i;
@@ -331,6 +351,10 @@ void P_ThinkParticles (FLevelLocals *Level)
 		particle->Pos.X = newxy.X;
 		particle->Pos.Y = newxy.Y;
 		particle->Pos.Z += particle->Vel.Z;
+		if (particle->drag != 0)
+		{
+			particle->Vel *= 1.f - particle->drag * (1.f / 65535);
+		}
 		particle->Vel += particle->Acc;
 
 		if(particle->flags & SPF_ROLL)
@@ -360,9 +384,143 @@ void P_ThinkParticles (FLevelLocals *Level)
 		}
 		prev = particle;
 	}
+
+	// Run the batch callbacks once per batch, after all its particles have been moved.
+	// Handlers may create or release batches, so nothing may be held across the call.
+	for (unsigned b = 0; b < Level->ParticleBatches.Size() && !Level->isFrozen(); b++)
+	{
+		auto &batch = Level->ParticleBatches[b];
+		if (!batch.Active) continue;
+
+		DObject *handler = batch.Handler;
+		if (handler != nullptr)
+		{
+			// The live count depends on the local particle limit, so it must not reach play code.
+			IFVIRTUALPTRNAME(handler, NAME_ParticleBatchHandler, BatchTick)
+			{
+				VMValue params[2] = { handler, MakeParticleBatchID(b, batch.Generation) };
+				VMCall(func, params, 2, nullptr, 0);
+			}
+		}
+	}
+}
+
+//==========================================================================
+//
+// Particle batches
+//
+// Batch IDs handed out to scripts hold the 1-based slot index in the low
+// 16 bits, so that 0 can mean 'no batch', and the slot's generation above
+// that, so an ID stays invalid once its batch was released. Slots are only
+// created and freed by play code and saved with the level, so the IDs never
+// depend on the local particle pool.
+//
+//==========================================================================
+
+int P_CreateParticleBatch(FLevelLocals *Level, double drag, DObject *handler)
+{
+	unsigned index;
+	for (index = 0; index < Level->ParticleBatches.Size(); index++)
+	{
+		if (!Level->ParticleBatches[index].Active) break;
+	}
+	if (index == Level->ParticleBatches.Size())
+	{
+		if (index >= MAX_PARTICLE_BATCHES) return 0;
+		Level->ParticleBatches.Push({});
+	}
+	// Kept within 1..0x7fff so that IDs are always positive.
+	Level->ParticleBatchGeneration = Level->ParticleBatchGeneration % 0x7fff + 1;
+
+	auto &batch = Level->ParticleBatches[index];
+	batch.Handler = handler;
+	batch.Drag = float(clamp(drag, 0., 1.));
+	batch.Count = 0;
+	batch.Generation = Level->ParticleBatchGeneration;
+	batch.Active = true;
+	return MakeParticleBatchID(index, batch.Generation);
 }
 
-void P_SpawnParticle(FLevelLocals *Level, const DVector3 &pos, const DVector3 &vel, const DVector3 &accel, PalEntry color, double startalpha, int lifetime, double size,
+static FParticleBatch *GetParticleBatch(FLevelLocals *Level, int batch)
+{
+	const unsigned index = (batch & 0xffff) - 1;
+	if (batch <= 0 || index >= Level->ParticleBatches.Size()) return nullptr;
+	auto b = &Level->ParticleBatches[index];
+	return b->Active && b->Generation == (batch >> 16) ? b : nullptr;
+}
+
+int P_GetParticleBatchCount(FLevelLocals *Level, int batch)
+{
+	auto b = GetParticleBatch(Level, batch);
+	return b != nullptr ? b->Count : 0;
+}
+
+void P_ReleaseParticleBatch(FLevelLocals *Level, int batch)
+{
+	auto b = GetParticleBatch(Level, batch);
+	if (b != nullptr)
+	{
+		// The slot is free right away. Live particles keep their drag but no longer count
+		// towards a batch, so that they cannot be counted for the slot's next batch.
+		const uint16_t index = uint16_t(batch & 0xffff);
+		for (uint32_t i = Level->ActiveParticles; i != NO_PARTICLE && b->Count > 0; i = Level->Particles[i].tnext)
+		{
+			auto &particle = Level->Particles[i];
+			if (particle.batch == index)
+			{
+				particle.batch = 0;
+				b->Count--;
+			}
+		}
+		b->Handler = nullptr;
+		b->Count = 0;
+		b->Active = false;
+	}
+}
+
+FSerializer &Serialize(FSerializer &arc, const char *key, FParticleBatch &batch, FParticleBatch *def)
+{
+	if (arc.BeginObject(key))
+	{
+		arc("handler", batch.Handler)
+			("drag", batch.Drag)
+			("generation", batch.Generation)
+			("active", batch.Active)
+			.EndObject();
+	}
+	return arc;
+}
+
+void P_SpawnParticleBatch(FLevelLocals *Level, const FSpawnParticleParams &params, int count, int batch, const DVector3 &posspread, const DVector3 &velspread)
+{
+	auto b = GetParticleBatch(Level, batch);
+	count = min<int>(count, Level->Particles.Size());
+
+	auto spread = [](const DVector3 &v, const DVector3 &range)
+	{
+		return DVector3(
+			v.X + range.X * (M_Random.GenRand_Real1() * 2 - 1),
+			v.Y + range.Y * (M_Random.GenRand_Real1() * 2 - 1),
+			v.Z + range.Z * (M_Random.GenRand_Real1() * 2 - 1));
+	};
+
+	for (int i = 0; i < count; i++)
+	{
+		particle_t *particle = P_SpawnParticle(Level, spread(params.pos, posspread), spread(params.vel, velspread), params.accel,
+			params.color, params.startalpha, params.lifetime, params.size, params.fadestep, params.sizestep,
+			params.flags, params.texture, ERenderStyle(params.style), params.startroll, params.rollvel, params.rollacc);
+
+		if (particle == nullptr) break;
+		if (b != nullptr)
+		{
+			particle->batch = uint16_t(batch & 0xffff);
+			particle->drag = uint16_t(xs_RoundToInt(b->Drag * 65535));
+			b->Count++;
+		}
+	}
+}
+
+particle_t *P_SpawnParticle(FLevelLocals *Level, const DVector3 &pos, const DVector3 &vel, const DVector3 &accel, PalEntry color, double startalpha, int lifetime, double size,
 	double fadestep, double sizestep, int flags, FTextureID texture, ERenderStyle style, double startroll, double rollvel, double rollacc)
 {
 	particle_t *particle = NewParticle(Level, !!(flags & SPF_REPLACE));
@@ -390,6 +548,7 @@ void P_SpawnParticle(FLevelLocals *Level, const DVector3 &pos, const DVector3 &v
 			TexAnim.InitStandaloneAnimation(particle->animData, texture, Level->maptime);
 		}
 	}
+	return particle;
 }
 
 //
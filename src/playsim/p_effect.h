@@ -50,6 +50,7 @@ enum
 
 struct subsector_t;
 struct FLevelLocals;
+class FSerializer;
 
 // [RH] Particle details
 
@@ -83,7 +84,8 @@ struct particle_t
     float Roll, RollVel, RollAcc; //+12 = 100
     uint16_t    tnext, snext, tprev; //+6 = 106
 	uint16_t flags; //+2 = 108
-	// uint32_t padding; //+4 = 112
+	uint16_t batch; //+2 = 110 - 1-based index into FLevelLocals::ParticleBatches, 0 for none
+	uint16_t drag; //+2 = 112 - velocity is scaled by (1 - drag / 65535) each tic
 	FStandaloneAnimation animData; //+16 = 128
 };
 
@@ -91,6 +93,22 @@ static_assert(sizeof(particle_t) == 128);
 
 const uint16_t NO_PARTICLE = 0xffff;
 
+// A particle batch groups particles spawned together so that the per-tic update can
+// apply shared parameters to all of them, and so that scripts get one callback per
+// batch instead of needing a thinker per effect.
+// The batch table is play state and gets saved. The particles are not, so they carry
+// their own drag and outlive the batch they were spawned into.
+struct FParticleBatch
+{
+	TObjPtr<DObject*> Handler;	// optional ParticleBatchHandler, called once per tic
+	float Drag = 0;				// velocity is scaled by (1 - Drag) each tic
+	uint32_t Count = 0;			// number of live particles in this batch, not saved
+	uint16_t Generation = 0;	// high half of the batch ID, so that stale IDs are rejected
+	bool Active = false;
+};
+
+const int MAX_PARTICLE_BATCHES = 0xfffe;
+
 void P_InitParticles(FLevelLocals *);
 void P_ClearParticles (FLevelLocals *Level);
 void P_FindParticleSubsectors (FLevelLocals *Level);
@@ -126,7 +144,13 @@ struct FSpawnParticleParams
 	double rollacc;
 };
 
-void P_SpawnParticle(FLevelLocals *Level, const DVector3 &pos, const DVector3 &vel, const DVector3 &accel, PalEntry color, double startalpha, int lifetime, double size, double fadestep, double sizestep, int flags = 0, FTextureID texture = FNullTextureID(), ERenderStyle style = STYLE_None, double startroll = 0, double rollvel = 0, double rollacc = 0);
+int P_CreateParticleBatch(FLevelLocals *Level, double drag, DObject *handler);
+void P_ReleaseParticleBatch(FLevelLocals *Level, int batch);
+void P_SpawnParticleBatch(FLevelLocals *Level, const FSpawnParticleParams &params, int count, int batch, const DVector3 &posspread, const DVector3 &velspread);
+int P_GetParticleBatchCount(FLevelLocals *Level, int batch);
+FSerializer &Serialize(FSerializer &arc, const char *key, FParticleBatch &batch, FParticleBatch *def);
+
+particle_t *P_SpawnParticle(FLevelLocals *Level, const DVector3 &pos, const DVector3 &vel, const DVector3 &accel, PalEntry color, double startalpha, int lifetime, double size, double fadestep, double sizestep, int flags = 0, FTextureID texture = FNullTextureID(), ERenderStyle style = STYLE_None, double startroll = 0, double rollvel = 0, double rollacc = 0);
 
 void P_InitEffects (void);
 
@@ -83,6 +83,7 @@ static FRandom pr_enemystrafe("EnemyStrafe");
 // so this CVAR allows to switch it off.
 CVAR(Bool, nomonsterinterpolation, false, CVAR_GLOBALCONFIG|CVAR_ARCHIVE)
 CVAR(Int, sv_dropstyle, 0, CVAR_SERVERINFO | CVAR_ARCHIVE);
+CVARD(Bool, sv_flowfieldchase, false, CVAR_SERVERINFO, "let monsters follow the level's flow fields when chasing players")
 
 //
 // P_NewChaseDir related LUT.
@@ -965,6 +966,7 @@ void DoNewChaseDir(AActor * actor, bool node)
 	{
 		delta = actor->Vec2To(actor->target);
 
+		bool fleeing = false;
 		if (!(actor->flags6 & MF6_NOFEAR))
 		{
 			if ((actor->target->player != NULL && (actor->target->player->cheats & CF_FRIGHTENING)) || 
@@ -972,6 +974,18 @@ void DoNewChaseDir(AActor * actor, bool node)
 				(actor->target->flags8 & MF8_FRIGHTENING))
 			{
 				delta = -delta;
+				fleeing = true;
+			}
+		}
+
+		// Walk around obstacles instead of trying to go straight for the player.
+		// The field only knows the way toward the player, so it is no help when running away.
+		if (!fleeing && sv_flowfieldchase && actor->target->player != nullptr && !(actor->flags & (MF_FLOAT | MF_NOCLIP)))
+		{
+			DVector2 flow;
+			if (actor->Level->flowFields.GetDirection(actor, actor->Level->PlayerNum(actor->target->player), flow))
+			{
+				delta = flow;
 			}
 		}
 	}
@@ -0,0 +1,383 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright 2026 The Redemption Team
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//		Flow fields for monster navigation.
+//
+//		The subsectors form a graph in which two of them are connected if
+//		they share a seg. For every player that is being chased, a
+//		shortest path search is run from the player's subsector outward,
+//		spread over several tics with a fixed amount of work per tic, so
+//		that the results are the same on every machine. Once a search is
+//		finished it replaces the previous field and a new one is started,
+//		which keeps the fields up to date with moving players and sectors.
+//		Monsters then only need to look up the crossing to the next
+//		subsector on the way.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include "p_flowfield.h"
+#include "g_levellocals.h"
+#include "actor.h"
+#include "d_player.h"
+#include "doomdef.h"
+#include "serializer.h"
+#include "vm.h"
+
+// Fixed values because fields are shared by all monsters. The defaults of
+// the standard monsters are used.
+static const double FlowStepHeight = 24;
+static const double FlowMinOpening = 56;
+
+static const int FlowNodesPerTic = 2048;		// subsectors to expand per field and tic
+static const int FlowKeepAlive = 5 * TICRATE;	// how long fields get updated after the last query
+
+//==========================================================================
+//
+// FFlowFields :: Build
+//
+//==========================================================================
+
+void FFlowFields::Build(FLevelLocals *Level)
+{
+	Clear();
+	this->Level = Level;
+
+	unsigned numsubsectors = Level->subsectors.Size();
+	TArray<int> segedge(Level->segs.Size(), true);
+
+	Centers.Resize(numsubsectors);
+	EdgeStart.Resize(numsubsectors + 1);
+	for (unsigned i = 0; i < numsubsectors; i++)
+	{
+		auto &sub = Level->subsectors[i];
+		DVector2 center(0, 0);
+
+		EdgeStart[i] = Edges.Size();
+		for (unsigned j = 0; j < sub.numlines; j++)
+		{
+			seg_t *seg = &sub.firstline[j];
+			center += seg->v1->fPos();
+
+			segedge[seg->Index()] = -1;
+			if (seg->PartnerSeg == nullptr || seg->PartnerSeg->Subsector == nullptr) continue;
+			if (seg->linedef != nullptr && seg->linedef->backsector == nullptr) continue;
+
+			segedge[seg->Index()] = Edges.Size();
+			Edge &edge = Edges[Edges.Reserve(1)];
+			edge.Seg = seg;
+			edge.To = seg->PartnerSeg->Subsector->Index();
+			edge.Reverse = -1;
+			edge.Portal = (seg->v1->fPos() + seg->v2->fPos()) / 2;
+		}
+		Centers[i] = sub.numlines > 0 ? center / sub.numlines : center;
+	}
+	EdgeStart[numsubsectors] = Edges.Size();
+
+	for (auto &edge : Edges)
+	{
+		edge.Reverse = segedge[edge.Seg->PartnerSeg->Index()];
+		edge.Cost = float((edge.Portal - Centers[edge.Seg->Subsector->Index()]).Length() + (Centers[edge.To] - edge.Portal).Length());
+	}
+
+	Fields.Resize(MAXPLAYERS);
+}
+
+//==========================================================================
+//
+// FFlowFields :: Clear
+//
+//==========================================================================
+
+void FFlowFields::Clear()
+{
+	Level = nullptr;
+	EdgeStart.Reset();
+	Edges.Reset();
+	Centers.Reset();
+	Fields.Reset();
+}
+
+//==========================================================================
+//
+// FFlowFields :: CanEnter
+//
+// Checks if a monster can walk across the edge's seg. Only the current
+// sector heights are looked at, so that doors and lifts are taken into
+// account once the next field has been calculated.
+//
+//==========================================================================
+
+bool FFlowFields::CanEnter(const Edge &edge) const
+{
+	line_t *line = edge.Seg->linedef;
+	if (line != nullptr && (line->flags & (ML_BLOCKING | ML_BLOCKMONSTERS | ML_BLOCKEVERYTHING)))
+	{
+		return false;
+	}
+
+	sector_t *from = edge.Seg->Subsector->sector;
+	sector_t *to = Level->subsectors[edge.To].sector;
+	if (from == to) return true;
+
+	double fromfloor = from->floorplane.ZatPoint(edge.Portal);
+	double tofloor = to->floorplane.ZatPoint(edge.Portal);
+	if (tofloor - fromfloor > FlowStepHeight) return false;
+
+	double ceiling = min(from->ceilingplane.ZatPoint(edge.Portal), to->ceilingplane.ZatPoint(edge.Portal));
+	return ceiling - max(fromfloor, tofloor) >= FlowMinOpening;
+}
+
+//==========================================================================
+//
+// FFlowFields :: heap
+//
+// A min heap, ordered by distance and then subsector index, so that the
+// search order never depends on anything but the map.
+//
+//==========================================================================
+
+void FFlowFields::HeapPush(TArray<HeapEntry> &heap, const HeapEntry &entry)
+{
+	heap.Push(entry);
+	std::push_heap(heap.begin(), heap.end(), [](const HeapEntry &a, const HeapEntry &b) { return b < a; });
+}
+
+FFlowFields::HeapEntry FFlowFields::HeapPop(TArray<HeapEntry> &heap)
+{
+	std::pop_heap(heap.begin(), heap.end(), [](const HeapEntry &a, const HeapEntry &b) { return b < a; });
+	HeapEntry entry;
+	heap.Pop(entry);
+	return entry;
+}
+
+//==========================================================================
+//
+// FFlowFields :: StartField
+//
+//==========================================================================
+
+void FFlowFields::StartField(Field &field, int source)
+{
+	unsigned numsubsectors = Level->subsectors.Size();
+
+	field.WorkNext.Resize(numsubsectors);
+	field.WorkDist.Resize(numsubsectors);
+	for (unsigned i = 0; i < numsubsectors; i++)
+	{
+		field.WorkNext[i] = -1;
+		field.WorkDist[i] = FLT_MAX;
+	}
+	field.Heap.Clear();
+	field.WorkDist[source] = 0;
+	HeapPush(field.Heap, { 0, source });
+	field.Running = true;
+}
+
+//==========================================================================
+//
+// FFlowFields :: RunField
+//
+// Continues the search. The edges are followed backwards, because the
+// field needs to tell where to go from each subsector, not where to come
+// from.
+//
+//==========================================================================
+
+void FFlowFields::RunField(Field &field, int budget)
+{
+	while (budget-- > 0 && field.Heap.Size() > 0)
+	{
+		HeapEntry entry = HeapPop(field.Heap);
+		if (entry.Dist > field.WorkDist[entry.Node]) continue;	// already found a shorter way
+
+		for (int i = EdgeStart[entry.Node]; i < EdgeStart[entry.Node + 1]; i++)
+		{
+			const Edge &out = Edges[i];
+			if (out.Reverse < 0 || !CanEnter(Edges[out.Reverse])) continue;
+
+			float dist = entry.Dist + out.Cost;
+			if (dist < field.WorkDist[out.To])
+			{
+				field.WorkDist[out.To] = dist;
+				field.WorkNext[out.To] = out.Reverse;
+				HeapPush(field.Heap, { dist, out.To });
+			}
+		}
+	}
+
+	if (field.Heap.Size() == 0)
+	{
+		field.Next.Swap(field.WorkNext);
+		field.Dist.Swap(field.WorkDist);
+		field.Valid = true;
+		field.Running = false;
+	}
+}
+
+//==========================================================================
+//
+// FFlowFields :: Tick
+//
+//==========================================================================
+
+void FFlowFields::Tick()
+{
+	for (unsigned i = 0; i < Fields.Size(); i++)
+	{
+		Field &field = Fields[i];
+		if (field.LastQuery < 0) continue;
+
+		AActor *mo = Level->PlayerInGame(i) ? Level->Players[i]->mo : nullptr;
+		if (mo == nullptr || mo->subsector == nullptr || Level->maptime - field.LastQuery > FlowKeepAlive)
+		{
+			// Nobody is interested in this player anymore.
+			field.Valid = field.Running = false;
+			field.LastQuery = -1;
+			continue;
+		}
+		if (!field.Running)
+		{
+			StartField(field, mo->subsector->Index());
+		}
+		RunField(field, FlowNodesPerTic);
+	}
+}
+
+//==========================================================================
+//
+// FFlowFields :: Serialize
+//
+// Fields steer monsters, so a savegame has to resume them exactly where
+// they were, including a search that is still running.
+//
+//==========================================================================
+
+FSerializer &Serialize(FSerializer &arc, const char *key, FFlowFields::HeapEntry &entry, FFlowFields::HeapEntry *def)
+{
+	if (arc.BeginObject(key))
+	{
+		arc("dist", entry.Dist)
+			("node", entry.Node)
+			.EndObject();
+	}
+	return arc;
+}
+
+FSerializer &Serialize(FSerializer &arc, const char *key, FFlowFields::Field &field, FFlowFields::Field *def)
+{
+	if (arc.BeginObject(key))
+	{
+		arc("lastquery", field.LastQuery);
+		// Fields nobody has asked for recently are not updated, so there is nothing to keep.
+		if (field.LastQuery >= 0)
+		{
+			arc("valid", field.Valid)
+				("next", field.Next)
+				("dist", field.Dist)
+				("running", field.Running)
+				("worknext", field.WorkNext)
+				("workdist", field.WorkDist)
+				("heap", field.Heap);
+		}
+		else if (arc.isReading())
+		{
+			field.Valid = field.Running = false;
+		}
+		arc.EndObject();
+	}
+	return arc;
+}
+
+void FFlowFields::Serialize(FSerializer &arc)
+{
+	arc("flowfields", Fields);
+	if (arc.isReading() && Fields.Size() != MAXPLAYERS)
+	{
+		// Savegame from before flow fields existed.
+		Fields.Reset();
+		Fields.Resize(MAXPLAYERS);
+	}
+}
+
+//==========================================================================
+//
+// FFlowFields :: GetDirection
+//
+//==========================================================================
+
+bool FFlowFields::GetDirection(AActor *mo, int playernum, DVector2 &dir, double *distance)
+{
+	if (playernum < 0 || unsigned(playernum) >= Fields.Size() || mo->subsector == nullptr)
+	{
+		return false;
+	}
+	Field &field = Fields[playernum];
+	field.LastQuery = Level->maptime;
+	if (!field.Valid) return false;
+
+	int node = mo->subsector->Index();
+	int edge = field.Next[node];
+	if (edge < 0) return false;
+
+	DVector2 pos = mo->Pos().XY();
+	DVector2 delta = Edges[edge].Portal - pos;
+	if (delta.LengthSquared() < mo->radius * mo->radius)
+	{
+		// Already at the crossing, so head for the one after it.
+		int next = field.Next[Edges[edge].To];
+		if (next >= 0) delta = Edges[next].Portal - pos;
+	}
+	if (delta.isZero()) return false;
+
+	dir = delta;
+	if (distance != nullptr) *distance = field.Dist[node];
+	return true;
+}
+
+//==========================================================================
+//
+// LevelLocals.GetFlowDirection
+//
+//==========================================================================
+
+DEFINE_ACTION_FUNCTION(FLevelLocals, GetFlowDirection)
+{
+	PARAM_SELF_STRUCT_PROLOGUE(FLevelLocals);
+	PARAM_OBJECT_NOT_NULL(mo, AActor);
+	PARAM_INT(playernum);
+
+	DVector2 dir(0, 0);
+	double distance = 0;
+	bool res = self->flowFields.GetDirection(mo, playernum, dir, &distance);
+	if (numret > 2)
+	{
+		ret[2].SetFloat(distance);
+	}
+	if (numret > 1)
+	{
+		ret[1].SetInt(res);
+	}
+	if (numret > 0)
+	{
+		ret[0].SetVector2(res ? dir.Unit() : dir);
+	}
+	return min(numret, 3);
+}
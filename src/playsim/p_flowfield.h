@@ -0,0 +1,103 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright 2026 The Redemption Team
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//		Flow fields over the subsector graph that lead monsters toward
+//		the players without probing every direction with P_TryMove.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include "tarray.h"
+#include "vectors.h"
+
+struct FLevelLocals;
+class FSerializer;
+struct seg_t;
+struct sector_t;
+class AActor;
+
+class FFlowFields
+{
+public:
+	void Build(FLevelLocals *Level);
+	void Clear();
+	void Tick();
+	void Serialize(FSerializer &arc);
+
+	// Returns the direction in which 'mo' should move to get closer to
+	// the given player. Fails if the field is not ready yet, the player
+	// cannot be reached or mo is already in the player's subsector.
+	// A query also keeps the field for this player updated for a while.
+	bool GetDirection(AActor *mo, int playernum, DVector2 &dir, double *distance = nullptr);
+
+private:
+	struct Edge
+	{
+		seg_t *Seg;			// the seg on the side this edge starts from
+		int To;				// the subsector on the other side
+		int Reverse;		// the edge going back
+		float Cost;
+		DVector2 Portal;	// where to cross
+	};
+
+	struct HeapEntry
+	{
+		float Dist;
+		int Node;
+
+		bool operator<(const HeapEntry &other) const
+		{
+			return Dist < other.Dist || (Dist == other.Dist && Node < other.Node);
+		}
+	};
+
+	struct Field
+	{
+		// the last completed field
+		TArray<int> Next;		// edge toward the player, -1 if unreachable or at the player
+		TArray<float> Dist;
+		bool Valid = false;
+
+		// the one being calculated
+		TArray<int> WorkNext;
+		TArray<float> WorkDist;
+		TArray<HeapEntry> Heap;
+		bool Running = false;
+
+		int LastQuery = -1;
+	};
+
+	friend FSerializer &Serialize(FSerializer &arc, const char *key, HeapEntry &entry, HeapEntry *def);
+	friend FSerializer &Serialize(FSerializer &arc, const char *key, Field &field, Field *def);
+
+	bool CanEnter(const Edge &edge) const;
+	void StartField(Field &field, int source);
+	void RunField(Field &field, int budget);
+	void HeapPush(TArray<HeapEntry> &heap, const HeapEntry &entry);
+	HeapEntry HeapPop(TArray<HeapEntry> &heap);
+
+	FLevelLocals *Level = nullptr;
+	TArray<int> EdgeStart;		// per subsector, into Edges, with one extra entry at the end
+	TArray<Edge> Edges;
+	TArray<DVector2> Centers;
+	TArray<Field> Fields;		// one per player
+};
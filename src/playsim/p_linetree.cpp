@@ -0,0 +1,367 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright 2026 The Redemption Team
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//		Bounding volume hierarchy over the level's lines
+//
+//		The tree only narrows down which lines a trace needs to look at.
+//		To keep results identical to a plain blockmap walk, every candidate
+//		is mapped back to the first block of the walk that lists it, and the
+//		candidates are returned in the order the walk would have found them:
+//		block by block, polyobject lines before the block's own list.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include "p_linetree.h"
+#include "g_levellocals.h"
+#include "po_man.h"
+
+// Boxes are padded generously so that the float boxes and the epsilon in
+// P_PointOnDivlineSide can never make the tree miss a line the blockmap
+// walk would report.
+static constexpr double TreePadding = 2.;
+static constexpr int MaxLeafLines = 4;
+
+//==========================================================================
+//
+// SegmentTouchesBox
+//
+//==========================================================================
+
+static inline bool SegmentTouchesBox(const DVector2 &start, const DVector2 &delta, double minx, double miny, double maxx, double maxy)
+{
+	double tmin = 0, tmax = 1;
+
+	if (delta.X == 0)
+	{
+		if (start.X < minx || start.X > maxx) return false;
+	}
+	else
+	{
+		double t1 = (minx - start.X) / delta.X;
+		double t2 = (maxx - start.X) / delta.X;
+		if (t1 > t2) std::swap(t1, t2);
+		tmin = max(tmin, t1);
+		tmax = min(tmax, t2);
+		if (tmin > tmax) return false;
+	}
+	if (delta.Y == 0)
+	{
+		if (start.Y < miny || start.Y > maxy) return false;
+	}
+	else
+	{
+		double t1 = (miny - start.Y) / delta.Y;
+		double t2 = (maxy - start.Y) / delta.Y;
+		if (t1 > t2) std::swap(t1, t2);
+		tmin = max(tmin, t1);
+		tmax = min(tmax, t2);
+		if (tmin > tmax) return false;
+	}
+	return true;
+}
+
+//==========================================================================
+//
+// FLineTree :: Clear
+//
+//==========================================================================
+
+void FLineTree::Clear()
+{
+	Level = nullptr;
+	Nodes.Reset();
+	LineOrder.Reset();
+	LineBlockStart.Reset();
+	LineBlocks.Reset();
+	BlockStamp.Reset();
+	BlockStep.Reset();
+	PolyStamp.Reset();
+	PolyStep.Reset();
+	PolyRank.Reset();
+	Stamp = 0;
+}
+
+//==========================================================================
+//
+// FLineTree :: Build
+//
+// Must be called after the blockmap and the polyobjects are set up.
+//
+//==========================================================================
+
+void FLineTree::Build(FLevelLocals *lev)
+{
+	Clear();
+	Level = lev;
+
+	auto &bm = Level->blockmap;
+	unsigned numlines = Level->lines.Size();
+	int numblocks = bm.bmapwidth * bm.bmapheight;
+	if (numlines == 0 || numblocks <= 0 || bm.blockmap == nullptr) return;
+
+	// Invert the blockmap so that each line knows which blocks list it.
+	LineBlockStart.Resize(numlines + 1);
+	memset(LineBlockStart.Data(), 0, LineBlockStart.Size() * sizeof(int));
+	for (int y = 0; y < bm.bmapheight; y++)
+	{
+		for (int x = 0; x < bm.bmapwidth; x++)
+		{
+			for (int *list = bm.GetLines(x, y); *list != -1; list++)
+			{
+				if ((unsigned)*list < numlines) LineBlockStart[*list + 1]++;
+			}
+		}
+	}
+	for (unsigned i = 0; i < numlines; i++)
+	{
+		LineBlockStart[i + 1] += LineBlockStart[i];
+	}
+	LineBlocks.Resize(LineBlockStart[numlines]);
+	TArray<int> fill(numlines, true);
+	memcpy(fill.Data(), LineBlockStart.Data(), numlines * sizeof(int));
+	for (int y = 0; y < bm.bmapheight; y++)
+	{
+		for (int x = 0; x < bm.bmapwidth; x++)
+		{
+			int pos = 0;
+			for (int *list = bm.GetLines(x, y); *list != -1; list++, pos++)
+			{
+				if ((unsigned)*list < numlines) LineBlocks[fill[*list]++] = { y * bm.bmapwidth + x, pos };
+			}
+		}
+	}
+
+	// Polyobject lines move, so they are kept out of the tree and checked
+	// separately on each query.
+	TArray<bool> ispoly(numlines, true);
+	memset(ispoly.Data(), 0, numlines * sizeof(bool));
+	for (auto &po : Level->Polyobjects)
+	{
+		for (auto line : po.Linedefs) ispoly[line->Index()] = true;
+	}
+
+	TArray<DVector2> centroids(numlines, true);
+	for (unsigned i = 0; i < numlines; i++)
+	{
+		auto &line = Level->lines[i];
+		centroids[i] = (line.v1->fPos() + line.v2->fPos()) * 0.5;
+		if (!ispoly[i]) LineOrder.Push(i);
+	}
+
+	BlockStamp.Resize(numblocks);
+	BlockStep.Resize(numblocks);
+	memset(BlockStamp.Data(), 0, numblocks * sizeof(unsigned));
+	unsigned numpolys = Level->Polyobjects.Size();
+	PolyStamp.Resize(numpolys);
+	PolyStep.Resize(numpolys);
+	PolyRank.Resize(numpolys);
+	if (numpolys > 0) memset(PolyStamp.Data(), 0, numpolys * sizeof(unsigned));
+
+	if (LineOrder.Size() > 0)
+	{
+		Nodes.Grow(2 * (LineOrder.Size() / MaxLeafLines + 1));
+		BuildNode(0, LineOrder.Size(), centroids);
+	}
+	DPrintf(DMSG_NOTIFY, "Line tree: %u nodes, %u lines, %u block entries\n", Nodes.Size(), LineOrder.Size(), LineBlocks.Size());
+}
+
+//==========================================================================
+//
+// FLineTree :: BuildNode
+//
+// Median split along the longer axis of the line centers.
+//
+//==========================================================================
+
+int FLineTree::BuildNode(unsigned first, unsigned count, const TArray<DVector2> &centroids)
+{
+	double minx = DBL_MAX, miny = DBL_MAX, maxx = -DBL_MAX, maxy = -DBL_MAX;
+	double cminx = DBL_MAX, cminy = DBL_MAX, cmaxx = -DBL_MAX, cmaxy = -DBL_MAX;
+	for (unsigned i = first; i < first + count; i++)
+	{
+		auto &line = Level->lines[LineOrder[i]];
+		minx = min(minx, line.bbox[BOXLEFT]);
+		maxx = max(maxx, line.bbox[BOXRIGHT]);
+		miny = min(miny, line.bbox[BOXBOTTOM]);
+		maxy = max(maxy, line.bbox[BOXTOP]);
+		auto &c = centroids[LineOrder[i]];
+		cminx = min(cminx, c.X);
+		cmaxx = max(cmaxx, c.X);
+		cminy = min(cminy, c.Y);
+		cmaxy = max(cmaxy, c.Y);
+	}
+
+	int index = Nodes.Reserve(1);
+	Nodes[index] = { float(minx - TreePadding), float(miny - TreePadding), float(maxx + TreePadding), float(maxy + TreePadding), (int)first, (int)count };
+	if (count <= MaxLeafLines) return index;
+
+	unsigned half = count / 2;
+	bool xaxis = cmaxx - cminx >= cmaxy - cminy;
+	std::nth_element(&LineOrder[first], &LineOrder[first + half], &LineOrder[first] + count, [&](int a, int b)
+	{
+		return xaxis ? centroids[a].X < centroids[b].X : centroids[a].Y < centroids[b].Y;
+	});
+
+	BuildNode(first, half, centroids);
+	int right = BuildNode(first + half, count - half, centroids);
+	Nodes[index].Child = right;
+	Nodes[index].Count = 0;
+	return index;
+}
+
+//==========================================================================
+//
+// FLineTree :: StaticKey
+//
+// Sort key of the earliest walk position where the line is listed in the
+// blockmap itself. Keys are step:16, poly/list part:1, rank:15, position:32.
+//
+//==========================================================================
+
+bool FLineTree::StaticKey(unsigned linenum, uint64_t &key) const
+{
+	bool found = false;
+	for (int i = LineBlockStart[linenum]; i < LineBlockStart[linenum + 1]; i++)
+	{
+		auto &entry = LineBlocks[i];
+		if (BlockStamp[entry.Block] == Stamp)
+		{
+			uint64_t k = (uint64_t(BlockStep[entry.Block]) << 48) | (uint64_t(1) << 47) | uint32_t(entry.Pos);
+			if (!found || k < key) key = k;
+			found = true;
+		}
+	}
+	return found;
+}
+
+//==========================================================================
+//
+// FLineTree :: CollectLines
+//
+//==========================================================================
+
+void FLineTree::CollectLines(const int *blocks, unsigned numblocks, const DVector2 &start, const DVector2 &end, TArray<Hit> &hits)
+{
+	hits.Clear();
+	SortHits.Clear();
+	if (Level == nullptr) return;
+	assert(numblocks < 0x10000);
+
+	if (++Stamp == 0)
+	{
+		memset(BlockStamp.Data(), 0, BlockStamp.Size() * sizeof(unsigned));
+		if (PolyStamp.Size() > 0) memset(PolyStamp.Data(), 0, PolyStamp.Size() * sizeof(unsigned));
+		Stamp = 1;
+	}
+
+	// Note the first step at which the walk enters each block and each polyobject.
+	auto &polyblocks = Level->PolyBlockMap;
+	bool anypolys = false;
+	for (unsigned i = 0; i < numblocks; i++)
+	{
+		int b = blocks[i];
+		if (b < 0 || BlockStamp[b] == Stamp) continue;
+		BlockStamp[b] = Stamp;
+		BlockStep[b] = i;
+
+		if ((unsigned)b < polyblocks.Size())
+		{
+			unsigned rank = 0;
+			for (polyblock_t *link = polyblocks[b]; link != nullptr; link = link->next, rank++)
+			{
+				if (link->polyobj == nullptr) continue;
+				unsigned po = unsigned(link->polyobj - &Level->Polyobjects[0]);
+				if (PolyStamp[po] != Stamp)
+				{
+					PolyStamp[po] = Stamp;
+					PolyStep[po] = i;
+					PolyRank[po] = rank;
+					anypolys = true;
+				}
+			}
+		}
+	}
+
+	DVector2 delta = end - start;
+
+	// Static lines
+	if (Nodes.Size() > 0)
+	{
+		Stack.Clear();
+		Stack.Push(0);
+		while (Stack.Size() > 0)
+		{
+			int index;
+			Stack.Pop(index);
+			auto &node = Nodes[index];
+			if (!SegmentTouchesBox(start, delta, node.MinX, node.MinY, node.MaxX, node.MaxY)) continue;
+
+			if (node.Count == 0)
+			{
+				Stack.Push(node.Child);
+				Stack.Push(index + 1);
+				continue;
+			}
+			for (int i = node.Child; i < node.Child + node.Count; i++)
+			{
+				line_t *line = &Level->lines[LineOrder[i]];
+				uint64_t key;
+				if (node.Count > 1 && !SegmentTouchesBox(start, delta, line->bbox[BOXLEFT] - TreePadding, line->bbox[BOXBOTTOM] - TreePadding,
+					line->bbox[BOXRIGHT] + TreePadding, line->bbox[BOXTOP] + TreePadding)) continue;
+				if (StaticKey(LineOrder[i], key)) SortHits.Push({ key, line });
+			}
+		}
+	}
+
+	// Polyobject lines can be found both through the polyobject links of the
+	// blocks they currently occupy and through the blockmap lists of their
+	// original position.
+	unsigned numpolys = Level->Polyobjects.Size();
+	for (unsigned po = 0; po < numpolys; po++)
+	{
+		auto &lines = Level->Polyobjects[po].Linedefs;
+		bool linked = anypolys && PolyStamp[po] == Stamp;
+		for (unsigned j = 0; j < lines.Size(); j++)
+		{
+			line_t *line = lines[j];
+			DVector2 v1 = line->v1->fPos(), v2 = line->v2->fPos();
+			if (!SegmentTouchesBox(start, delta, min(v1.X, v2.X) - TreePadding, min(v1.Y, v2.Y) - TreePadding,
+				max(v1.X, v2.X) + TreePadding, max(v1.Y, v2.Y) + TreePadding)) continue;
+
+			uint64_t key;
+			bool found = StaticKey(line->Index(), key);
+			if (linked)
+			{
+				uint64_t k = (uint64_t(PolyStep[po]) << 48) | (uint64_t(PolyRank[po]) << 32) | j;
+				if (!found || k < key) key = k;
+				found = true;
+			}
+			if (found) SortHits.Push({ key, line });
+		}
+	}
+
+	std::sort(SortHits.begin(), SortHits.end(), [](const SortHit &a, const SortHit &b) { return a.Key < b.Key; });
+	hits.Resize(SortHits.Size());
+	for (unsigned i = 0; i < SortHits.Size(); i++)
+	{
+		hits[i] = { SortHits[i].Line, unsigned(SortHits[i].Key >> 48) };
+	}
+}
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright 2026 The Redemption Team
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/
+//
+//-----------------------------------------------------------------------------
+//
+// DESCRIPTION:
+//		Bounding volume hierarchy over the level's lines, used to speed up
+//		long traces without changing their results.
+//
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include "tarray.h"
+#include "vectors.h"
+
+struct FLevelLocals;
+struct line_t;
+
+class FLineTree
+{
+public:
+	struct Hit
+	{
+		line_t *line;
+		unsigned step;		// index of the block in the walk where the blockmap would find it
+	};
+
+	enum
+	{
+		MinBlocks = 8,		// traces over fewer blocks are cheap enough to walk directly
+	};
+
+	void Build(FLevelLocals *Level);
+	void Clear();
+	bool IsBuilt() const { return Nodes.Size() > 0; }
+
+	// Finds all lines near the segment that a blockmap walk over the given
+	// blocks (as offsets into the blockmap, negative to skip a step) would
+	// look at, sorted in exactly the order the walk would see them.
+	// Callers still need to perform their own crossing test on each hit.
+	void CollectLines(const int *blocks, unsigned numblocks, const DVector2 &start, const DVector2 &end, TArray<Hit> &hits);
+
+private:
+	struct Node
+	{
+		float MinX, MinY, MaxX, MaxY;
+		int Child;		// leaf: first entry in LineOrder, otherwise the right child (the left one follows directly)
+		int Count;		// number of lines for leaves, 0 for inner nodes
+	};
+
+	// Where a line is listed in the blockmap.
+	struct BlockEntry
+	{
+		int Block;
+		int Pos;
+	};
+
+	struct SortHit
+	{
+		uint64_t Key;
+		line_t *Line;
+	};
+
+	int BuildNode(unsigned first, unsigned count, const TArray<DVector2> &centroids);
+	bool StaticKey(unsigned linenum, uint64_t &key) const;
+
+	FLevelLocals *Level = nullptr;
+	TArray<Node> Nodes;
+	TArray<int> LineOrder;
+	TArray<int> LineBlockStart;
+	TArray<BlockEntry> LineBlocks;
+
+	// Per block and polyobject data for the walk being processed.
+	TArray<unsigned> BlockStamp;
+	TArray<unsigned> BlockStep;
+	TArray<unsigned> PolyStamp;
+	TArray<unsigned> PolyStep;
+	TArray<unsigned> PolyRank;
+	unsigned Stamp = 0;
+
+	TArray<SortHit> SortHits;
+	TArray<int> Stack;
+};
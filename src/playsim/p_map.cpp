@@ -6057,6 +6057,88 @@ static int GetOldRadiusDamage(bool fromaction, AActor *bombspot, AActor *thing,
 	return ret;	// Not in sight.
 }
 
+//==========================================================================
+//
+// What P_RadiusAttack needs to know about a target to calculate the
+// falloff. The distances of all targets get calculated in one pass over
+// these before any of them is damaged.
+//
+//==========================================================================
+
+struct FRadiusTarget
+{
+	AActor *thing;
+	DVector3 pos;		// position when gathered, for detecting a move while damage was applied
+	double relx, rely;	// position relative to the bomb spot's portal group
+	double height;
+	double radius;
+	int portalgroup;
+	double points;		// GetRadiusDamage's result before the splash and radius damage factors
+	double olddist;		// GetOldRadiusDamage's distance
+};
+
+static void CalcRadiusTargetDistances(TArray<FRadiusTarget> &targets, AActor *bombspot, int bombdamage, int bombdistance, int fulldamagedistance, bool round)
+{
+	// Same operations in the same order as GetRadiusDamage and GetOldRadiusDamage
+	// so that the results are identical.
+	const double bombdistancefloat = 1. / (double)(bombdistance - fulldamagedistance);
+	const double bombdamagefloat = (double)bombdamage;
+	const double bx = bombspot->X(), by = bombspot->Y(), bz = bombspot->Z();
+	const double full = (double)fulldamagedistance;
+
+	for (auto &t : targets)
+	{
+		double dx = fabs(t.relx - bx);
+		double dy = fabs(t.rely - by);
+		double square = dx > dy ? dx : dy;
+		double len;
+
+		if (!round)
+		{
+			double tz = t.pos.Z;
+			double ttop = tz + t.height;
+			len = square;
+			if (bz < tz || bz >= ttop)
+			{
+				double dz = bz > tz ? bz - ttop : tz - bz;
+				if (len <= t.radius)
+				{
+					len = dz;
+				}
+				else
+				{
+					len -= t.radius;
+					len = g_sqrt(len*len + dz*dz);
+				}
+			}
+			else
+			{
+				len -= t.radius;
+				if (len < 0.f)
+					len = 0.f;
+			}
+		}
+		else
+		{
+			len = DVector3(bx - t.relx, by - t.rely, bz - t.pos.Z).Length();
+		}
+		len = clamp<double>(len - full, 0, len);
+		t.points = bombdamagefloat * (1. - len * bombdistancefloat);
+
+		double dist = square - t.radius;
+		t.olddist = dist < 0 ? 0 : dist;
+	}
+}
+
+// Damaging a target can run scripts which move things around. The
+// precalculated values only hold while nothing they depend on has changed.
+static bool RadiusTargetUnchanged(const FRadiusTarget &t, AActor *bombspot, const DVector3 &bombpos, int bombgroup)
+{
+	AActor *thing = t.thing;
+	return thing->Pos() == t.pos && thing->Height == t.height && thing->radius == t.radius && thing->Sector->PortalGroup == t.portalgroup &&
+		bombspot->Pos() == bombpos && bombspot->Sector->PortalGroup == bombgroup;
+}
+
 //==========================================================================
 //
 // GetRadiusDamage
@@ -6115,7 +6197,7 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, int bom
 
 	P_GeometryRadiusAttack(bombspot, bombsource, bombdamage, bombdistance, bombmod, fulldamagedistance);
 
-	TArray<AActor*> targets;
+	TArray<FRadiusTarget> targets;
 	int count = 0;
 	while ((it.Next(&cres)))
 	{
@@ -6162,11 +6244,19 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, int bom
 		if (bombsource && thing != bombsource && bombsource->player && P_ShouldPassThroughPlayer(bombsource, thing))
 			continue;
 
-		targets.Push(thing);
+		DVector3 rel = thing->PosRelative(bombspot);
+		targets.Push({ thing, thing->Pos(), rel.X, rel.Y, thing->Height, thing->radius, thing->Sector->PortalGroup, 0, 0 });
 	}
 
-	for (AActor *thing : targets)
+	CalcRadiusTargetDistances(targets, bombspot, bombdamage, bombdistance, fulldamagedistance, !!(flags & RADF_CIRCULAR));
+	const DVector3 bombpos = bombspot->Pos();
+	const int bombgroup = bombspot->Sector->PortalGroup;
+
+	for (auto &target : targets)
 	{
+		AActor *thing = target.thing;
+		bool unchanged = RadiusTargetUnchanged(target, bombspot, bombpos, bombgroup);
+
 		// Barrels always use the original code, since this makes
 		// them far too "active." BossBrains also use the old code
 		// because some user levels require they have a height of 16,
@@ -6174,7 +6264,17 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, int bom
 		if ((flags & RADF_NODAMAGE) || (!((bombspot->flags5 | thing->flags5) & MF5_OLDRADIUSDMG) && 
 			!(flags & RADF_OLDRADIUSDAMAGE) && !(thing->Level->i_compatflags2 & COMPATF2_EXPLODE2)))
 		{
-			double points = GetRadiusDamage(false, bombspot, thing, bombdamage, bombdistance, fulldamagedistance, bombsource == thing,!!(flags & RADF_CIRCULAR));
+			double points;
+			if (unchanged)
+			{
+				points = target.points;
+				if (bombsource == thing) points = points * splashfactor;
+				points *= thing->RadiusDamageFactor;
+			}
+			else
+			{
+				points = GetRadiusDamage(false, bombspot, thing, bombdamage, bombdistance, fulldamagedistance, bombsource == thing, !!(flags & RADF_CIRCULAR));
+			}
 			double check = int(points) * bombdamage;
 			// points and bombdamage should be the same sign (the double cast of 'points' is needed to prevent overflows and incorrect values slipping through.)
 			if ((check > 0 || (check == 0 && bombspot->flags7 & MF7_FORCEZERORADIUSDMG)) && P_CheckSight(thing, bombspot, SF_IGNOREVISIBILITY | SF_IGNOREWATERBOUNDARY))
@@ -6241,6 +6341,9 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, int bom
 		else
 		{
 			// [RH] Old code just for barrels
+			// An out of range target can be rejected from the precalculated distance without a sight check.
+			if (unchanged && target.olddist >= bombdistance)
+				continue;
 			int damage = GetOldRadiusDamage(false, bombspot, thing, bombdamage, bombdistance, fulldamagedistance);
 
 			if (damage < 0)
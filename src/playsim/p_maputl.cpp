@@ -340,6 +340,7 @@ void AActor::UnlinkFromWorld (FLinkContext *ctx)
 				block->NextActor->PrevActor = block->PrevActor;
 			}
 			*(block->PrevActor) = block->NextActor;
+			Level->blockmap.UnlinkThing(block);
 			FBlockNode *next = block->NextBlock;
 			block->Release ();
 			block = next;
@@ -545,6 +546,7 @@ void AActor::LinkToWorld(FLinkContext *ctx, bool spawningmapthing, sector_t *sec
 						}
 						node->PrevActor = link;
 						*link = node;
+						Level->blockmap.LinkThing(node);
 
 						// Link in to actor
 						node->PrevBlock = alink;
@@ -555,6 +557,10 @@ void AActor::LinkToWorld(FLinkContext *ctx, bool spawningmapthing, sector_t *sec
 				}
 			}
 		}
+		if (BlockNode != nullptr && BlockNode->NextBlock == nullptr)
+		{
+			Level->blockmap.SetSingle(BlockNode);
+		}
 	}
 	// Portal links cannot be done unless the level is fully initialized.
 	if (!spawningmapthing) UpdateRenderSectorList();
@@ -896,6 +902,8 @@ FBlockThingsIterator::FBlockThingsIterator(FLevelLocals *l)
 	miny = maxy = 0;
 	ClearHash();
 	block = NULL;
+	things = NULL;
+	thingindex = -1;
 }
 
 FBlockThingsIterator::FBlockThingsIterator(FLevelLocals *l, int _minx, int _miny, int _maxx, int _maxy)
@@ -943,14 +951,17 @@ void FBlockThingsIterator::StartBlock(int x, int y)
 {
 	curx = x;
 	cury = y;
+	block = NULL;
+	things = NULL;
+	thingindex = -1;
 	if (Level->blockmap.isValidBlock(x, y))
 	{
+		// The chain head is where the walk continues if the block changes before the first Next.
 		block = Level->blockmap.blocklinks[y*Level->blockmap.bmapwidth + x];
-	}
-	else
-	{
-		// invalid block
-		block = NULL;
+		auto &list = Level->blockmap.blockthings[y*Level->blockmap.bmapwidth + x];
+		things = list.Things.Data();
+		thingindex = (int)list.Things.Size() - 1;
+		thingversion = list.Version;
 	}
 }
 
@@ -967,6 +978,73 @@ void FBlockThingsIterator::SwitchBlock(int x, int y)
 	StartBlock(x, y);
 }
 
+//===========================================================================
+//
+// FBlockThingsIterator :: CheckActor
+//
+// Returns the actor if it hasn't been returned yet.
+//
+//===========================================================================
+
+AActor *FBlockThingsIterator::CheckActor(AActor *me, bool single, bool centeronly)
+{
+	HashEntry *entry;
+	int i;
+
+	// Don't recheck things that were already checked
+	if (single)
+	{ // This actor doesn't span blocks, so we know it can only ever be checked once.
+		return me;
+	}
+	if (centeronly)
+	{
+		// Block boundaries for compatibility mode
+		double blockleft = (curx * FBlockmap::MAPBLOCKUNITS) + Level->blockmap.bmaporgx;
+		double blockright = blockleft + FBlockmap::MAPBLOCKUNITS;
+		double blockbottom = (cury * FBlockmap::MAPBLOCKUNITS) + Level->blockmap.bmaporgy;
+		double blocktop = blockbottom + FBlockmap::MAPBLOCKUNITS;
+
+		// only return actors with the center in this block
+		if (me->X() >= blockleft && me->X() < blockright &&
+			me->Y() >= blockbottom && me->Y() < blocktop)
+		{
+			return me;
+		}
+		return NULL;
+	}
+
+	size_t hash = ((size_t)me >> 3) % countof(Buckets);
+	for (i = Buckets[hash]; i >= 0; )
+	{
+		entry = GetHashEntry(i);
+		if (entry->Actor == me)
+		{ // I've already been checked. Skip to the next actor.
+			return NULL;
+		}
+		i = entry->Next;
+	}
+	// Add me to the hash table and return me.
+	if (NumFixedHash < (int)countof(FixedHash))
+	{
+		entry = &FixedHash[NumFixedHash];
+		entry->Next = Buckets[hash];
+		Buckets[hash] = NumFixedHash++;
+	}
+	else
+	{
+		if (DynHash.Size() == 0)
+		{
+			DynHash.Grow(50);
+		}
+		i = DynHash.Reserve(1);
+		entry = &DynHash[i];
+		entry->Next = Buckets[hash];
+		Buckets[hash] = i + countof(FixedHash);
+	}
+	entry->Actor = me;
+	return me;
+}
+
 //===========================================================================
 //
 // FBlockThingsIterator :: Next
@@ -977,68 +1055,38 @@ AActor *FBlockThingsIterator::Next(bool centeronly)
 {
 	for (;;)
 	{
+		if (things != NULL)
+		{
+			if (thingversion == Level->blockmap.blockthings[cury*Level->blockmap.bmapwidth + curx].Version)
+			{
+				while (thingindex >= 0)
+				{
+					FBlockThing &thing = things[thingindex--];
+					if (thing.Me == NULL) continue;	// unlinked
+					if (AActor *me = CheckActor(thing.Me, thing.Single, centeronly))
+					{
+						// Remember what comes next in chain terms, in case
+						// the caller links or unlinks something in this block.
+						block = thing.Node->NextActor;
+						return me;
+					}
+				}
+				block = NULL;
+			}
+			// Otherwise the block may have changed under us, so continue
+			// with the chain, exactly like a plain walk of it would.
+			things = NULL;
+		}
+
 		while (block != NULL)
 		{
 			AActor *me = block->Me;
 			FBlockNode *mynode = block;
-			HashEntry *entry;
-			int i;
 
 			block = block->NextActor;
-			// Don't recheck things that were already checked
-			if (mynode->NextBlock == NULL && mynode->PrevBlock == &me->BlockNode)
-			{ // This actor doesn't span blocks, so we know it can only ever be checked once.
-				return me;
-			}
-			if (centeronly)
-			{
-				// Block boundaries for compatibility mode
-				double blockleft = (curx * FBlockmap::MAPBLOCKUNITS) + Level->blockmap.bmaporgx;
-				double blockright = blockleft + FBlockmap::MAPBLOCKUNITS;
-				double blockbottom = (cury * FBlockmap::MAPBLOCKUNITS) + Level->blockmap.bmaporgy;
-				double blocktop = blockbottom + FBlockmap::MAPBLOCKUNITS;
-
-				// only return actors with the center in this block
-				if (me->X() >= blockleft && me->X() < blockright &&
-					me->Y() >= blockbottom && me->Y() < blocktop)
-				{
-					return me;
-				}
-			}
-			else
+			if (AActor *ret = CheckActor(me, mynode->NextBlock == NULL && mynode->PrevBlock == &me->BlockNode, centeronly))
 			{
-				size_t hash = ((size_t)me >> 3) % countof(Buckets);
-				for (i = Buckets[hash]; i >= 0; )
-				{
-					entry = GetHashEntry(i);
-					if (entry->Actor == me)
-					{ // I've already been checked. Skip to the next actor.
-						break;
-					}
-					i = entry->Next;
-				}
-				if (i < 0)
-				{ // Add me to the hash table and return me.
-					if (NumFixedHash < (int)countof(FixedHash))
-					{
-						entry = &FixedHash[NumFixedHash];
-						entry->Next = Buckets[hash];
-						Buckets[hash] = NumFixedHash++;
-					}
-					else
-					{
-						if (DynHash.Size() == 0)
-						{
-							DynHash.Grow(50);
-						}
-						i = DynHash.Reserve(1);
-						entry = &DynHash[i];
-						entry->Next = Buckets[hash];
-						Buckets[hash] = i + countof(FixedHash);
-					}
-					entry->Actor = me;
-					return me;
-				}
+				return ret;
 			}
 		}
 
@@ -1164,6 +1212,25 @@ void FMultiBlockThingsIterator::Reset()
 
 TArray<intercept_t> FPathTraverse::intercepts(128);
 
+// Blocks visited by a trace that uses the line tree, in visiting order.
+// Line steps must see the tree's hits, thing steps the thing iterator.
+struct FTraceStep
+{
+	int x, y;
+	int kind;
+};
+enum
+{
+	TS_Lines,
+	TS_Things,
+	TS_ThingsCompatible,
+};
+static TArray<FTraceStep> TraceSteps;
+static TArray<int> TraceBlocks;
+static TArray<FLineTree::Hit> TraceHits;
+
+CVARD(Bool, trace_linetree, true, 0, "use the line tree to collect lines for long traces")
+
 
 //===========================================================================
 //
@@ -1184,30 +1251,35 @@ void FPathTraverse::AddLineIntercepts(int bx, int by)
 
 	while ((ld = it.Next()))
 	{
-		int 				s1;
-		int 				s2;
-		double 				frac;
-		divline_t			dl;
+		AddLineIntercept(ld);
+	}
+}
 
-		s1 = P_PointOnDivlineSide (ld->v1->fX(), ld->v1->fY(), &trace);
-		s2 = P_PointOnDivlineSide (ld->v2->fX(), ld->v2->fY(), &trace);
-		
-		if (s1 == s2) continue;	// line isn't crossed
-		
-		// hit the line
-		P_MakeDivline (ld, &dl);
-		frac = P_InterceptVector (&trace, &dl);
+void FPathTraverse::AddLineIntercept(line_t *ld)
+{
+	int 				s1;
+	int 				s2;
+	double 				frac;
+	divline_t			dl;
 
-		if (frac < Startfrac || frac > 1.) continue;	// behind source or beyond end point
-			
-		intercept_t newintercept;
+	s1 = P_PointOnDivlineSide (ld->v1->fX(), ld->v1->fY(), &trace);
+	s2 = P_PointOnDivlineSide (ld->v2->fX(), ld->v2->fY(), &trace);
+	
+	if (s1 == s2) return;	// line isn't crossed
+	
+	// hit the line
+	P_MakeDivline (ld, &dl);
+	frac = P_InterceptVector (&trace, &dl);
 
-		newintercept.frac = frac;
-		newintercept.isaline = true;
-		newintercept.done = false;
-		newintercept.d.line = ld;
-		intercepts.Push (newintercept);
-	}
+	if (frac < Startfrac || frac > 1.) return;	// behind source or beyond end point
+		
+	intercept_t newintercept;
+
+	newintercept.frac = frac;
+	newintercept.isaline = true;
+	newintercept.done = false;
+	newintercept.d.line = ld;
+	intercepts.Push (newintercept);
 }
 
 
@@ -1551,19 +1623,37 @@ void FPathTraverse::init(double x1, double y1, double x2, double y2, int flags,
 	// from skipping the break statement.
 
 	bool compatible = (flags & PT_COMPATIBLE) && (Level->i_compatflags & COMPATF_HITSCAN);
-		
+
+	// For long traces, only record the blocks in walking order here and let
+	// the line tree find the lines afterward. Everything is then added in
+	// the same order the direct walk would have used.
+	bool usetree = (flags & PT_ADDLINES) && trace_linetree && Level->lineTree.IsBuilt() && CanUseLineTree() &&
+		abs(mapex - mapx) + abs(mapey - mapy) >= FLineTree::MinBlocks;
+	if (usetree) TraceSteps.Clear();
+
 	// we want to use one list of checked actors for the entire operation
 	FBlockThingsIterator btit(Level);
+	auto addlines = [&](int x, int y)
+	{
+		if (usetree) TraceSteps.Push({ x, y, TS_Lines });
+		else AddLineIntercepts(x, y);
+	};
+	auto addthings = [&](int x, int y, bool compat)
+	{
+		if (usetree) TraceSteps.Push({ x, y, compat ? TS_ThingsCompatible : TS_Things });
+		else AddThingIntercepts(x, y, btit, compat);
+	};
+
 	for (count = 0 ; count < 1000 ; count++)
 	{
 		if (flags & PT_ADDLINES)
 		{
-			AddLineIntercepts(mapx, mapy);
+			addlines(mapx, mapy);
 		}
 		
 		if (flags & PT_ADDTHINGS)
 		{
-			AddThingIntercepts(mapx, mapy, btit, compatible);
+			addthings(mapx, mapy, compatible);
 		}
 				
 		// both coordinates reached the end, so end the traversing.
@@ -1602,14 +1692,14 @@ void FPathTraverse::init(double x1, double y1, double x2, double y2, int flags,
 			{
 				if (flags & PT_ADDLINES)
 				{
-					AddLineIntercepts(mapx + mapxstep, mapy);
-					AddLineIntercepts(mapx, mapy + mapystep);
+					addlines(mapx + mapxstep, mapy);
+					addlines(mapx, mapy + mapystep);
 				}
 				
 				if (flags & PT_ADDTHINGS)
 				{
-					AddThingIntercepts(mapx + mapxstep, mapy, btit, false);
-					AddThingIntercepts(mapx, mapy + mapystep, btit, false);
+					addthings(mapx + mapxstep, mapy, false);
+					addthings(mapx, mapy + mapystep, false);
 				}
 				xintercept += xstep;
 				yintercept += ystep;
@@ -1627,6 +1717,38 @@ void FPathTraverse::init(double x1, double y1, double x2, double y2, int flags,
 			break;
 		}
 	}
+
+	if (usetree)
+	{
+		TraceBlocks.Resize(TraceSteps.Size());
+		for (unsigned i = 0; i < TraceSteps.Size(); i++)
+		{
+			auto &step = TraceSteps[i];
+			bool lines = step.kind == TS_Lines && Level->blockmap.isValidBlock(step.x, step.y);
+			TraceBlocks[i] = lines ? step.y * Level->blockmap.bmapwidth + step.x : -1;
+		}
+		DVector2 start(trace.x + trace.dx * Startfrac, trace.y + trace.dy * Startfrac);
+		DVector2 end(trace.x + trace.dx, trace.y + trace.dy);
+		Level->lineTree.CollectLines(TraceBlocks.Data(), TraceBlocks.Size(), start, end, TraceHits);
+
+		unsigned hit = 0;
+		for (unsigned i = 0; i < TraceSteps.Size(); i++)
+		{
+			auto &step = TraceSteps[i];
+			if (step.kind == TS_Lines)
+			{
+				for (; hit < TraceHits.Size() && TraceHits[hit].step == i; hit++)
+				{
+					TraceHits[hit].line->validcount = validcount;
+					AddLineIntercept(TraceHits[hit].line);
+				}
+			}
+			else
+			{
+				AddThingIntercepts(step.x, step.y, btit, step.kind == TS_ThingsCompatible);
+			}
+		}
+	}
 }
 
 //===========================================================================
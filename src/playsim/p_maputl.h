@@ -10,6 +10,7 @@
 
 extern int validcount;
 struct FBlockNode;
+struct FBlockThing;
 
 struct divline_t
 {
@@ -291,6 +292,12 @@ class FBlockThingsIterator
 
 	int curx, cury;
 
+	// The current block is walked through its contiguous thing array. If
+	// anything gets linked into or unlinked from that block while this is in
+	// progress, the rest of it falls back to the node chain, starting at 'block'.
+	FBlockThing *things;
+	int thingindex;
+	unsigned thingversion;
 	FBlockNode *block;
 
 	int Buckets[32];
@@ -309,6 +316,7 @@ class FBlockThingsIterator
 	void StartBlock(int x, int y);
 	void SwitchBlock(int x, int y);
 	void ClearHash();
+	AActor *CheckActor(AActor *me, bool single, bool centeronly);
 
 	// The following is only for use in the path traverser 
 	// and therefore declared private.
@@ -378,6 +386,9 @@ protected:
 
 	virtual void AddLineIntercepts(int bx, int by);
 	virtual void AddThingIntercepts(int bx, int by, FBlockThingsIterator &it, bool compatible);
+	// Only traversers that collect lines straight from the blockmap may use the line tree.
+	virtual bool CanUseLineTree() const { return true; }
+	void AddLineIntercept(line_t *ld);
 	FPathTraverse(FLevelLocals *l) 
 	{
 		Level = l;
@@ -88,6 +88,9 @@ void P_PutSecnode(msecnode_t *node)
 //
 //=============================================================================
 
+template<class nodetype, class linktype>
+static nodetype *P_LinkNewSecnode(linktype *s, AActor *thing, nodetype *nextnode, nodetype *&sec_thinglist);
+
 template<class nodetype, class linktype>
 nodetype *P_AddSecnode(linktype *s, AActor *thing, nodetype *nextnode, nodetype *&sec_thinglist)
 {
@@ -111,8 +114,22 @@ nodetype *P_AddSecnode(linktype *s, AActor *thing, nodetype *nextnode, nodetype
 
 	// Couldn't find an existing node for this sector. Add one at the head
 	// of the list.
+	return P_LinkNewSecnode(s, thing, nextnode, sec_thinglist);
+}
 
-	node = (nodetype*)P_GetSecnode();
+//=============================================================================
+//
+// P_LinkNewSecnode
+//
+// Second half of P_AddSecnode, for when it is known that the thing
+// doesn't touch the sector yet.
+//
+//=============================================================================
+
+template<class nodetype, class linktype>
+static nodetype *P_LinkNewSecnode(linktype *s, AActor *thing, nodetype *nextnode, nodetype *&sec_thinglist)
+{
+	nodetype *node = (nodetype*)P_GetSecnode();
 
 	// killough 4/4/98, 4/7/98: mark new nodes unvisited.
 	node->visited = 0;
@@ -220,10 +237,45 @@ void P_DelSeclist(portnode_t *node, portnode_t *FLinePortal::*sechead)
 //
 //=============================================================================
 
+// For each sector, the node in the list currently being built. Only valid
+// if the sector's stamp matches, which saves P_AddSecnode's search through
+// the entire list for each touched line.
+static TArray<msecnode_t *> SecNodeLookup;
+static TArray<unsigned> SecNodeStamps;
+static unsigned SecNodeStamp;
+
+static msecnode_t *AddSecnodeLookup(sector_t *s, AActor *thing, msecnode_t *nextnode, msecnode_t *&sec_thinglist)
+{
+	int index = s->Index();
+	if (SecNodeStamps[index] == SecNodeStamp)
+	{
+		SecNodeLookup[index]->m_thing = thing;	// 'keep it'
+		return nextnode;
+	}
+	msecnode_t *node = P_LinkNewSecnode(s, thing, nextnode, sec_thinglist);
+	SecNodeLookup[index] = node;
+	SecNodeStamps[index] = SecNodeStamp;
+	return node;
+}
+
 msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector_list, msecnode_t *sector_t::*seclisthead)
 {
 	msecnode_t *node;
 
+	unsigned numsectors = thing->Level->sectors.Size();
+	if (SecNodeStamps.Size() < numsectors)
+	{
+		SecNodeLookup.Resize(numsectors);
+		SecNodeStamps.Resize(numsectors);
+		memset(SecNodeStamps.Data(), 0, numsectors * sizeof(unsigned));
+		SecNodeStamp = 0;
+	}
+	if (++SecNodeStamp == 0)
+	{
+		memset(SecNodeStamps.Data(), 0, SecNodeStamps.Size() * sizeof(unsigned));
+		SecNodeStamp = 1;
+	}
+
 	// First, clear out the existing m_thing fields. As each node is
 	// added or verified as needed, m_thing will be set properly. When
 	// finished, delete all nodes where m_thing is still nullptr. These
@@ -233,6 +285,8 @@ msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector
 	while (node)
 	{
 		node->m_thing = nullptr;
+		SecNodeLookup[node->m_sector->Index()] = node;
+		SecNodeStamps[node->m_sector->Index()] = SecNodeStamp;
 		node = node->m_tnext;
 	}
 
@@ -252,7 +306,7 @@ msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector
 		// allowed to move to this position, then the sector_list
 		// will be attached to the Thing's AActor at touching_sectorlist.
 
-		sector_list = P_AddSecnode(ld->frontsector, thing, sector_list, ld->frontsector->*seclisthead);
+		sector_list = AddSecnodeLookup(ld->frontsector, thing, sector_list, ld->frontsector->*seclisthead);
 
 		// Don't assume all lines are 2-sided, since some Things
 		// like MT_TFOG are allowed regardless of whether their radius takes
@@ -262,12 +316,12 @@ msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector
 		// Use sidedefs instead of 2s flag to determine two-sidedness.
 
 		if (ld->backsector)
-			sector_list = P_AddSecnode(ld->backsector, thing, sector_list, ld->backsector->*seclisthead);
+			sector_list = AddSecnodeLookup(ld->backsector, thing, sector_list, ld->backsector->*seclisthead);
 	}
 
 	// Add the sector of the (x,y) point to sector_list.
 
-	sector_list = P_AddSecnode(thing->Sector, thing, sector_list, thing->Sector->*seclisthead);
+	sector_list = AddSecnodeLookup(thing->Sector, thing, sector_list, thing->Sector->*seclisthead);
 
 	// Now delete any nodes that won't be used. These are the ones where
 	// m_thing is still nullptr.
@@ -480,3 +534,93 @@ void FBlockNode::Release()
 	NextBlock = FreeBlocks;
 	FreeBlocks = this;
 }
+
+//===========================================================================
+//
+// FBlockmap :: LinkThing
+//
+// Mirrors a node that was just put at the head of its block's chain.
+//
+//===========================================================================
+
+void FBlockmap::LinkThing(FBlockNode *node, bool single)
+{
+	auto &block = blockthings[node->BlockIndex];
+	node->ThingIndex = block.Things.Push({ node->Me, node, single });
+	block.Version++;
+}
+
+//===========================================================================
+//
+// FBlockmap :: UnlinkThing
+//
+// Clears a node's entry without moving any of the others, so this does not
+// depend on how many things share the block. Once half of the entries are
+// dead the array is compacted, which keeps the remaining ones in order.
+//
+//===========================================================================
+
+void FBlockmap::UnlinkThing(FBlockNode *node)
+{
+	auto &block = blockthings[node->BlockIndex];
+	auto &things = block.Things;
+	assert((unsigned)node->ThingIndex < things.Size() && things[node->ThingIndex].Node == node);
+	things[node->ThingIndex].Me = nullptr;
+	things[node->ThingIndex].Node = nullptr;
+	block.Version++;
+
+	if (++block.Dead * 2 >= things.Size())
+	{
+		unsigned live = 0;
+		for (unsigned i = 0; i < things.Size(); i++)
+		{
+			if (things[i].Me != nullptr)
+			{
+				things[i].Node->ThingIndex = live;
+				things[live++] = things[i];
+			}
+		}
+		things.Clamp(live);
+		block.Dead = 0;
+	}
+}
+
+//===========================================================================
+//
+// FBlockmap :: RelinkThing
+//
+// Puts a node's entry back where it was before UnlinkThing, after the node
+// itself has been put back into its block's chain. The entry belongs right
+// after the one of the next node in the chain, which is the next older one.
+// Used by player prediction, which must leave the blockmap unchanged.
+//
+//===========================================================================
+
+void FBlockmap::RelinkThing(FBlockNode *node, bool single)
+{
+	auto &block = blockthings[node->BlockIndex];
+	auto &things = block.Things;
+	unsigned index = node->NextActor != nullptr ? node->NextActor->ThingIndex + 1 : 0;
+	things.Insert(index, { node->Me, node, single });
+	for (unsigned i = index; i < things.Size(); i++)
+	{
+		if (things[i].Node != nullptr) things[i].Node->ThingIndex = i;
+	}
+	block.Version++;
+}
+
+//===========================================================================
+//
+// FBlockmap :: SetSingle
+//
+// Flags the entry of an actor that only got linked into one block, so that
+// iterators can skip the duplicate check for it.
+//
+//===========================================================================
+
+void FBlockmap::SetSingle(FBlockNode *node)
+{
+	auto &things = blockthings[node->BlockIndex].Things;
+	assert((unsigned)node->ThingIndex < things.Size() && things[node->ThingIndex].Node == node);
+	things[node->ThingIndex].Single = true;
+}
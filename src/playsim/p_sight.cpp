@@ -90,6 +90,19 @@ struct SightTask
 static TArray<intercept_t> intercepts (128);
 static TArray<SightTask> portals(32);
 
+// Block walk of a sight check that uses the line tree. Steps flagged as corners
+// are the extra blocks checked when a trace passes exactly through a corner.
+struct FSightStep
+{
+	int x, y;
+	int corner;		// 0 for the main block, 1 and 2 for the pair of corner blocks
+};
+static TArray<FSightStep> sightsteps;
+static TArray<int> sightblocks;
+static TArray<FLineTree::Hit> sighthits;
+
+EXTERN_CVAR(Bool, trace_linetree)
+
 class SightCheck
 {
 	FLevelLocals *Level;
@@ -113,6 +126,8 @@ class SightCheck
 	bool PTR_SightTraverse (intercept_t *in);
 	bool P_SightCheckLine (line_t *ld);
 	int P_SightBlockLinesIterator (int x, int y);
+	int P_SightBlockTreeLines (int x, int y, unsigned step, unsigned &hit);
+	bool P_SightTreeTraverse (int mapx, int mapy, int mapex, int mapey, int mapxstep, int mapystep, double xstep, double ystep, double xintercept, double yintercept);
 	bool P_SightTraverseIntercepts ();
 	bool LineBlocksSight(line_t *ld);
 
@@ -523,6 +538,39 @@ int SightCheck::P_SightBlockLinesIterator (int x, int y)
 	return res;			// everything was checked
 }
 
+/*
+==================
+=
+= P_SightBlockTreeLines
+=
+= Same as P_SightBlockLinesIterator but only checks the lines the line tree
+= found for this step of the walk. Those are exactly the lines that can pass
+= P_SightCheckLine, in the same order.
+=
+===================
+*/
+
+int SightCheck::P_SightBlockTreeLines (int x, int y, unsigned step, unsigned &hit)
+{
+	if (!Level->blockmap.isValidBlock(x, y)) return 1;
+
+	int offset = y* Level->blockmap.bmapwidth+x;
+	int res = 1;
+
+	portalfound = portalfound || Level->PortalBlockmap(x, y).containsLinkedPortals;
+	portalfound |= (Level->PolyBlockMap[offset] && Level->PortalBlockmap.hasLinkedPolyPortals);
+
+	for (; hit < sighthits.Size() && sighthits[hit].step == step; hit++)
+	{
+		if (!P_SightCheckLine (sighthits[hit].line))
+		{
+			if (!portalfound) return 0;
+			else res = -1;
+		}
+	}
+	return res;
+}
+
 /*
 ====================
 =
@@ -744,6 +792,11 @@ bool SightCheck::P_SightPathTraverse ()
 		}
 	}
 
+	if (trace_linetree && Level->lineTree.IsBuilt() && abs(mapex - mapx) + abs(mapey - mapy) >= FLineTree::MinBlocks)
+	{
+		return P_SightTreeTraverse(mapx, mapy, mapex, mapey, mapxstep, mapystep, xstep, ystep, xintercept, yintercept);
+	}
+
 //
 // step through map blocks
 // Count is present to prevent a round off error from skipping the break
@@ -825,6 +878,120 @@ sightcounts[2]++;
 	return traverseres;
 }
 
+/*
+===================
+=
+= P_SightTreeTraverse
+=
+= Second half of P_SightPathTraverse for long traces. The block walk is
+= recorded first, then replayed with the lines the line tree found, keeping
+= all early-outs of the direct walk.
+=
+===================
+*/
+
+bool SightCheck::P_SightTreeTraverse (int mapx, int mapy, int mapex, int mapey, int mapxstep, int mapystep, double xstep, double ystep, double xintercept, double yintercept)
+{
+	bool aborted = false;
+
+	sightsteps.Clear();
+	for (int count = 0 ; count < 1000 ; count++)
+	{
+		if (!Level->blockmap.isValidBlock(mapx, mapy))
+		{
+			break;
+		}
+		sightsteps.Push({ mapx, mapy, 0 });
+		if ((mapxstep | mapystep) == 0)
+			break;
+
+		switch (((xs_FloorToInt(yintercept) == mapy) << 1) | (xs_FloorToInt(xintercept) == mapx))
+		{
+		case 0:		// neither xintercept nor yintercept match!
+			aborted = true;
+			count = 1000;
+			break;
+
+		case 1:		// xintercept matches
+			xintercept += xstep;
+			mapy += mapystep;
+			if (mapy == mapey)
+				mapystep = 0;
+			break;
+
+		case 2:		// yintercept matches
+			yintercept += ystep;
+			mapx += mapxstep;
+			if (mapx == mapex)
+				mapxstep = 0;
+			break;
+
+		case 3:		// xintercept and yintercept both match
+			sightsteps.Push({ mapx + mapxstep, mapy, 1 });
+			sightsteps.Push({ mapx, mapy + mapystep, 2 });
+			xintercept += xstep;
+			yintercept += ystep;
+			mapx += mapxstep;
+			mapy += mapystep;
+			if (mapx == mapex)
+				mapxstep = 0;
+			if (mapy == mapey)
+				mapystep = 0;
+			break;
+		}
+	}
+
+	sightblocks.Resize(sightsteps.Size());
+	for (unsigned i = 0; i < sightsteps.Size(); i++)
+	{
+		auto &step = sightsteps[i];
+		sightblocks[i] = Level->blockmap.isValidBlock(step.x, step.y) ? step.y * Level->blockmap.bmapwidth + step.x : -1;
+	}
+	Level->lineTree.CollectLines(sightblocks.Data(), sightblocks.Size(), DVector2(Trace.x, Trace.y), DVector2(Trace.x + Trace.dx, Trace.y + Trace.dy), sighthits);
+
+	int itres = -1;
+	unsigned hit = 0;
+	for (unsigned i = 0; i < sightsteps.Size(); i++)
+	{
+		auto &step = sightsteps[i];
+		if (step.corner == 0)
+		{
+			itres = P_SightBlockTreeLines(step.x, step.y, i, hit);
+			if (itres == 0)
+			{
+				sightcounts[1]++;
+				return false;	// early out
+			}
+			if (itres == -1)
+			{
+				aborted = false;	// the direct walk would have stopped here
+				break;
+			}
+		}
+		else
+		{
+			if (step.corner == 1) sightcounts[4]++;
+			if (!P_SightBlockTreeLines(step.x, step.y, i, hit))
+			{
+				sightcounts[1]++;
+				return false;
+			}
+		}
+	}
+	if (aborted)
+	{
+		sightcounts[5]++;
+		return false;
+	}
+
+	sightcounts[2]++;
+
+	bool traverseres = P_SightTraverseIntercepts ( );
+	if (itres == -1) return false;	// if the iterator had an early out there was no line of sight. The traverser was only called to collect more portals.
+	if (seeingthing->Sector->PortalGroup != portalgroup) return false;	// We are in a different group than the seeingthing, so this trace cannot determine visibility alone.
+	return traverseres;
+}
+
 /*
 =====================
 =
@@ -150,6 +150,8 @@ static TArray<msecnode_t *> PredictionPortalSectors_sprev_Backup;
 static TArray<FLinePortal *> PredictionPortalLinesBackup;
 static TArray<portnode_t *> PredictionPortalLines_sprev_Backup;
 
+static TArray<FBlockNode *> PredictionBlockNodes;
+
 // [GRB] Custom player classes
 TArray<FPlayerClass> PlayerClasses;
 
@@ -1459,6 +1461,7 @@ void P_PredictPlayer (player_t *player)
 
 	// Blockmap ordering also needs to stay the same, so unlink the block nodes
 	// without releasing them. (They will be used again in P_UnpredictPlayer).
+	// The same goes for their entries in the block thing arrays.
 	FBlockNode *block = act->BlockNode;
 
 	while (block != NULL)
@@ -1468,6 +1471,7 @@ void P_PredictPlayer (player_t *player)
 			block->NextActor->PrevActor = block->PrevActor;
 		}
 		*(block->PrevActor) = block->NextActor;
+		act->Level->blockmap.UnlinkThing(block);
 		block = block->NextBlock;
 	}
 	act->BlockNode = NULL;
@@ -1604,6 +1608,7 @@ void P_UnPredictPlayer ()
 		// Now fix the pointers in the blocknode chain
 		FBlockNode *block = act->BlockNode;
 
+		PredictionBlockNodes.Clear();
 		while (block != NULL)
 		{
 			*(block->PrevActor) = block;
@@ -1611,9 +1616,17 @@ void P_UnPredictPlayer ()
 			{
 				block->NextActor->PrevActor = &block->NextActor;
 			}
+			PredictionBlockNodes.Push(block);
 			block = block->NextBlock;
 		}
 
+		// Put the array entries back where they were.
+		bool single = PredictionBlockNodes.Size() == 1;
+		for (auto node : PredictionBlockNodes)
+		{
+			act->Level->blockmap.RelinkThing(node, single);
+		}
+
 		actInvSel = InvSel;
 		player->inventorytics = inventorytics;
 	}
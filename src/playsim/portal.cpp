@@ -123,6 +123,7 @@ void FLevelLocals::BuildPortalBlockmap()
 class FLinePortalTraverse : public FPathTraverse
 {
 	void AddLineIntercepts(int bx, int by);
+	bool CanUseLineTree() const override { return false; }
 
 public:
 	FLinePortalTraverse(FLevelLocals *l) : FPathTraverse(l)
@@ -393,9 +393,11 @@ void RenderFrameModels(FModelRenderer *renderer, FLevelLocals *Level, const FSpr
 
 	TArray<FTextureID> surfaceskinids;
 
-	TArray<VSMatrix> boneData;
+	static const TArray<VSMatrix> noBones;
+	const TArray<VSMatrix>* boneData = nullptr;
 	int boneStartingPosition = 0;
 	bool evaluatedSingle = false;
+	bool bonePrepass = renderer->IsBonePrepass();
 
 	for (unsigned i = 0; i < modelsamount; i++)
 	{
@@ -510,7 +512,7 @@ void RenderFrameModels(FModelRenderer *renderer, FLevelLocals *Level, const FSpr
 		{
 			FModel * mdl = Models[modelid];
 			auto tex = skinid.isValid() ? TexMan.GetGameTexture(skinid, true) : nullptr;
-			mdl->BuildVertexBuffer(renderer);
+			if (!bonePrepass) mdl->BuildVertexBuffer(renderer);
 
 			auto ssidp = surfaceskinids.Size() > 0
 					   ? surfaceskinids.Data()
@@ -521,6 +523,9 @@ void RenderFrameModels(FModelRenderer *renderer, FLevelLocals *Level, const FSpr
 
 			if (actor->boneComponentData == nullptr)
 			{
+				// Objects cannot be created off the main thread, so leave this one to the regular draw.
+				if (bonePrepass) return;
+
 				auto ptr = Create<DBoneComponents>();
 				ptr->trscomponents.Resize(modelsamount);
 				ptr->trsmatrix.Resize(modelsamount);
@@ -531,44 +536,46 @@ void RenderFrameModels(FModelRenderer *renderer, FLevelLocals *Level, const FSpr
 			// [RL0] while per-model animations aren't done, DECOUPLEDANIMATIONS does the same as MODELSAREATTACHMENTS
 			if ((!(smf_flags & MDL_MODELSAREATTACHMENTS) && !is_decoupled) || !evaluatedSingle)
 			{
-				if (animationid >= 0)
+				FModel* animation = animationid >= 0 ? Models[animationid] : mdl;
+				const TArray<TRS>* animationData = animationid >= 0 ? animation->AttachAnimationData() : nullptr;
+
+				bool evaluate = true;
+				FBonePoseKey pose;
+				if(is_decoupled)
+				{
+					pose = { animation, decoupled_main_frame, decoupled_next_frame, decoupled_main_prev_frame, decoupled_next_prev_frame, float(inter), float(inter_main), float(inter_next) };
+					evaluate = decoupled_main_frame != -1;
+				}
+				else
 				{
-					FModel* animation = Models[animationid];
-					const TArray<TRS>* animationData = animation->AttachAnimationData();
+					pose = { animation, modelframe, modelframenext, 0, 0, nextFrame ? float(inter) : -1.f, -1.f, -1.f };
+				}
 
-					if(is_decoupled)
-					{
-						if(decoupled_main_frame != -1)
-						{
-							boneData = animation->CalculateBones(decoupled_main_frame, decoupled_next_frame, inter, decoupled_main_prev_frame, inter_main, decoupled_next_prev_frame, inter_next, animationData, actor->boneComponentData, i);
-						}
-					}
-					else
-					{
-						boneData = animation->CalculateBones(modelframe, modelframenext, nextFrame ? inter : -1.f, 0, -1.f, 0, -1.f, animationData, actor->boneComponentData, i);
-					}
-					boneStartingPosition = renderer->SetupFrame(animation, 0, 0, 0, boneData, -1);
-					evaluatedSingle = true;
+				// Actors in the same animation state share the bones that were uploaded first for it this frame.
+				int sharedPosition = evaluate ? renderer->FindBonePose(pose) : -1;
+				if (sharedPosition >= 0)
+				{
+					boneStartingPosition = renderer->SetupFrame(animation, 0, 0, 0, noBones, sharedPosition);
 				}
 				else
 				{
-					if(is_decoupled)
+					if (evaluate)
 					{
-						if(decoupled_main_frame != -1)
-						{
-							boneData = mdl->CalculateBones(decoupled_main_frame, decoupled_next_frame, inter, decoupled_main_prev_frame, inter_main, decoupled_next_prev_frame, inter_next, nullptr, actor->boneComponentData, i);
-						}
+						boneData = animation->CalculateBones(pose.frame1, pose.frame2, pose.inter, pose.frame1_prev, pose.inter1_prev, pose.frame2_prev, pose.inter2_prev, animationData, actor->boneComponentData, i);
 					}
-					else
+					boneStartingPosition = renderer->SetupFrame(animation, 0, 0, 0, boneData ? *boneData : noBones, -1);
+					if (evaluate && boneStartingPosition >= 0)
 					{
-						boneData = mdl->CalculateBones(modelframe, modelframenext, nextFrame ? inter : -1.f, 0, -1.f, 0, -1.f, nullptr, actor->boneComponentData, i);
+						renderer->AddBonePose(pose, boneStartingPosition);
 					}
-					boneStartingPosition = renderer->SetupFrame(mdl, 0, 0, 0, boneData, -1);
-					evaluatedSingle = true;
 				}
+				evaluatedSingle = true;
 			}
 
-			mdl->RenderFrame(renderer, tex, modelframe, nextFrame ? modelframenext : modelframe, nextFrame ? inter : -1.f, translation, ssidp, boneData, boneStartingPosition);
+			if (!bonePrepass)
+			{
+				mdl->RenderFrame(renderer, tex, modelframe, nextFrame ? modelframenext : modelframe, nextFrame ? inter : -1.f, translation, ssidp, boneData ? *boneData : noBones, boneStartingPosition);
+			}
 		}
 	}
 }
@@ -42,6 +42,14 @@
 #include "serialize_obj.h"
 #include "g_levellocals.h"
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__i386__) || defined(__amd64__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <emmintrin.h>
+#define INTERPOLATE_SSE2
+#endif
+
 //==========================================================================
 //
 //
@@ -65,6 +73,7 @@ public:
 	DSectorPlaneInterpolation(sector_t *sector, bool plane, bool attach);
 	void UnlinkFromMap() override;
 	void UpdateInterpolation();
+	void Capture(FInterpolator &interpolator);
 	void Restore();
 	void Interpolate(double smoothratio);
 	
@@ -84,7 +93,6 @@ class DSectorScrollInterpolation : public DInterpolation
 
 	sector_t *sector;
 	double oldx, oldy;
-	double bakx, baky;
 	bool ceiling;
 
 public:
@@ -93,8 +101,7 @@ public:
 	DSectorScrollInterpolation(sector_t *sector, bool plane);
 	void UnlinkFromMap() override;
 	void UpdateInterpolation();
-	void Restore();
-	void Interpolate(double smoothratio);
+	void Capture(FInterpolator &interpolator);
 	
 	virtual void Serialize(FSerializer &arc);
 };
@@ -113,7 +120,6 @@ class DWallScrollInterpolation : public DInterpolation
 	side_t *side;
 	int part;
 	double oldx, oldy;
-	double bakx, baky;
 
 public:
 
@@ -121,8 +127,7 @@ public:
 	DWallScrollInterpolation(side_t *side, int part);
 	void UnlinkFromMap() override;
 	void UpdateInterpolation();
-	void Restore();
-	void Interpolate(double smoothratio);
+	void Capture(FInterpolator &interpolator);
 	
 	virtual void Serialize(FSerializer &arc);
 };
@@ -148,6 +153,7 @@ public:
 	DPolyobjInterpolation(FPolyObj *poly);
 	void UnlinkFromMap() override;
 	void UpdateInterpolation();
+	void Capture(FInterpolator &interpolator);
 	void Restore();
 	void Interpolate(double smoothratio);
 	
@@ -201,6 +207,7 @@ void FInterpolator::UpdateInterpolations()
 	{
 		probe->UpdateInterpolation ();
 	}
+	InvalidateCapture();
 }
 
 //==========================================================================
@@ -215,6 +222,7 @@ void FInterpolator::AddInterpolation(DInterpolation *interp)
 	if (Head != nullptr) Head->Prev = interp;
 	interp->Prev = nullptr;
 	Head = interp;
+	InvalidateCapture();
 }
 
 //==========================================================================
@@ -237,6 +245,9 @@ void FInterpolator::RemoveInterpolation(DInterpolation *interp)
 	}
 	interp->Next = nullptr;
 	interp->Prev = nullptr;
+
+	// Interpolations that destroy themselves while being captured were never added
+	if (captured) InvalidateCapture();
 }
 
 //==========================================================================
@@ -255,13 +266,84 @@ void FInterpolator::DoInterpolations(double smoothratio)
 
 	didInterp = true;
 
+	// Nothing moves between tics, so what needs interpolating is only collected once per tic
+	if (!captured)
+	{
+		CaptureInterpolations();
+	}
+
+	LerpScrolls(smoothratio);
+	for (auto interp : Moving)
+	{
+		interp->Interpolate(smoothratio);
+	}
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FInterpolator::CaptureInterpolations()
+{
+	InvalidateCapture();
+
 	DInterpolation *probe = Head;
 	while (probe != nullptr)
 	{
 		DInterpolation *next = probe->Next;
-		probe->Interpolate(smoothratio);
+		probe->Capture(*this);
 		probe = next;
 	}
+	ScrollValues.Resize(ScrollOffsets.Size());
+	captured = true;
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FInterpolator::AddMovingScroll(double *offset, double start, double end)
+{
+	ScrollOffsets.Push(offset);
+	ScrollStart.Push(start);
+	ScrollDelta.Push(end - start);
+	ScrollEnd.Push(end);
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FInterpolator::LerpScrolls(double smoothratio)
+{
+	unsigned count = ScrollOffsets.Size();
+	const double *start = ScrollStart.Data();
+	const double *delta = ScrollDelta.Data();
+	double *values = ScrollValues.Data();
+	unsigned i = 0;
+
+#ifdef INTERPOLATE_SSE2
+	__m128d t = _mm_set1_pd(smoothratio);
+	for (; i + 2 <= count; i += 2)
+	{
+		_mm_storeu_pd(values + i, _mm_add_pd(_mm_loadu_pd(start + i), _mm_mul_pd(_mm_loadu_pd(delta + i), t)));
+	}
+#endif
+	for (; i < count; i++)
+	{
+		values[i] = start[i] + delta[i] * smoothratio;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		*ScrollOffsets[i] = values[i];
+	}
 }
 
 //==========================================================================
@@ -275,9 +357,13 @@ void FInterpolator::RestoreInterpolations()
 	if (didInterp)
 	{
 		didInterp = false;
-		for (DInterpolation *probe = Head; probe != nullptr; probe = probe->Next)
+		for (unsigned i = 0; i < ScrollOffsets.Size(); i++)
+		{
+			*ScrollOffsets[i] = ScrollEnd[i];
+		}
+		for (auto interp : Moving)
 		{
-			probe->Restore();
+			interp->Restore();
 		}
 	}
 }
@@ -288,10 +374,27 @@ void FInterpolator::RestoreInterpolations()
 //
 //==========================================================================
 
+void FInterpolator::InvalidateCapture()
+{
+	captured = false;
+	ScrollOffsets.Clear();
+	ScrollStart.Clear();
+	ScrollDelta.Clear();
+	ScrollEnd.Clear();
+	Moving.Clear();
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
 void FInterpolator::ClearInterpolations()
 {
 	DInterpolation *probe = Head;
 	Head = nullptr;
+	InvalidateCapture();
 
 	while (probe != nullptr)
 	{
@@ -310,6 +413,7 @@ FSerializer &Serialize(FSerializer &arc, const char *key, FInterpolator &rs, FIn
 	{
 		arc("head", rs.Head)
 			.EndObject();
+		if (arc.isReading()) rs.InvalidateCapture();
 	}
 	return arc;
 }
@@ -479,6 +583,29 @@ void DSectorPlaneInterpolation::Restore()
 //
 //==========================================================================
 
+void DSectorPlaneInterpolation::Capture(FInterpolator &interpolator)
+{
+	int pos = ceiling ? sector_t::ceiling : sector_t::floor;
+	bakheight = ceiling ? sector->ceilingplane.fD() : sector->floorplane.fD();
+	baktexz = sector->GetPlaneTexZ(pos);
+
+	if (refcount == 0 && oldheight == bakheight)
+	{
+		UnlinkFromMap();
+		Destroy();
+	}
+	else if (oldheight != bakheight || oldtexz != baktexz)
+	{
+		interpolator.AddMoving(this);
+	}
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
 void DSectorPlaneInterpolation::Interpolate(double smoothratio)
 {
 	secplane_t *pplane;
@@ -495,21 +622,10 @@ void DSectorPlaneInterpolation::Interpolate(double smoothratio)
 		pos = sector_t::ceiling;
 	}
 
-	bakheight = pplane->fD();
-	baktexz = sector->GetPlaneTexZ(pos);
-
-	if (refcount == 0 && oldheight == bakheight)
-	{
-		UnlinkFromMap();
-		Destroy();
-	}
-	else
-	{
-		pplane->setD(oldheight + (bakheight - oldheight) * smoothratio);
-		sector->SetPlaneTexZ(pos, oldtexz + (baktexz - oldtexz) * smoothratio, true);
-		P_RecalculateAttached3DFloors(sector);
-		sector->CheckPortalPlane(pos);
-	}
+	pplane->setD(oldheight + (bakheight - oldheight) * smoothratio);
+	sector->SetPlaneTexZ(pos, oldtexz + (baktexz - oldtexz) * smoothratio, true);
+	P_RecalculateAttached3DFloors(sector);
+	sector->CheckPortalPlane(pos);
 }
 
 //==========================================================================
@@ -606,22 +722,10 @@ void DSectorScrollInterpolation::UpdateInterpolation()
 //
 //==========================================================================
 
-void DSectorScrollInterpolation::Restore()
-{
-	sector->SetXOffset(ceiling, bakx);
-	sector->SetYOffset(ceiling, baky);
-}
-
-//==========================================================================
-//
-//
-//
-//==========================================================================
-
-void DSectorScrollInterpolation::Interpolate(double smoothratio)
+void DSectorScrollInterpolation::Capture(FInterpolator &interpolator)
 {
-	bakx = sector->GetXOffset(ceiling);
-	baky = sector->GetYOffset(ceiling, false);
+	double bakx = sector->GetXOffset(ceiling);
+	double baky = sector->GetYOffset(ceiling, false);
 
 	if (refcount == 0 && oldx == bakx && oldy == baky)
 	{
@@ -630,8 +734,9 @@ void DSectorScrollInterpolation::Interpolate(double smoothratio)
 	}
 	else
 	{
-		sector->SetXOffset(ceiling, oldx + (bakx - oldx) * smoothratio);
-		sector->SetYOffset(ceiling, oldy + (baky - oldy) * smoothratio);
+		auto &xform = sector->planes[ceiling].xform;
+		if (oldx != bakx) interpolator.AddMovingScroll(&xform.xOffs, oldx, bakx);
+		if (oldy != baky) interpolator.AddMovingScroll(&xform.yOffs, oldy, baky);
 	}
 }
 
@@ -706,22 +811,10 @@ void DWallScrollInterpolation::UpdateInterpolation()
 //
 //==========================================================================
 
-void DWallScrollInterpolation::Restore()
+void DWallScrollInterpolation::Capture(FInterpolator &interpolator)
 {
-	side->SetTextureXOffset(part, bakx);
-	side->SetTextureYOffset(part, baky);
-}
-
-//==========================================================================
-//
-//
-//
-//==========================================================================
-
-void DWallScrollInterpolation::Interpolate(double smoothratio)
-{
-	bakx = side->GetTextureXOffset(part);
-	baky = side->GetTextureYOffset(part);
+	double bakx = side->GetTextureXOffset(part);
+	double baky = side->GetTextureYOffset(part);
 
 	if (refcount == 0 && oldx == bakx && oldy == baky)
 	{
@@ -730,8 +823,8 @@ void DWallScrollInterpolation::Interpolate(double smoothratio)
 	}
 	else
 	{
-		side->SetTextureXOffset(part, oldx + (bakx - oldx) * smoothratio);
-		side->SetTextureYOffset(part, oldy + (baky - oldy) * smoothratio);
+		if (oldx != bakx) interpolator.AddMovingScroll(&side->textures[part].xOffset, oldx, bakx);
+		if (oldy != baky) interpolator.AddMovingScroll(&side->textures[part].yOffset, oldy, baky);
 	}
 }
 
@@ -827,7 +920,7 @@ void DPolyobjInterpolation::Restore()
 //
 //==========================================================================
 
-void DPolyobjInterpolation::Interpolate(double smoothratio)
+void DPolyobjInterpolation::Capture(FInterpolator &interpolator)
 {
 	bool changed = false;
 	for(unsigned int i = 0; i < poly->Vertices.Size(); i++)
@@ -838,25 +931,43 @@ void DPolyobjInterpolation::Interpolate(double smoothratio)
 		if (bakverts[i * 2] != oldverts[i * 2] || bakverts[i * 2 + 1] != oldverts[i * 2 + 1])
 		{
 			changed = true;
-			poly->Vertices[i]->set(
-				oldverts[i * 2] + (bakverts[i * 2] - oldverts[i * 2]) * smoothratio,
-				oldverts[i * 2 + 1] + (bakverts[i * 2 + 1] - oldverts[i * 2 + 1]) * smoothratio);
 		}
 	}
+	bakcx = poly->CenterSpot.pos.X;
+	bakcy = poly->CenterSpot.pos.Y;
+
 	if (refcount == 0 && !changed)
 	{
 		UnlinkFromMap();
 		Destroy();
 	}
-	else
+	else if (changed || bakcx != oldcx || bakcy != oldcy)
 	{
-		bakcx = poly->CenterSpot.pos.X;
-		bakcy = poly->CenterSpot.pos.Y;
-		poly->CenterSpot.pos.X = bakcx + (bakcx - oldcx) * smoothratio;
-		poly->CenterSpot.pos.Y = bakcy + (bakcy - oldcy) * smoothratio;
+		interpolator.AddMoving(this);
+	}
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
 
-		poly->ClearSubsectorLinks();
+void DPolyobjInterpolation::Interpolate(double smoothratio)
+{
+	for(unsigned int i = 0; i < poly->Vertices.Size(); i++)
+	{
+		if (bakverts[i * 2] != oldverts[i * 2] || bakverts[i * 2 + 1] != oldverts[i * 2 + 1])
+		{
+			poly->Vertices[i]->set(
+				oldverts[i * 2] + (bakverts[i * 2] - oldverts[i * 2]) * smoothratio,
+				oldverts[i * 2 + 1] + (bakverts[i * 2 + 1] - oldverts[i * 2 + 1]) * smoothratio);
+		}
 	}
+	poly->CenterSpot.pos.X = bakcx + (bakcx - oldcx) * smoothratio;
+	poly->CenterSpot.pos.Y = bakcy + (bakcy - oldcy) * smoothratio;
+
+	poly->ClearSubsectorLinks();
 }
 
 //==========================================================================
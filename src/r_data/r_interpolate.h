@@ -4,6 +4,7 @@
 #include "dobject.h"
 
 struct FLevelLocals;
+struct FInterpolator;
 //==========================================================================
 //
 //
@@ -32,8 +33,11 @@ public:
 
 	virtual void UnlinkFromMap();
 	virtual void UpdateInterpolation() = 0;
-	virtual void Restore() = 0;
-	virtual void Interpolate(double smoothratio) = 0;
+
+	// Records where this tic's movement ended and registers anything that moved with the interpolator
+	virtual void Capture(FInterpolator &interpolator) = 0;
+	virtual void Restore() {}
+	virtual void Interpolate(double smoothratio) {}
 	
 	virtual void Serialize(FSerializer &arc);
 };
@@ -48,9 +52,18 @@ struct FInterpolator
 {
 	TObjPtr<DInterpolation*> Head = MakeObjPtr<DInterpolation*>(nullptr);
 	bool didInterp = false;
+	bool captured = false;
 	int count = 0;
 
+	// What moved during the last tic, collected by the first interpolated frame after it.
+	// Scroll offsets are plain values and get lerped in bulk, everything else is visited through Moving.
+	TArray<double *> ScrollOffsets;
+	TArray<double> ScrollStart, ScrollDelta, ScrollEnd, ScrollValues;
+	TArray<DInterpolation *> Moving;
+
 	int CountInterpolations ();
+	void CaptureInterpolations();
+	void LerpScrolls(double smoothratio);
 
 public:
 	void UpdateInterpolations();
@@ -59,6 +72,10 @@ public:
 	void DoInterpolations(double smoothratio);
 	void RestoreInterpolations();
 	void ClearInterpolations();
+	void InvalidateCapture();
+
+	void AddMovingScroll(double *offset, double start, double end);
+	void AddMoving(DInterpolation *interp) { Moving.Push(interp); }
 };
 
 
@@ -43,8 +43,15 @@
 #include "hwrenderer/scene/hw_portal.h"
 #include "hw_bonebuffer.h"
 #include "hw_models.h"
+#include "ctpl.h"
+#include <mutex>
+#include <thread>
+#include <vector>
 
 CVAR(Bool, gl_light_models, true, CVAR_ARCHIVE)
+CVAR(Bool, gl_shareboneposes, true, CVAR_ARCHIVE)
+CVAR(Bool, gl_parallelbones, true, CVAR_ARCHIVE)
+CVAR(Bool, gl_modelinstancing, true, CVAR_ARCHIVE)
 
 VSMatrix FHWModelRenderer::GetViewToWorldMatrix()
 {
@@ -141,9 +148,16 @@ void FHWModelRenderer::DrawElements(int numIndices, size_t offset)
 int FHWModelRenderer::SetupFrame(FModel *model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex)
 {
 	auto mdbuff = static_cast<FModelVertexBuffer*>(model->GetVertexBuffer(GetType()));
-	screen->mBones->Map();
-	boneIndexBase = boneStartIndex >= 0 ? boneStartIndex : screen->mBones->UploadBones(bones);
-	screen->mBones->Unmap();
+	if (boneStartIndex >= 0)
+	{
+		boneIndexBase = boneStartIndex;
+	}
+	else
+	{
+		screen->mBones->Map();
+		boneIndexBase = screen->mBones->UploadBones(bones);
+		screen->mBones->Unmap();
+	}
 	state.SetBoneIndexBase(boneIndexBase);
 	if (mdbuff)
 	{
@@ -153,3 +167,319 @@ int FHWModelRenderer::SetupFrame(FModel *model, unsigned int frame1, unsigned in
 	return boneIndexBase;
 }
 
+//===========================================================================
+//
+// Bone poses uploaded during the current frame.
+// Only valid as long as the bone buffer has not moved on to the next frame.
+//
+//===========================================================================
+
+static std::mutex BonePoseMutex;
+static TMap<FBonePoseKey, int> BonePoses;
+static unsigned int BonePoseGeneration;
+
+static int FindSharedBonePose(const FBonePoseKey& key)
+{
+	if (!gl_shareboneposes) return -1;
+
+	std::lock_guard<std::mutex> lock(BonePoseMutex);
+	if (BonePoseGeneration != screen->mBones->GetRing().GetGeneration()) return -1;
+	auto check = BonePoses.CheckKey(key);
+	return check ? *check : -1;
+}
+
+static void AddSharedBonePose(const FBonePoseKey& key, int boneStartIndex)
+{
+	if (!gl_shareboneposes) return;
+
+	std::lock_guard<std::mutex> lock(BonePoseMutex);
+	unsigned int generation = screen->mBones->GetRing().GetGeneration();
+	if (BonePoseGeneration != generation)
+	{
+		BonePoses.Clear();
+		BonePoseGeneration = generation;
+	}
+	BonePoses.Insert(key, boneStartIndex);
+}
+
+int FHWModelRenderer::FindBonePose(const FBonePoseKey& key)
+{
+	return FindSharedBonePose(key);
+}
+
+void FHWModelRenderer::AddBonePose(const FBonePoseKey& key, int boneStartIndex)
+{
+	AddSharedBonePose(key, boneStartIndex);
+}
+
+//===========================================================================
+//
+// Bone prepass
+//
+//===========================================================================
+
+int FHWBonePrepass::SetupFrame(FModel *model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex)
+{
+	return boneStartIndex >= 0 ? boneStartIndex : screen->mBones->UploadBones(bones);
+}
+
+int FHWBonePrepass::FindBonePose(const FBonePoseKey& key)
+{
+	return FindSharedBonePose(key);
+}
+
+void FHWBonePrepass::AddBonePose(const FBonePoseKey& key, int boneStartIndex)
+{
+	AddSharedBonePose(key, boneStartIndex);
+}
+
+//===========================================================================
+//
+// Evaluates the skeletons of the given actors on the worker pool so that
+// the draw pass only has to look up the uploaded poses.
+// Must be called while the bone buffer is mapped.
+//
+//===========================================================================
+
+void HWPrepareModelBones(TArray<AActor*>& actors, TArray<FSpriteModelFrame*>& frames)
+{
+	if (!gl_parallelbones || !gl_shareboneposes || actors.Size() < 2) return;
+
+	static std::unique_ptr<ctpl::thread_pool> bonePool;
+	if (bonePool == nullptr)
+	{
+		int numthreads = clamp((int)std::thread::hardware_concurrency() - 1, 1, 8);
+		bonePool.reset(new ctpl::thread_pool(numthreads));
+	}
+
+	std::atomic<unsigned int> next(0);
+	auto work = [&](int)
+	{
+		FHWBonePrepass prepass;
+		unsigned int i;
+		while ((i = next++) < actors.Size())
+		{
+			AActor* actor = actors[i];
+			RenderFrameModels(&prepass, actor->Level, frames[i], actor->state, actor->tics, NO_TRANSLATION, actor);
+		}
+	};
+
+	std::vector<std::future<void>> futures;
+	int helpers = min(bonePool->size(), (int)actors.Size() - 1);
+	for (int n = 0; n < helpers; n++)
+	{
+		futures.push_back(bonePool->push(work));
+	}
+	work(0);
+	for (auto& future : futures) future.wait();
+}
+
+//===========================================================================
+//
+// Model instancing
+//
+//===========================================================================
+
+bool HWModelInstancingActive(FRenderState &state)
+{
+	return gl_modelinstancing && state.SupportsInstancing();
+}
+
+FModelDrawCommand &FHWModelRecorder::NewCommand(int type)
+{
+	FModelDrawCommand cmd = {};
+	cmd.type = type;
+	commands.Push(cmd);
+	return commands.Last();
+}
+
+void FHWModelRecorder::BeginDrawModel(FRenderStyle style, int smf_flags, const VSMatrix &objectToWorldMatrix, bool mirrored)
+{
+	this->style = style;
+	this->smf_flags = smf_flags;
+	this->objectToWorldMatrix = objectToWorldMatrix;
+	this->mirrored = mirrored;
+}
+
+IModelVertexBuffer *FHWModelRecorder::CreateVertexBuffer(bool needindex, bool singleframe)
+{
+	return new FModelVertexBuffer(needindex, singleframe);
+}
+
+VSMatrix FHWModelRecorder::GetViewToWorldMatrix()
+{
+	VSMatrix objectToWorldMatrix;
+	di->VPUniforms.mViewMatrix.inverseMatrix(objectToWorldMatrix);
+	return objectToWorldMatrix;
+}
+
+void FHWModelRecorder::SetInterpolation(double inter)
+{
+	currentInterpolation = (float)inter;
+}
+
+void FHWModelRecorder::SetMaterial(FGameTexture *skin, bool clampNoFilter, FTranslationID translation)
+{
+	auto &cmd = NewCommand(FModelDrawCommand::SetMaterial);
+	cmd.skin = skin;
+	cmd.clampNoFilter = clampNoFilter;
+	cmd.translation = translation;
+}
+
+void FHWModelRecorder::AddDraw(int type, int start, int count)
+{
+	// There is only one interpolation factor per instance.
+	if (!hasInterpolation)
+	{
+		interpolation = currentInterpolation;
+		hasInterpolation = true;
+	}
+	else if (interpolation != currentInterpolation)
+	{
+		instanceable = false;
+	}
+
+	auto &cmd = NewCommand(type);
+	cmd.start = start;
+	cmd.count = count;
+}
+
+void FHWModelRecorder::DrawArrays(int start, int count)
+{
+	AddDraw(FModelDrawCommand::DrawArrays, start, count);
+}
+
+void FHWModelRecorder::DrawElements(int numIndices, size_t offset)
+{
+	AddDraw(FModelDrawCommand::DrawElements, int(offset / sizeof(unsigned int)), numIndices);
+}
+
+int FHWModelRecorder::SetupFrame(FModel *model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex)
+{
+	if (boneStartIndex >= 0 || bones.Size() > 0)
+	{
+		// Skeletal models are drawn one by one. Upload the bones anyway so that the regular draw finds them.
+		instanceable = false;
+		if (boneStartIndex >= 0) return boneStartIndex;
+
+		screen->mBones->Map();
+		int index = screen->mBones->UploadBones(bones);
+		screen->mBones->Unmap();
+		return index;
+	}
+
+	auto &cmd = NewCommand(FModelDrawCommand::SetupFrame);
+	auto mdbuff = static_cast<FModelVertexBuffer*>(model->GetVertexBuffer(GetType()));
+	if (mdbuff)
+	{
+		cmd.vertexBuffer = mdbuff->vertexBuffer();
+		cmd.indexBuffer = mdbuff->indexBuffer();
+	}
+	cmd.frame1 = frame1;
+	cmd.frame2 = frame2;
+	return -1;
+}
+
+int FHWModelRecorder::FindBonePose(const FBonePoseKey& key)
+{
+	return FindSharedBonePose(key);
+}
+
+void FHWModelRecorder::AddBonePose(const FBonePoseKey& key, int boneStartIndex)
+{
+	AddSharedBonePose(key, boneStartIndex);
+}
+
+//===========================================================================
+//
+// Draws all instances of a batch. The caller has already set up
+// the render state the sprites have in common.
+//
+//===========================================================================
+
+static void ReplayModelCommands(FRenderState &state, const FModelInstanceBatch &batch, int numinstances)
+{
+	for (auto &cmd : batch.commands)
+	{
+		switch (cmd.type)
+		{
+		case FModelDrawCommand::SetMaterial:
+			state.SetMaterial(cmd.skin, UF_Skin, 0, cmd.clampNoFilter ? CLAMP_NOFILTER : CLAMP_NONE, cmd.translation, -1);
+			state.SetLightIndex(-1);
+			break;
+
+		case FModelDrawCommand::SetupFrame:
+			if (cmd.vertexBuffer)
+			{
+				state.SetVertexBuffer(cmd.vertexBuffer, cmd.frame1, cmd.frame2);
+				if (cmd.indexBuffer) state.SetIndexBuffer(cmd.indexBuffer);
+			}
+			break;
+
+		case FModelDrawCommand::DrawArrays:
+			if (numinstances > 0) state.DrawInstanced(DT_Triangles, cmd.start, cmd.count, numinstances);
+			else state.Draw(DT_Triangles, cmd.start, cmd.count);
+			break;
+
+		case FModelDrawCommand::DrawElements:
+			if (numinstances > 0) state.DrawIndexedInstanced(DT_Triangles, cmd.start, cmd.count, numinstances);
+			else state.DrawIndexed(DT_Triangles, cmd.start, cmd.count);
+			break;
+		}
+	}
+}
+
+void HWDrawModelInstances(HWDrawInfo *di, FRenderState &state, const FModelInstanceBatch &batch)
+{
+	int numinstances = batch.instanceData.Size() / INSTANCE_DATA_SIZE;
+	int maxinstances = max(1, int(screen->mBones->GetMaxUploadSize() / INSTANCE_DATA_SIZE));
+	bool culling = (batch.smf_flags & MDL_FORCECULLBACKFACES) || (!(batch.style == DefaultRenderStyle()) && !(batch.smf_flags & MDL_DONTCULLBACKFACES));
+
+	// Same setup as FHWModelRenderer::BeginDrawModel.
+	state.SetDepthFunc(DF_LEqual);
+	state.EnableTexture(true);
+	if (culling)
+	{
+		state.SetCulling((batch.mirrored ^ portalState.isMirrored()) ? Cull_CCW : Cull_CW);
+	}
+	state.mModelMatrix = batch.instanceData[0];
+	state.EnableModelMatrix(true);
+	state.SetBoneIndexBase(-1);
+
+	for (int first = 0; first < numinstances; first += maxinstances)
+	{
+		int count = min(numinstances - first, maxinstances);
+		const VSMatrix *data = &batch.instanceData[first * INSTANCE_DATA_SIZE];
+
+		screen->mBones->Map();
+		int index = screen->mBones->UploadBones(data, count * INSTANCE_DATA_SIZE);
+		screen->mBones->Unmap();
+
+		if (index >= 0)
+		{
+			state.SetInstanceIndexBase(index);
+			ReplayModelCommands(state, batch, count);
+			state.SetInstanceIndexBase(-1);
+		}
+		else
+		{
+			// The bone buffer is full, so draw this part of the batch one model at a time.
+			for (int i = 0; i < count; i++)
+			{
+				state.mModelMatrix = data[i * INSTANCE_DATA_SIZE];
+				state.SetInterpolationFactor((float)data[i * INSTANCE_DATA_SIZE + 1].get()[15]);
+				ReplayModelCommands(state, batch, 0);
+			}
+			state.SetInterpolationFactor(0.f);
+		}
+	}
+
+	// Same cleanup as FHWModelRenderer::EndDrawModel.
+	state.EnableModelMatrix(false);
+	state.SetDepthFunc(DF_Less);
+	if (culling)
+	{
+		state.SetCulling(Cull_None);
+	}
+}
+
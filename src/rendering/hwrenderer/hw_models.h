@@ -57,6 +57,126 @@ public:
 	void DrawArrays(int start, int count) override;
 	void DrawElements(int numIndices, size_t offset) override;
 	int SetupFrame(FModel *model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex) override;
+	int FindBonePose(const FBonePoseKey& key) override;
+	void AddBonePose(const FBonePoseKey& key, int boneStartIndex) override;
 
 };
 
+//===========================================================================
+//
+// Evaluates and uploads the bones of a model without drawing anything.
+// This is used to compute the skeletons of visible actors in parallel
+// before the draw lists get rendered. The bone buffer must be mapped.
+//
+//===========================================================================
+
+class FHWBonePrepass : public FModelRenderer
+{
+public:
+	ModelRendererType GetType() const override { return GLModelRendererType; }
+	void BeginDrawModel(FRenderStyle style, int smf_flags, const VSMatrix &objectToWorldMatrix, bool mirrored) override {}
+	void EndDrawModel(FRenderStyle style, int smf_flags) override {}
+	IModelVertexBuffer *CreateVertexBuffer(bool needindex, bool singleframe) override { return nullptr; }
+	VSMatrix GetViewToWorldMatrix() override { return VSMatrix(0); }
+	void BeginDrawHUDModel(FRenderStyle style, const VSMatrix &objectToWorldMatrix, bool mirrored, int smf_flags) override {}
+	void EndDrawHUDModel(FRenderStyle style, int smf_flags) override {}
+	void SetInterpolation(double interpolation) override {}
+	void SetMaterial(FGameTexture *skin, bool clampNoFilter, FTranslationID translation) override {}
+	void DrawArrays(int start, int count) override {}
+	void DrawElements(int numIndices, size_t offset) override {}
+	int SetupFrame(FModel *model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex) override;
+	int FindBonePose(const FBonePoseKey& key) override;
+	void AddBonePose(const FBonePoseKey& key, int boneStartIndex) override;
+	bool IsBonePrepass() const override { return true; }
+};
+
+void HWPrepareModelBones(TArray<AActor*>& actors, TArray<FSpriteModelFrame*>& frames);
+
+//===========================================================================
+//
+// Model instancing
+//
+//===========================================================================
+
+// One renderer call of a model, as recorded for instanced drawing.
+struct FModelDrawCommand
+{
+	enum
+	{
+		SetMaterial,
+		SetupFrame,
+		DrawArrays,
+		DrawElements
+	};
+
+	int type;
+	FGameTexture *skin;
+	FTranslationID translation;
+	bool clampNoFilter;
+	IVertexBuffer *vertexBuffer;
+	IIndexBuffer *indexBuffer;
+	unsigned int frame1, frame2;
+	int start, count;
+
+	bool operator==(const FModelDrawCommand &other) const
+	{
+		return type == other.type && skin == other.skin && translation == other.translation && clampNoFilter == other.clampNoFilter &&
+			vertexBuffer == other.vertexBuffer && indexBuffer == other.indexBuffer && frame1 == other.frame1 && frame2 == other.frame2 &&
+			start == other.start && count == other.count;
+	}
+};
+
+// Records what a model would draw instead of drawing it, so that identical models can be drawn together.
+class FHWModelRecorder : public FModelRenderer
+{
+	HWDrawInfo *di;
+	TArray<FModelDrawCommand> &commands;
+	float currentInterpolation = 0;
+	bool hasInterpolation = false;
+
+	FModelDrawCommand &NewCommand(int type);
+	void AddDraw(int type, int start, int count);
+
+public:
+	VSMatrix objectToWorldMatrix;
+	FRenderStyle style;
+	int smf_flags = 0;
+	bool mirrored = false;
+	float interpolation = 0;
+	bool instanceable = true;
+
+	FHWModelRecorder(HWDrawInfo *d, TArray<FModelDrawCommand> &cmds) : di(d), commands(cmds)
+	{}
+	ModelRendererType GetType() const override { return GLModelRendererType; }
+	void BeginDrawModel(FRenderStyle style, int smf_flags, const VSMatrix &objectToWorldMatrix, bool mirrored) override;
+	void EndDrawModel(FRenderStyle style, int smf_flags) override {}
+	IModelVertexBuffer *CreateVertexBuffer(bool needindex, bool singleframe) override;
+	VSMatrix GetViewToWorldMatrix() override;
+	void BeginDrawHUDModel(FRenderStyle style, const VSMatrix &objectToWorldMatrix, bool mirrored, int smf_flags) override { instanceable = false; }
+	void EndDrawHUDModel(FRenderStyle style, int smf_flags) override {}
+	void SetInterpolation(double interpolation) override;
+	void SetMaterial(FGameTexture *skin, bool clampNoFilter, FTranslationID translation) override;
+	void DrawArrays(int start, int count) override;
+	void DrawElements(int numIndices, size_t offset) override;
+	int SetupFrame(FModel *model, unsigned int frame1, unsigned int frame2, unsigned int size, const TArray<VSMatrix>& bones, int boneStartIndex) override;
+	int FindBonePose(const FBonePoseKey& key) override;
+	void AddBonePose(const FBonePoseKey& key, int boneStartIndex) override;
+};
+
+// Models that draw the same way and only differ in placement and interpolation.
+struct FModelInstanceBatch
+{
+	TArray<FModelDrawCommand> commands;
+	FRenderStyle style;
+	int smf_flags;
+	bool mirrored;
+	FVector3 dynlight;
+	HWSprite *sprite;					// the sprite whose state setup gets used for all instances
+	TArray<VSMatrix> instanceData;		// INSTANCE_DATA_SIZE matrices per instance
+	int nextSameHash;
+	bool drawn;
+};
+
+bool HWModelInstancingActive(FRenderState &state);
+void HWDrawModelInstances(HWDrawInfo *di, FRenderState &state, const FModelInstanceBatch &batch);
+
@@ -42,6 +42,7 @@
 #include "flatvertices.h"
 #include "hw_lightbuffer.h"
 #include "hw_bonebuffer.h"
+#include "hw_models.h"
 #include "hw_vrmodes.h"
 #include "hw_clipper.h"
 #include "v_draw.h"
@@ -427,6 +428,41 @@ HWDecal *HWDrawInfo::AddDecal(bool onmirror)
 	return decal;
 }
 
+//-----------------------------------------------------------------------------
+//
+// Evaluates the skeletons of all visible models up front, so that
+// the draw pass only needs to bind the uploaded bones.
+//
+//-----------------------------------------------------------------------------
+
+void HWDrawInfo::PrepareModelBones()
+{
+	static TArray<AActor*> actors;
+	static TArray<FSpriteModelFrame*> frames;
+	static TMap<AActor*, bool> collected;
+
+	actors.Clear();
+	frames.Clear();
+	collected.Clear();
+
+	for (int list : { GLDL_MODELS, GLDL_TRANSLUCENT })
+	{
+		for (auto spr : drawlists[list].sprites)
+		{
+			AActor* actor = spr->actor;
+			// Actors that were never drawn as a model have no bone data yet and cannot get it off the main thread.
+			if (spr->modelframe == nullptr || actor == nullptr || actor->boneComponentData == nullptr) continue;
+			if ((actor->flags9 & MF9_DECOUPLEDANIMATIONS) && BaseSpriteModelFrames.CheckKey(actor->GetClass()) == nullptr) continue;
+			if (collected.CheckKey(actor)) continue;
+
+			collected.Insert(actor, true);
+			actors.Push(actor);
+			frames.Push(spr->modelframe);
+		}
+	}
+	HWPrepareModelBones(actors, frames);
+}
+
 //-----------------------------------------------------------------------------
 //
 // CreateScene
@@ -461,6 +497,7 @@ void HWDrawInfo::CreateScene(bool drawpsprites)
 	HandleHackedSubsectors();	// open sector hacks for deep water
 	PrepareUnhandledMissingTextures();
 	DispatchRenderHacks();
+	PrepareModelBones();
 	screen->mLights->Unmap();
 	screen->mBones->Unmap();
 	screen->mVertexData->Unmap();
@@ -520,7 +557,7 @@ void HWDrawInfo::RenderScene(FRenderState &state)
 		state.ClearDepthBias();
 	}
 
-	drawlists[GLDL_MODELS].Draw(this, state, false);
+	drawlists[GLDL_MODELS].DrawModels(this, state);
 
 	state.SetRenderStyle(STYLE_Translucent);
 
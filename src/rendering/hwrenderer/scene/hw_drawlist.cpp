@@ -38,6 +38,9 @@
 #include "hw_drawinfo.h"
 #include "hw_fakeflat.h"
 #include "hw_walldispatcher.h"
+#include "hw_models.h"
+#include "models.h"
+#include "model_iqm.h"
 
 FMemArena RenderDataAllocator(1024*1024);	// Use large blocks to reduce allocation time.
 
@@ -479,6 +482,7 @@ void HWDrawList::SortWallIntoWall(HWDrawInfo *di, SortNode * head,SortNode * sor
 //
 //==========================================================================
 EXTERN_CVAR(Int, gl_billboard_mode)
+EXTERN_CVAR(Bool, gl_flatbatching)
 EXTERN_CVAR(Bool, gl_billboard_faces_camera)
 EXTERN_CVAR(Bool, hw_force_cambbpref)
 EXTERN_CVAR(Bool, gl_billboard_particles)
@@ -745,11 +749,16 @@ void HWDrawList::SortFlats()
 {
 	if (drawitems.Size() > 1)
 	{
+		bool batching = gl_flatbatching;
 		std::sort(drawitems.begin(), drawitems.end(), [=](const HWDrawItem &a, const HWDrawItem &b)
 		{
 			HWFlat * w1 = flats[a.index];
 			HWFlat* w2 = flats[b.index];
-			return w1->texture < w2->texture;
+			if (!batching) return w1->texture < w2->texture;
+			// keep flats that can share a draw call next to each other.
+			if (w1->texture != w2->texture) return w1->texture < w2->texture;
+			if (w1->lightlevel != w2->lightlevel) return w1->lightlevel < w2->lightlevel;
+			return w1->sector < w2->sector;
 		});
 	}
 }
@@ -868,13 +877,194 @@ void HWDrawList::DrawWalls(HWDrawInfo *di, FRenderState &state, bool translucent
 void HWDrawList::DrawFlats(HWDrawInfo *di, FRenderState &state, bool translucent)
 {
 	RenderFlat.Clock();
-	for (unsigned i = 0; i<drawitems.Size(); i++)
+	for (unsigned i = 0; i<drawitems.Size(); )
 	{
-		flats[drawitems[i].index]->DrawFlat(di, state, translucent);
+		HWFlat *flat = flats[drawitems[i].index];
+		unsigned end = i + 1;
+
+		if (gl_flatbatching && !translucent && flat->IsBatchable(di))
+		{
+			while (end < drawitems.Size())
+			{
+				HWFlat *next = flats[drawitems[end].index];
+				if (!next->IsBatchable(di) || !flat->CanBatchWith(next)) break;
+				end++;
+			}
+		}
+
+		if (end - i == 1)
+		{
+			flat->DrawFlat(di, state, translucent);
+		}
+		else
+		{
+			// The index ranges of all sections are static, so the batch is just a list of them, merged where they are adjacent.
+			int vertexcount = 0;
+			flatranges.Clear();
+			for (unsigned j = i; j < end; j++)
+			{
+				HWFlat *f = flats[drawitems[j].index];
+				int index = f->iboindex + f->section->vertexindex;
+				int count = f->section->vertexcount;
+				vertexcount += count;
+
+				if (flatranges.Size() > 0 && flatranges.Last().index + flatranges.Last().count == index)
+				{
+					flatranges.Last().count += count;
+				}
+				else
+				{
+					flatranges.Push({ index, count });
+				}
+			}
+			flat->DrawFlatBatch(di, state, flatranges.Data(), flatranges.Size(), vertexcount);
+		}
+		i = end;
 	}
 	RenderFlat.Unclock();
 }
 
+//==========================================================================
+//
+// Draws the opaque models. Models that only differ in placement and
+// interpolation get combined into one instanced draw per batch.
+//
+//==========================================================================
+
+static unsigned int HashModelCommands(const TArray<FModelDrawCommand> &commands)
+{
+	unsigned int hash = commands.Size();
+	for (auto &cmd : commands)
+	{
+		hash = hash * 31 + (unsigned int)(uintptr_t)cmd.skin;
+		hash = hash * 31 + (unsigned int)(uintptr_t)cmd.vertexBuffer;
+		hash = hash * 31 + cmd.frame1 + cmd.frame2 * 7 + cmd.start;
+	}
+	return hash;
+}
+
+// Skeletal models and actors with their own model setup are never instanced,
+// so they are rejected here before anything gets recorded for them.
+static bool IsInstanceableModelFrame(FSpriteModelFrame *smf, AActor *actor)
+{
+	if (actor->modelData != nullptr) return false;
+	for (unsigned i = 0; i < smf->modelsAmount; i++)
+	{
+		int id = smf->modelIDs[i];
+		if (id >= 0 && unsigned(id) < Models.Size() && dynamic_cast<IQMModel*>(Models[id]) != nullptr) return false;
+	}
+	return true;
+}
+
+void HWDrawList::DrawModels(HWDrawInfo *di, FRenderState &state)
+{
+	static TArray<FModelInstanceBatch> batches;
+	static TArray<FModelDrawCommand> commands;
+	static TArray<int> itembatch;
+	static TMap<unsigned int, int> batchhash;
+	static TMap<FSpriteModelFrame*, int> framecount;
+
+	if (!HWModelInstancingActive(state) || drawitems.Size() < 2)
+	{
+		Draw(di, state, false);
+		return;
+	}
+
+	batches.Clear();
+	batchhash.Clear();
+	framecount.Clear();
+	itembatch.Resize(drawitems.Size());
+
+	// Only models whose model frame occurs more than once can end up in a batch,
+	// so count the candidates per model frame before recording any of them.
+	for (unsigned i = 0; i < drawitems.Size(); i++)
+	{
+		itembatch[i] = -1;
+		if (drawitems[i].rendertype != DrawType_SPRITE) continue;
+
+		HWSprite *spr = sprites[drawitems[i].index];
+		if (!spr->IsInstanceableModel() || !IsInstanceableModelFrame(spr->modelframe, spr->actor)) continue;
+
+		int *count = framecount.CheckKey(spr->modelframe);
+		if (count) (*count)++;
+		else framecount[spr->modelframe] = 1;
+		itembatch[i] = 0;
+	}
+
+	for (unsigned i = 0; i < drawitems.Size(); i++)
+	{
+		if (itembatch[i] < 0) continue;
+		itembatch[i] = -1;
+
+		HWSprite *spr = sprites[drawitems[i].index];
+		if (framecount[spr->modelframe] < 2) continue;
+
+		commands.Clear();
+		FHWModelRecorder recorder(di, commands);
+		RenderModel(&recorder, spr->x, spr->y, spr->z, spr->modelframe, spr->actor, di->Viewpoint.TicFrac);
+		if (!recorder.instanceable || commands.Size() == 0) continue;
+
+		FVector3 dynlight = spr->GetModelDynLight(di);
+		unsigned int hash = HashModelCommands(commands);
+		int *head = batchhash.CheckKey(hash);
+		int b = head ? *head : -1;
+		for (; b >= 0; b = batches[b].nextSameHash)
+		{
+			auto &batch = batches[b];
+			if (batch.style == recorder.style && batch.smf_flags == recorder.smf_flags && batch.mirrored == recorder.mirrored &&
+				batch.dynlight == dynlight && batch.commands.Size() == commands.Size() &&
+				std::equal(commands.begin(), commands.end(), batch.commands.begin()) && batch.sprite->CanInstanceWith(spr))
+			{
+				break;
+			}
+		}
+		if (b < 0)
+		{
+			b = batches.Size();
+			batches.Resize(b + 1);
+			auto &batch = batches[b];
+			batch.commands = commands;
+			batch.style = recorder.style;
+			batch.smf_flags = recorder.smf_flags;
+			batch.mirrored = recorder.mirrored;
+			batch.dynlight = dynlight;
+			batch.sprite = spr;
+			batch.nextSameHash = head ? *head : -1;
+			batch.drawn = false;
+			batchhash[hash] = b;
+		}
+
+		VSMatrix normal;
+		float normaldata[16];
+		normal.computeNormalMatrix(recorder.objectToWorldMatrix);
+		normal.copy(normaldata);
+		normaldata[15] = recorder.interpolation;
+		normal.loadMatrix(normaldata);
+
+		batches[b].instanceData.Push(recorder.objectToWorldMatrix);
+		batches[b].instanceData.Push(normal);
+		itembatch[i] = b;
+	}
+
+	RenderSprite.Clock();
+	for (unsigned i = 0; i < drawitems.Size(); i++)
+	{
+		int b = itembatch[i];
+		if (b < 0 || batches[b].instanceData.Size() == INSTANCE_DATA_SIZE)
+		{
+			RenderSprite.Unclock();
+			DoDraw(di, state, false, i);
+			RenderSprite.Clock();
+		}
+		else if (!batches[b].drawn)
+		{
+			batches[b].sprite->DrawSprite(di, state, false, &batches[b]);
+			batches[b].drawn = true;
+		}
+	}
+	RenderSprite.Unclock();
+}
+
 //==========================================================================
 //
 //
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "memarena.h"
+#include "hw_renderstate.h"
 
 extern FMemArena RenderDataAllocator;
 void ResetRenderDataAllocator();
@@ -65,6 +66,7 @@ struct HWDrawList
 	TArray<HWFlat*> flats;
 	TArray<HWSprite*> sprites;
 	TArray<HWDrawItem> drawitems;
+	TArray<FIndexedDrawRange> flatranges;	// scratch space for batched flat draws
 	int SortNodeStart;
     float SortZ;
 	SortNode * sorted;
@@ -113,6 +115,7 @@ public:
 	void Draw(HWDrawInfo *di, FRenderState &state, bool translucent);
 	void DrawWalls(HWDrawInfo *di, FRenderState &state, bool translucent);
 	void DrawFlats(HWDrawInfo *di, FRenderState &state, bool translucent);
+	void DrawModels(HWDrawInfo *di, FRenderState &state);
 
 	void DrawSorted(HWDrawInfo *di, FRenderState &state, SortNode * head);
 	void DrawSorted(HWDrawInfo *di, FRenderState &state);
@@ -71,6 +71,9 @@ enum PortalTypes
 //
 //==========================================================================
 
+struct FIndexedDrawRange;
+struct FModelInstanceBatch;
+
 struct HWSectorPlane
 {
 	FTextureID texture;
@@ -342,6 +345,9 @@ public:
 	
 	void DrawSubsectors(HWDrawInfo *di, FRenderState &state);
 	void DrawFlat(HWDrawInfo *di, FRenderState &state, bool translucent);
+	bool IsBatchable(HWDrawInfo *di);
+	bool CanBatchWith(HWFlat *other);
+	void DrawFlatBatch(HWDrawInfo *di, FRenderState &state, const FIndexedDrawRange *ranges, int count, int vertexcount);
     
     void DrawOtherPlanes(HWDrawInfo *di, FRenderState &state);
     void DrawFloodPlanes(HWDrawInfo *di, FRenderState &state);
@@ -406,7 +412,11 @@ public:
 	void ProcessParticle(HWDrawInfo *di, particle_t *particle, sector_t *sector, class DVisualThinker *spr);//, int shade, int fakeside)
 	void AdjustVisualThinker(HWDrawInfo *di, DVisualThinker *spr, sector_t *sector);
 
-	void DrawSprite(HWDrawInfo *di, FRenderState &state, bool translucent);
+	void DrawSprite(HWDrawInfo *di, FRenderState &state, bool translucent, const FModelInstanceBatch *instances = nullptr);
+
+	bool IsInstanceableModel() const;
+	bool CanInstanceWith(HWSprite *other);
+	FVector3 GetModelDynLight(HWDrawInfo *di);
 };
 
 
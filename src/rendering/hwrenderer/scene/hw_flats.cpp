@@ -48,6 +48,8 @@
 #include "hw_renderstate.h"
 #include "texturemanager.h"
 
+CVAR(Bool, gl_flatbatching, true, CVAR_ARCHIVE)
+
 #ifdef _DEBUG
 CVAR(Int, gl_breaksec, -1, 0)
 #endif
@@ -206,6 +208,62 @@ void HWFlat::DrawSubsectors(HWDrawInfo *di, FRenderState &state)
 }
 
 
+//==========================================================================
+//
+// Opaque flats whose render state is identical can be submitted
+// as one multi-draw of their static index ranges.
+//
+//==========================================================================
+
+bool HWFlat::IsBatchable(HWDrawInfo *di)
+{
+	if (hacktype || sector->special == GLSector_Skybox || texture == nullptr)
+		return false;
+
+	// With persistent buffers the lights are collected at draw time, so only sections without any lights touching them qualify.
+	if (di->Level->HasDynamicLights && screen->BuffersArePersistent() && !di->isFullbrightScene())
+		return section->lighthead == nullptr;
+
+	return dynlightindex == -1;
+}
+
+bool HWFlat::CanBatchWith(HWFlat *other)
+{
+	if (other->texture != texture || other->lightlevel != lightlevel || other->alpha != alpha || other->ceiling != ceiling)
+		return false;
+	if (other->Colormap != Colormap || other->FlatColor != FlatColor || other->AddColor != AddColor || other->TextureFx != TextureFx)
+		return false;
+	if (other->plane.Offs != plane.Offs || other->plane.Scale != plane.Scale || other->plane.Angle != plane.Angle)
+		return false;
+	return other->plane.plane.Normal() == plane.plane.Normal();
+}
+
+void HWFlat::DrawFlatBatch(HWDrawInfo *di, FRenderState &state, const FIndexedDrawRange *ranges, int count, int vertexcount)
+{
+	int rel = getExtraLight();
+
+	state.SetNormal(plane.plane.Normal().X, plane.plane.Normal().Z, plane.plane.Normal().Y);
+
+	SetColor(state, di->Level, di->lightmode, lightlevel, rel, di->isFullbrightScene(), Colormap, alpha);
+	SetFog(state, di->Level, di->lightmode, lightlevel, rel, di->isFullbrightScene(), &Colormap, false);
+	state.SetObjectColor(FlatColor | 0xff000000);
+	state.SetAddColor(AddColor | 0xff000000);
+	state.ApplyTextureManipulation(TextureFx);
+
+	state.SetMaterial(texture, UF_Texture, 0, CLAMP_NONE, NO_TRANSLATION, -1);
+	SetPlaneTextureRotation(state, &plane, texture);
+	state.SetLightIndex(-1);
+	state.DrawIndexedRanges(DT_Triangles, ranges, count);
+	state.EnableTextureMatrix(false);
+
+	flatvertices += vertexcount;
+	flatprimitives += count;
+
+	state.SetObjectColor(0xffffffff);
+	state.SetAddColor(0);
+	state.ApplyTextureManipulation(nullptr);
+}
+
 //==========================================================================
 //
 // Drawer for render hacks
@@ -101,7 +101,7 @@ CUSTOM_CVAR(Int, gl_fuzztype, 0, CVAR_ARCHIVE)
 //
 //==========================================================================
 
-void HWSprite::DrawSprite(HWDrawInfo *di, FRenderState &state, bool translucent)
+void HWSprite::DrawSprite(HWDrawInfo *di, FRenderState &state, bool translucent, const FModelInstanceBatch *instances)
 {
 	bool additivefog = false;
 	bool foglayer = false;
@@ -305,8 +305,15 @@ void HWSprite::DrawSprite(HWDrawInfo *di, FRenderState &state, bool translucent)
 					state.SetDynLight(probe->Red, probe->Green, probe->Blue);
 			}
 
-			FHWModelRenderer renderer(di, state, dynlightindex);
-			RenderModel(&renderer, x, y, z, modelframe, actor, di->Viewpoint.TicFrac);
+			if (instances)
+			{
+				HWDrawModelInstances(di, state, *instances);
+			}
+			else
+			{
+				FHWModelRenderer renderer(di, state, dynlightindex);
+				RenderModel(&renderer, x, y, z, modelframe, actor, di->Viewpoint.TicFrac);
+			}
 			state.SetVertexBuffer(screen->mVertexData);
 		}
 	}
@@ -337,6 +344,50 @@ void HWSprite::DrawSprite(HWDrawInfo *di, FRenderState &state, bool translucent)
 	state.SetDynLight(0, 0, 0);
 }
 
+//==========================================================================
+//
+// A model can be drawn as an instance of another one if DrawSprite
+// would set up the same render state for both.
+//
+//==========================================================================
+
+bool HWSprite::IsInstanceableModel() const
+{
+	return modelframe != nullptr && actor != nullptr && dynlightindex == -1 && lightlist == nullptr &&
+		topclip == LARGE_VALUE && bottomclip == -LARGE_VALUE;
+}
+
+bool HWSprite::CanInstanceWith(HWSprite *other)
+{
+	sector_t *sec = actor->Sector;
+	sector_t *othersec = other->actor->Sector;
+
+	if (sec != othersec && (sec->SpecialColors[sector_t::sprites] != othersec->SpecialColors[sector_t::sprites] ||
+		sec->AdditiveColors[sector_t::sprites] != othersec->AdditiveColors[sector_t::sprites]))
+	{
+		return false;
+	}
+	return lightlevel == other->lightlevel && foglevel == other->foglevel && fullbright == other->fullbright &&
+		ThingColor == other->ThingColor && Colormap == other->Colormap && RenderStyle == other->RenderStyle &&
+		trans == other->trans && texture == other->texture && translation == other->translation && OverrideShader == other->OverrideShader;
+}
+
+// The sprite light DrawSprite sets for a model without a light list.
+FVector3 HWSprite::GetModelDynLight(HWDrawInfo *di)
+{
+	FVector3 light = { 0, 0, 0 };
+	if (RenderStyle.BlendOp != STYLEOP_Shadow && di->Level->HasDynamicLights && !di->isFullbrightScene() && !fullbright)
+	{
+		di->GetDynSpriteLight(gl_light_sprites ? actor : nullptr, nullptr, &light.X);
+	}
+	if (di->Level->LightProbes.Size() > 0)
+	{
+		LightProbe* probe = FindLightProbe(di->Level, actor->X(), actor->Y(), actor->Center());
+		if (probe) light = { probe->Red, probe->Green, probe->Blue };
+	}
+	return light;
+}
+
 //==========================================================================
 //
 // 
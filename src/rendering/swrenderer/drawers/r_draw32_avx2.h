@@ -0,0 +1,235 @@
+/*
+**  Shared helpers for the AVX2 truecolor drawers
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#pragma once
+
+#include "swrenderer/drawers/r_draw_rgba.h"
+
+// The AVX2 drawers are compiled into the same translation unit as the SSE2 ones.
+// Only functions carrying this attribute may use AVX2 instructions, so nothing
+// else in the binary requires an AVX2 capable CPU.
+#ifndef AVX2_TARGET
+#if defined(__GNUC__)
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define AVX2_TARGET
+#endif
+#endif
+
+namespace swrenderer
+{
+	// Eight pixels are processed per iteration. Packed they fill one __m256i as
+	// [p0 p1 p2 p3 | p4 p5 p6 p7]. Unpacked to 16 bits per channel they are split
+	// into a lo half [p0 p1 | p4 p5] and a hi half [p2 p3 | p6 p7], which is the
+	// order the in-lane unpack and pack instructions use. Each half performs the
+	// exact same 16 bit arithmetic as the SSE2 drawers so both produce identical output.
+	class Drawer32AVX2
+	{
+	public:
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL LaneIndex()
+		{
+			return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+		}
+
+		// Mask of the lanes that hold one of the first count pixels
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL LaneMask(int count)
+		{
+			return _mm256_cmpgt_epi32(_mm256_set1_epi32(count), LaneIndex());
+		}
+
+		// value + lane * step for each of the eight lanes, wrapping like the scalar loops do
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Steps(uint32_t value, uint32_t step)
+		{
+			return _mm256_add_epi32(_mm256_set1_epi32(value), _mm256_mullo_epi32(LaneIndex(), _mm256_set1_epi32(step)));
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256 VECTORCALL Steps(float value, float step)
+		{
+			return _mm256_add_ps(_mm256_set1_ps(value), _mm256_mul_ps(_mm256_cvtepi32_ps(LaneIndex()), _mm256_set1_ps(step)));
+		}
+
+		// Repeats a SSE2 shade constant covering two pixels across all four pixels of a half
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Broadcast(__m128i value)
+		{
+			return _mm256_broadcastsi128_si256(value);
+		}
+
+		FORCEINLINE static AVX2_TARGET void VECTORCALL Unpack(__m256i packed, __m256i &lo, __m256i &hi)
+		{
+			lo = _mm256_unpacklo_epi8(packed, _mm256_setzero_si256());
+			hi = _mm256_unpackhi_epi8(packed, _mm256_setzero_si256());
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Pack(__m256i lo, __m256i hi)
+		{
+			return _mm256_or_si256(_mm256_packus_epi16(lo, hi), _mm256_set1_epi32(0xff000000));
+		}
+
+		// Spreads one 32 bit value per pixel to all four 16 bit channels of that pixel
+		FORCEINLINE static AVX2_TARGET void VECTORCALL SplatPixels(__m256i values, __m256i &lo, __m256i &hi)
+		{
+			__m256i words = _mm256_packs_epi32(values, values);
+			words = _mm256_unpacklo_epi16(words, words);
+			lo = _mm256_unpacklo_epi32(words, words);
+			hi = _mm256_unpackhi_epi32(words, words);
+		}
+
+		// ((red * 77 + green * 143 + blue * 37) >> 8) * desaturate in the color channels, zero in alpha
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Intensity(__m256i material, __m256i desaturate)
+		{
+			__m256i sum = _mm256_madd_epi16(material, _mm256_set1_epi64x(0x0000004d008f0025LL));
+			sum = _mm256_add_epi32(sum, _mm256_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+			sum = _mm256_srli_epi32(sum, 8);
+			sum = _mm256_shufflelo_epi16(sum, _MM_SHUFFLE(1, 0, 0, 0));
+			sum = _mm256_shufflehi_epi16(sum, _MM_SHUFFLE(1, 0, 0, 0));
+			return _mm256_mullo_epi16(sum, desaturate);
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL ShadeSimple(__m256i fgcolor, __m256i mlight)
+		{
+			return _mm256_srli_epi16(_mm256_mullo_epi16(fgcolor, mlight), 8);
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL ShadeAdvanced(__m256i fgcolor, __m256i mlight, __m256i desaturate, __m256i inv_desaturate, __m256i shade_fade, __m256i shade_light)
+		{
+			__m256i intensity = Intensity(fgcolor, desaturate);
+			fgcolor = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fgcolor, inv_desaturate), intensity), 8);
+			fgcolor = _mm256_mullo_epi16(fgcolor, mlight);
+			fgcolor = _mm256_srli_epi16(_mm256_add_epi16(shade_fade, fgcolor), 8);
+			fgcolor = _mm256_srli_epi16(_mm256_mullo_epi16(fgcolor, shade_light), 8);
+			return fgcolor;
+		}
+
+		// Attenuation of one dynamic light for eight pixels along a line. lightdist2 is the
+		// squared distance on the two fixed axes and lightpos the position along the moving one.
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL LightAttenuation(__m256 viewpos, float lightdist2, float lightpos, float lightdot, float radius)
+		{
+			__m256 m256 = _mm256_set1_ps(256.0f);
+			__m256 light_dot = _mm256_set1_ps(lightdot);
+
+			// L = light-pos
+			// dist = sqrt(dot(L, L))
+			// distance_attenuation = 1 - min(dist * (1/radius), 1)
+			__m256 L = _mm256_sub_ps(_mm256_set1_ps(lightpos), viewpos);
+			__m256 dist2 = _mm256_add_ps(_mm256_set1_ps(lightdist2), _mm256_mul_ps(L, L));
+			__m256 rcp_dist = _mm256_rsqrt_ps(dist2);
+			__m256 dist = _mm256_mul_ps(dist2, rcp_dist);
+			__m256 distance_attenuation = _mm256_sub_ps(m256, _mm256_min_ps(_mm256_mul_ps(dist, _mm256_set1_ps(radius)), m256));
+
+			// The simple light type
+			__m256 simple_attenuation = distance_attenuation;
+
+			// The point light type
+			// diffuse = dot(N,L) * attenuation
+			__m256 point_attenuation = _mm256_mul_ps(_mm256_mul_ps(light_dot, rcp_dist), distance_attenuation);
+
+			__m256 is_attenuated = _mm256_cmp_ps(light_dot, _mm256_setzero_ps(), _CMP_EQ_OQ);
+			return _mm256_cvtps_epi32(_mm256_blendv_ps(point_attenuation, simple_attenuation, is_attenuated));
+		}
+
+		FORCEINLINE static AVX2_TARGET void VECTORCALL AddLight(__m256i &lit_lo, __m256i &lit_hi, __m256i attenuation, uint32_t color)
+		{
+			__m256i att_lo, att_hi;
+			SplatPixels(attenuation, att_lo, att_hi);
+			__m256i light_color = _mm256_unpacklo_epi8(_mm256_set1_epi32(color), _mm256_setzero_si256());
+			lit_lo = _mm256_add_epi16(lit_lo, _mm256_srli_epi16(_mm256_mullo_epi16(light_color, att_lo), 8));
+			lit_hi = _mm256_add_epi16(lit_hi, _mm256_srli_epi16(_mm256_mullo_epi16(light_color, att_hi), 8));
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL ApplyLights(__m256i material, __m256i fgcolor, __m256i lit)
+		{
+			lit = _mm256_min_epi16(lit, _mm256_set1_epi16(256));
+			fgcolor = _mm256_add_epi16(fgcolor, _mm256_srli_epi16(_mm256_mullo_epi16(material, lit), 8));
+			return _mm256_min_epi16(fgcolor, _mm256_set1_epi16(255));
+		}
+
+		// Per pixel blend factors derived from the alpha of the unshaded texels
+		FORCEINLINE static AVX2_TARGET void VECTORCALL AlphaFactors(__m256i texels, uint32_t srcalpha, uint32_t destalpha, __m256i &fgalpha, __m256i &bgalpha)
+		{
+			__m256i alpha = _mm256_srli_epi32(texels, 24);
+			alpha = _mm256_add_epi32(alpha, _mm256_srli_epi32(alpha, 7)); // 255->256
+			__m256i inv_alpha = _mm256_sub_epi32(_mm256_set1_epi32(256), alpha);
+			__m256i round = _mm256_set1_epi32(128);
+			bgalpha = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(destalpha), alpha), _mm256_slli_epi32(inv_alpha, 8)), round), 8);
+			fgalpha = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(srcalpha), alpha), round), 8);
+		}
+
+		enum BlendOp { AddOp, SubOp, RevSubOp };
+
+		// (fg * fgalpha op bg * bgalpha) >> 8, left unpacked
+		template<int Op>
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL BlendAlpha(__m256i fgcolor, __m256i bgcolor, __m256i fgalpha, __m256i bgalpha)
+		{
+			fgcolor = _mm256_mullo_epi16(fgcolor, fgalpha);
+			bgcolor = _mm256_mullo_epi16(bgcolor, bgalpha);
+
+			__m256i fg_lo = _mm256_unpacklo_epi16(fgcolor, _mm256_setzero_si256());
+			__m256i bg_lo = _mm256_unpacklo_epi16(bgcolor, _mm256_setzero_si256());
+			__m256i fg_hi = _mm256_unpackhi_epi16(fgcolor, _mm256_setzero_si256());
+			__m256i bg_hi = _mm256_unpackhi_epi16(bgcolor, _mm256_setzero_si256());
+
+			__m256i out_lo, out_hi;
+			if (Op == AddOp)
+			{
+				out_lo = _mm256_add_epi32(fg_lo, bg_lo);
+				out_hi = _mm256_add_epi32(fg_hi, bg_hi);
+			}
+			else if (Op == SubOp)
+			{
+				out_lo = _mm256_sub_epi32(fg_lo, bg_lo);
+				out_hi = _mm256_sub_epi32(fg_hi, bg_hi);
+			}
+			else
+			{
+				out_lo = _mm256_sub_epi32(bg_lo, fg_lo);
+				out_hi = _mm256_sub_epi32(bg_hi, fg_hi);
+			}
+
+			out_lo = _mm256_srai_epi32(out_lo, 8);
+			out_hi = _mm256_srai_epi32(out_hi, 8);
+			return _mm256_packs_epi32(out_lo, out_hi);
+		}
+
+		// Keeps the background wherever the shaded foreground is fully black
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL BlendMasked(__m256i fg_lo, __m256i fg_hi, __m256i bgpacked)
+		{
+			__m256i fgpacked = _mm256_packus_epi16(fg_lo, fg_hi);
+			__m256i mask = _mm256_cmpeq_epi32(fgpacked, _mm256_setzero_si256());
+			__m256i outcolor = _mm256_blendv_epi8(fgpacked, bgpacked, mask);
+			return _mm256_or_si256(outcolor, _mm256_set1_epi32(0xff000000));
+		}
+
+		// Reads eight pixels down a column. Lanes outside the mask read as zero.
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL GatherColumn(const uint32_t *dest, __m256i offsets, __m256i mask)
+		{
+			return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)dest, offsets, mask, 4);
+		}
+
+		FORCEINLINE static AVX2_TARGET void VECTORCALL StoreColumn(uint32_t *dest, int pitch, __m256i color, int count)
+		{
+			alignas(32) uint32_t desttmp[8];
+			_mm256_store_si256((__m256i*)desttmp, color);
+			for (int i = 0; i < count; i++)
+				dest[i * pitch] = desttmp[i];
+		}
+	};
+}
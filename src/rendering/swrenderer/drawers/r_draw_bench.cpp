@@ -0,0 +1,773 @@
+/*
+**  Synthetic workloads for timing the software renderer drawers
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#include <stddef.h>
+
+#include "doomdef.h"
+#include "doomstat.h"
+#include "i_time.h"
+#include "c_dispatch.h"
+#include "v_video.h"
+#include "v_palette.h"
+#include "v_colortables.h"
+#include "colormatcher.h"
+#include "m_crc32.h"
+#include "r_draw_bench.h"
+#include "r_draw_rgba.h"
+#include "r_draw_pal.h"
+#include "swrenderer/viewport/r_viewport.h"
+#include "swrenderer/viewport/r_walldrawer.h"
+#include "swrenderer/viewport/r_spandrawer.h"
+#include "swrenderer/viewport/r_spritedrawer.h"
+
+EXTERN_CVAR(Bool, r_blendmethod)
+
+namespace swrenderer
+{
+	SWDrawerBenchmark::SWDrawerBenchmark(int width, int height, bool bgra) : Width(width), Height(height), Bgra(bgra), Target(width, height, bgra)
+	{
+		Viewport.reset(new RenderViewport());
+		Viewport->RenderTarget = &Target;
+		Viewport->viewwindow.centerx = width / 2;
+		Viewport->viewwindow.centery = height / 2;
+
+		WallTop.Resize(width);
+		WallBottom.Resize(width);
+		for (int x = 0; x < width; x++)
+		{
+			WallTop[x] = 0;
+			WallBottom[x] = height;
+		}
+
+		CreateTextures();
+		CreateWorkloads();
+	}
+
+	SWDrawerBenchmark::~SWDrawerBenchmark()
+	{
+	}
+
+	void SWDrawerBenchmark::CreateTextures()
+	{
+		// Deterministic noise so every drawer set sees identical input
+		uint32_t seed = 0x12345678;
+		auto random = [&]() { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return seed; };
+
+		Texture.Resize(256 * 256);
+		PalTexture.Resize(256 * 256);
+		for (int i = 0; i < 256 * 256; i++)
+		{
+			uint32_t r = random();
+			// Leave some holes for the masked drawers to skip
+			Texture[i] = (r & 0xf) == 0 ? 0 : (r | 0xff000000);
+			PalTexture[i] = (r & 0xf) == 0 ? 0 : (uint8_t)(r >> 8);
+		}
+
+		Translation.Resize(256);
+		PalTranslation.Resize(256);
+		for (int i = 0; i < 256; i++)
+		{
+			uint32_t r = random();
+			Translation[i] = r | 0xff000000;
+			PalTranslation[i] = (uint8_t)(r >> 8);
+		}
+
+		// Light ramps towards black through the current palette, and alpha ramps for the shaded drawers
+		LightMaps.Resize(NUMCOLORMAPS * 256);
+		ShadeMaps.Resize(NUMCOLORMAPS * 256);
+		for (int level = 0; level < NUMCOLORMAPS; level++)
+		{
+			int scale = NUMCOLORMAPS - level;
+			for (int i = 0; i < 256; i++)
+			{
+				PalEntry color = GPalette.BaseColors[i];
+				LightMaps[level * 256 + i] = ColorMatcher.Pick(color.r * scale / NUMCOLORMAPS, color.g * scale / NUMCOLORMAPS, color.b * scale / NUMCOLORMAPS);
+				ShadeMaps[level * 256 + i] = (uint8_t)(i * 65 / 256);
+			}
+		}
+
+		Light.Maps = LightMaps.Data();
+		ShadeLight.Maps = ShadeMaps.Data();
+		ColoredLight.Maps = ShadeMaps.Data();
+		ColoredLight.Color = PalEntry(255, 255, 192, 128);
+		ColoredLight.Fade = PalEntry(255, 32, 0, 64);
+		ColoredLight.Desaturate = 96;
+
+		Background.Resize(Target.GetPitch() * Height * (Bgra ? 4 : 1));
+		for (unsigned i = 0; i < Background.Size(); i++)
+			Background[i] = (uint8_t)random();
+	}
+
+	void SWDrawerBenchmark::ResetCanvas()
+	{
+		memcpy(Target.GetPixels(), Background.Data(), Background.Size());
+	}
+
+	void SWDrawerBenchmark::Run(const Workload &workload, SWPixelFormatDrawers *drawers)
+	{
+		// GetDest offsets by the view window, which the benchmark canvas does not have
+		int savedx = viewwindowx, savedy = viewwindowy;
+		viewwindowx = 0;
+		viewwindowy = 0;
+
+		ResetCanvas();
+		workload.Draw(*this, drawers);
+
+		viewwindowx = savedx;
+		viewwindowy = savedy;
+	}
+
+	double SWDrawerBenchmark::Time(const Workload &workload, SWPixelFormatDrawers *drawers, int iterations)
+	{
+		int savedx = viewwindowx, savedy = viewwindowy;
+		viewwindowx = 0;
+		viewwindowy = 0;
+
+		ResetCanvas();
+		uint64_t start = I_nsTime();
+		for (int i = 0; i < iterations; i++)
+			workload.Draw(*this, drawers);
+		uint64_t end = I_nsTime();
+
+		viewwindowx = savedx;
+		viewwindowy = savedy;
+		return (end - start) / (iterations * 1'000'000.0);
+	}
+
+	TArray<uint8_t> SWDrawerBenchmark::Snapshot() const
+	{
+		TArray<uint8_t> pixels(Background.Size(), true);
+		memcpy(pixels.Data(), Target.GetPixels(), pixels.Size());
+		return pixels;
+	}
+
+	SWDrawerBenchmark::Difference SWDrawerBenchmark::Compare(const TArray<uint8_t> &reference) const
+	{
+		Difference diff;
+		const uint8_t *pixels = Target.GetPixels();
+		int pixelsize = Bgra ? 4 : 1;
+		for (unsigned i = 0; i < reference.Size(); i += pixelsize)
+		{
+			int maxchannel = 0;
+			for (int c = 0; c < pixelsize; c++)
+				maxchannel = max(maxchannel, abs(pixels[i + c] - reference[i + c]));
+			if (maxchannel != 0)
+			{
+				diff.Pixels++;
+				diff.MaxChannel = max(diff.MaxChannel, maxchannel);
+			}
+		}
+		return diff;
+	}
+
+	uint32_t SWDrawerBenchmark::Checksum() const
+	{
+		return CalcCRC32(Target.GetPixels(), Background.Size());
+	}
+
+	template<typename ArgsT>
+	void SWDrawerBenchmark::SetupLight(ArgsT &args, bool shaded)
+	{
+		// The palette drawers always look up through a colormap
+		if (!Bgra)
+			args.SetBaseColormap(shaded ? &ShadeLight : &Light);
+		else if (Colored)
+			args.SetBaseColormap(&ColoredLight);
+		args.SetLight(0.0f, (NUMCOLORMAPS / 2) << FRACBITS);
+	}
+
+	void SWDrawerBenchmark::DrawWalls(SWPixelFormatDrawers *drawers, void (SWPixelFormatDrawers::*func)(const WallDrawerArgs &), bool translucent)
+	{
+		WallDrawerArgs args;
+		SetupLight(args);
+		args.SetDest(Viewport.get());
+		args.SetStyle(false, false, translucent ? OPAQUE / 2 : OPAQUE, false);
+		args.x1 = 0;
+		args.x2 = Width;
+		args.uwal = WallTop.Data();
+		args.dwal = WallBottom.Data();
+		args.texcoords.upos = 0.0f;
+		args.texcoords.ustepX = 1.0f / 256.0f;
+		args.texcoords.ustepY = 0.0f;
+		args.texcoords.vpos = 0.0f;
+		args.texcoords.vstepX = 0.0f;
+		args.texcoords.vstepY = 1.0f / 256.0f;
+		args.texcoords.wpos = 1.0f;
+		args.texcoords.wstepX = 0.0f;
+		args.texcoords.wstepY = 0.0f;
+		args.texcoords.startX = 0.0f;
+		args.lightpos = 0.0f;
+		args.lightstep = 0.0f;
+		args.fixedlight = true;
+		args.texwidth = 256;
+		args.texheight = 256;
+		args.fracbits = 24;
+		args.mipmapped = false;
+		args.texpixels = TexturePixels();
+		args.CenterY = Height * 0.5f;
+		(drawers->*func)(args);
+	}
+
+	void SWDrawerBenchmark::DrawSpans(SWPixelFormatDrawers *drawers, void (SWPixelFormatDrawers::*func)(const SpanDrawerArgs &), bool translucent)
+	{
+		fixed_t alpha = translucent ? OPAQUE / 2 : OPAQUE;
+
+		SpanDrawerArgs args;
+		SetupLight(args);
+		args.ds_texwidth = 256;
+		args.ds_texheight = 256;
+		args.ds_xbits = 8;
+		args.ds_ybits = 8;
+		args.ds_source = TexturePixels();
+		args.ds_source_mipmapped = false;
+		args.ds_lod = 0.0;
+		args.dc_srcblend = Col2RGB8[alpha >> 10];
+		args.dc_destblend = Col2RGB8[(OPAQUE - alpha) >> 10];
+		args.dc_srcalpha = alpha;
+		args.dc_destalpha = OPAQUE - alpha;
+		args.SetTextureUStep(1.0 / 256.0);
+		args.SetTextureVStep(0.0);
+		args.SetDestX1(0);
+		args.SetDestX2(Width - 1);
+		for (int y = 0; y < Height; y++)
+		{
+			args.SetDestY(Viewport.get(), y);
+			args.SetTextureUPos(0.0);
+			args.SetTextureVPos((y & 255) / 256.0);
+			(drawers->*func)(args);
+		}
+	}
+
+	void SWDrawerBenchmark::DrawTiltedSpans(SWPixelFormatDrawers *drawers)
+	{
+		// A gently sloped plane so the perspective divide is exercised
+		FVector3 plane_sz(0.0f, 0.25f / Height, 1.0f);
+		FVector3 plane_su(16777216.0f, 0.0f, 0.0f);
+		FVector3 plane_sv(0.0f, 16777216.0f, 0.0f);
+
+		FDynamicColormap basecolormap;
+		basecolormap.Maps = LightMaps.Data();
+
+		SpanDrawerArgs args;
+		SetupLight(args);
+		args.ds_texwidth = 256;
+		args.ds_texheight = 256;
+		args.ds_xbits = 8;
+		args.ds_ybits = 8;
+		args.ds_source = TexturePixels();
+		args.ds_source_mipmapped = false;
+		args.ds_lod = 0.0;
+		args.SetDestX1(0);
+		args.SetDestX2(Width - 1);
+		for (int y = 0; y < Height; y++)
+		{
+			args.SetDestY(Viewport.get(), y);
+			drawers->DrawTiltedSpan(args, plane_sz, plane_su, plane_sv, false, 0, 0.0f, 0, 0, &basecolormap);
+		}
+	}
+
+	void SWDrawerBenchmark::DrawSpriteColumns(SWPixelFormatDrawers *drawers, void (SWPixelFormatDrawers::*func)(const SpriteDrawerArgs &), bool translucent, SpriteSource source)
+	{
+		fixed_t alpha = translucent ? OPAQUE / 2 : OPAQUE;
+
+		SpriteDrawerArgs args;
+		SetupLight(args, source == ShadedSource);
+		if (source == TranslatedSource)
+			args.SetTranslationMap(Bgra ? (lighttable_t *)Translation.Data() : PalTranslation.Data());
+		else if (source == ShadedSource && Bgra && !Colored)
+			args.SetTranslationMap(ShadeMaps.Data());
+		args.dc_srcblend = Col2RGB8[alpha >> 10];
+		args.dc_destblend = Col2RGB8[(OPAQUE - alpha) >> 10];
+		args.dc_srcalpha = alpha;
+		args.dc_destalpha = OPAQUE - alpha;
+		args.dc_color = 0x70;
+		args.dc_color_bgra = GPalette.BaseColors[0x70] | 0xff000000;
+		args.dc_srccolor = Col2RGB8[alpha >> 10][0x70] | 0x1f07c1f;
+		args.dc_srccolor_bgra = GPalette.BaseColors[0x70] | 0xff000000;
+		args.dc_textureheight = 256;
+		args.dc_texturefrac = 0;
+		args.dc_texturefracx = 0;
+		args.dc_source2 = nullptr;
+		args.SetCount(Height);
+
+		// Paletted sources are indexed directly by the 16.16 position, truecolor ones wrap at 1 << 30
+		bool palsource = !Bgra || source != TextureSource;
+		args.dc_iscale = palsource ? (255 << FRACBITS) / Height : (1 << 30) / Height;
+		for (int x = 0; x < Width; x++)
+		{
+			if (palsource)
+				args.dc_source = PalTexture.Data() + (x & 255) * 256;
+			else
+				args.dc_source = (const uint8_t *)(Texture.Data() + (x & 255) * 256);
+			args.SetDest(Viewport.get(), x, 0);
+			(drawers->*func)(args);
+		}
+	}
+
+	void SWDrawerBenchmark::CreateWorkloads()
+	{
+		auto wall = [this](const char *name, void (SWPixelFormatDrawers::*func)(const WallDrawerArgs &), bool translucent)
+		{
+			WorkloadList.Push({ name, [=](SWDrawerBenchmark &bench, SWPixelFormatDrawers *drawers) { bench.DrawWalls(drawers, func, translucent); } });
+		};
+		auto span = [this](const char *name, void (SWPixelFormatDrawers::*func)(const SpanDrawerArgs &), bool translucent)
+		{
+			WorkloadList.Push({ name, [=](SWDrawerBenchmark &bench, SWPixelFormatDrawers *drawers) { bench.DrawSpans(drawers, func, translucent); } });
+		};
+		auto sprite = [this](const char *name, void (SWPixelFormatDrawers::*func)(const SpriteDrawerArgs &), bool translucent, SpriteSource source)
+		{
+			WorkloadList.Push({ name, [=](SWDrawerBenchmark &bench, SWPixelFormatDrawers *drawers) { bench.DrawSpriteColumns(drawers, func, translucent, source); } });
+		};
+
+		wall("DrawWall", &SWPixelFormatDrawers::DrawWall, false);
+		wall("DrawWallMasked", &SWPixelFormatDrawers::DrawWallMasked, false);
+		wall("DrawWallAdd", &SWPixelFormatDrawers::DrawWallAdd, true);
+		wall("DrawWallAddClamp", &SWPixelFormatDrawers::DrawWallAddClamp, true);
+		wall("DrawWallSubClamp", &SWPixelFormatDrawers::DrawWallSubClamp, true);
+		wall("DrawWallRevSubClamp", &SWPixelFormatDrawers::DrawWallRevSubClamp, true);
+
+		span("DrawSpan", &SWPixelFormatDrawers::DrawSpan, false);
+		span("DrawSpanMasked", &SWPixelFormatDrawers::DrawSpanMasked, false);
+		span("DrawSpanTranslucent", &SWPixelFormatDrawers::DrawSpanTranslucent, true);
+		span("DrawSpanMaskedTranslucent", &SWPixelFormatDrawers::DrawSpanMaskedTranslucent, true);
+		span("DrawSpanAddClamp", &SWPixelFormatDrawers::DrawSpanAddClamp, true);
+		span("DrawSpanMaskedAddClamp", &SWPixelFormatDrawers::DrawSpanMaskedAddClamp, true);
+		WorkloadList.Push({ "DrawTiltedSpan", [](SWDrawerBenchmark &bench, SWPixelFormatDrawers *drawers) { bench.DrawTiltedSpans(drawers); }, false });
+
+		sprite("DrawColumn", &SWPixelFormatDrawers::DrawColumn, false, TextureSource);
+		sprite("FillColumn", &SWPixelFormatDrawers::FillColumn, false, TextureSource);
+		sprite("FillAddColumn", &SWPixelFormatDrawers::FillAddColumn, true, TextureSource);
+		sprite("FillAddClampColumn", &SWPixelFormatDrawers::FillAddClampColumn, true, TextureSource);
+		sprite("FillSubClampColumn", &SWPixelFormatDrawers::FillSubClampColumn, true, TextureSource);
+		sprite("FillRevSubClampColumn", &SWPixelFormatDrawers::FillRevSubClampColumn, true, TextureSource);
+		sprite("DrawAddColumn", &SWPixelFormatDrawers::DrawAddColumn, true, TextureSource);
+		sprite("DrawTranslatedColumn", &SWPixelFormatDrawers::DrawTranslatedColumn, false, TranslatedSource);
+		sprite("DrawTranslatedAddColumn", &SWPixelFormatDrawers::DrawTranslatedAddColumn, true, TranslatedSource);
+		sprite("DrawShadedColumn", &SWPixelFormatDrawers::DrawShadedColumn, true, ShadedSource);
+		sprite("DrawAddClampShadedColumn", &SWPixelFormatDrawers::DrawAddClampShadedColumn, true, ShadedSource);
+		sprite("DrawAddClampColumn", &SWPixelFormatDrawers::DrawAddClampColumn, true, TextureSource);
+		sprite("DrawAddClampTranslatedColumn", &SWPixelFormatDrawers::DrawAddClampTranslatedColumn, true, TranslatedSource);
+		sprite("DrawSubClampColumn", &SWPixelFormatDrawers::DrawSubClampColumn, true, TextureSource);
+		sprite("DrawSubClampTranslatedColumn", &SWPixelFormatDrawers::DrawSubClampTranslatedColumn, true, TranslatedSource);
+		sprite("DrawRevSubClampColumn", &SWPixelFormatDrawers::DrawRevSubClampColumn, true, TextureSource);
+		sprite("DrawRevSubClampTranslatedColumn", &SWPixelFormatDrawers::DrawRevSubClampTranslatedColumn, true, TranslatedSource);
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	// Plain per-pixel versions of the palette drawers the workloads use, written
+	// separately from r_draw_pal.cpp so that changes to those can be diffed against
+	// them. Only the default blending (r_blendmethod off) without dynamic lights is
+	// covered, and the tilted span drawer is not.
+	class SWPalReferenceDrawers : public SWPalDrawers
+	{
+	public:
+		using SWPalDrawers::SWPalDrawers;
+
+		void DrawWall(const WallDrawerArgs &args) override { Wall(args, BlendCopy, false); }
+		void DrawWallMasked(const WallDrawerArgs &args) override { Wall(args, BlendCopy, true); }
+		void DrawWallAdd(const WallDrawerArgs &args) override { Wall(args, BlendAdd, true); }
+		void DrawWallAddClamp(const WallDrawerArgs &args) override { Wall(args, BlendAddClamp, true); }
+		void DrawWallSubClamp(const WallDrawerArgs &args) override { Wall(args, BlendSubClamp, true); }
+		void DrawWallRevSubClamp(const WallDrawerArgs &args) override { Wall(args, BlendRevSubClamp, true); }
+
+		void DrawSpan(const SpanDrawerArgs &args) override { Span(args, BlendCopy, false, true); }
+		void DrawSpanMasked(const SpanDrawerArgs &args) override { Span(args, BlendCopy, true, false); }
+		void DrawSpanTranslucent(const SpanDrawerArgs &args) override { Span(args, BlendAdd, false, false); }
+		void DrawSpanMaskedTranslucent(const SpanDrawerArgs &args) override { Span(args, BlendAdd, true, false); }
+		void DrawSpanAddClamp(const SpanDrawerArgs &args) override { Span(args, BlendAddClamp, false, false); }
+		void DrawSpanMaskedAddClamp(const SpanDrawerArgs &args) override { Span(args, BlendAddClamp, true, false); }
+
+		void DrawColumn(const SpriteDrawerArgs &args) override { Column(args, BlendCopy, false); }
+		void FillColumn(const SpriteDrawerArgs &args) override { Fill(args, BlendCopy, args.SolidColor()); }
+		void FillAddColumn(const SpriteDrawerArgs &args) override { Fill(args, BlendAdd, args.SrcColorIndex()); }
+		void FillAddClampColumn(const SpriteDrawerArgs &args) override { Fill(args, BlendAddClamp, args.SrcColorIndex()); }
+		void FillSubClampColumn(const SpriteDrawerArgs &args) override { Fill(args, BlendFillSubClamp, args.SrcColorIndex()); }
+		void FillRevSubClampColumn(const SpriteDrawerArgs &args) override { Fill(args, BlendRevSubClamp, args.SrcColorIndex()); }
+		void DrawAddColumn(const SpriteDrawerArgs &args) override { Column(args, BlendAdd, false); }
+		void DrawTranslatedColumn(const SpriteDrawerArgs &args) override { Column(args, BlendCopy, true); }
+		void DrawTranslatedAddColumn(const SpriteDrawerArgs &args) override { Column(args, BlendAdd, true); }
+		void DrawShadedColumn(const SpriteDrawerArgs &args) override;
+		void DrawAddClampShadedColumn(const SpriteDrawerArgs &args) override;
+		void DrawAddClampColumn(const SpriteDrawerArgs &args) override { Column(args, BlendAddClamp, false); }
+		void DrawAddClampTranslatedColumn(const SpriteDrawerArgs &args) override { Column(args, BlendAddClamp, true); }
+		void DrawSubClampColumn(const SpriteDrawerArgs &args) override { Column(args, BlendSubClamp, false); }
+		void DrawSubClampTranslatedColumn(const SpriteDrawerArgs &args) override { Column(args, BlendSubClamp, true); }
+		void DrawRevSubClampColumn(const SpriteDrawerArgs &args) override { Column(args, BlendRevSubClamp, false); }
+		void DrawRevSubClampTranslatedColumn(const SpriteDrawerArgs &args) override { Column(args, BlendRevSubClamp, true); }
+
+	private:
+		enum BlendMode
+		{
+			BlendCopy,
+			BlendAdd,
+			BlendAddClamp,
+			BlendSubClamp,
+			BlendRevSubClamp,
+			BlendFillSubClamp	// the solid color fill does not guard the subtraction
+		};
+
+		// fg is a palette index for BlendCopy and a Col2RGB8 value for everything else
+		static uint8_t Blend(BlendMode mode, uint32_t fg, uint8_t dest, const uint32_t *bg2rgb);
+		static uint8_t Requantize(uint8_t color);
+
+		void Wall(const WallDrawerArgs &args, BlendMode mode, bool masked);
+		void Span(const SpanDrawerArgs &args, BlendMode mode, bool masked, bool requantize);
+		void Column(const SpriteDrawerArgs &args, BlendMode mode, bool translated);
+		void Fill(const SpriteDrawerArgs &args, BlendMode mode, uint32_t fg);
+	};
+
+	uint8_t SWPalReferenceDrawers::Blend(BlendMode mode, uint32_t fg, uint8_t dest, const uint32_t *bg2rgb)
+	{
+		uint32_t bg = bg2rgb ? bg2rgb[dest] : 0;
+		uint32_t a;
+		switch (mode)
+		{
+		default:
+		case BlendCopy:
+			return (uint8_t)fg;
+
+		case BlendAdd:
+			a = (fg + bg) | 0x1f07c1f;
+			return RGB32k.All[a & (a >> 15)];
+
+		case BlendAddClamp:
+		{
+			// Carries out of each 5 bit channel saturate it
+			a = fg + bg;
+			uint32_t carry = a & 0x40100400;
+			carry = carry - (carry >> 5);
+			a = ((a | 0x01f07c1f) & 0x3fffffff) | carry;
+			return RGB32k.All[a & (a >> 15)];
+		}
+
+		case BlendSubClamp:
+			a = (fg | 0x40100400) - bg;
+			break;
+
+		case BlendRevSubClamp:
+			a = (bg | 0x40100400) - fg;
+			break;
+
+		case BlendFillSubClamp:
+			a = fg - bg;
+			break;
+		}
+
+		// Channels that borrowed from their guard bit go to zero
+		uint32_t guard = a & 0x40100400;
+		guard = guard - (guard >> 5);
+		a = (a & guard) | 0x01f07c1f;
+		return RGB32k.All[a & (a >> 15)];
+	}
+
+	// The span drawer puts non-64x64 textures through the dynamic light path even
+	// without lights, which maps the color back through RGB256k.
+	uint8_t SWPalReferenceDrawers::Requantize(uint8_t color)
+	{
+		PalEntry c = GPalette.BaseColors[color];
+		return RGB256k.RGB[c.r >> 2][c.g >> 2][c.b >> 2];
+	}
+
+	void SWPalReferenceDrawers::Wall(const WallDrawerArgs &args, BlendMode mode, bool masked)
+	{
+		WallColumnDrawerArgs colargs;
+		colargs.wallargs = &args;
+
+		const uint32_t *fg2rgb = args.SrcBlend();
+		const uint32_t *bg2rgb = args.DestBlend();
+		const ProjectedWallTexcoords &tc = args.texcoords;
+		const uint8_t *texpixels = static_cast<const uint8_t *>(args.texpixels);
+		uint32_t uv_max = args.texheight << args.fracbits;
+
+		float light = args.fixedlight ? args.FixedLight() : args.lightpos;
+		float lightstep = args.fixedlight ? 0.0f : args.lightstep;
+		float centerY = args.CenterY;
+		centerY -= 0.5f;
+
+		// Stepped the same way as the real drawer so the float rounding matches
+		float upos = tc.upos + tc.ustepX * (args.x1 + 0.5f - tc.startX);
+		float vpos = tc.vpos + tc.vstepX * (args.x1 + 0.5f - tc.startX);
+		float wpos = tc.wpos + tc.wstepX * (args.x1 + 0.5f - tc.startX);
+
+		for (int x = args.x1; x < args.x2; x++, upos += tc.ustepX, vpos += tc.vstepX, wpos += tc.wstepX, light += lightstep)
+		{
+			int y1 = args.uwal[x];
+			int y2 = args.dwal[x];
+			if (y2 <= y1)
+				continue;
+
+			colargs.SetLight(light, args.Shade());
+			const uint8_t *colormap = colargs.Colormap(args.Viewport());
+
+			// Perspective correct texture coordinates at the top of the column
+			float dy = y1 - centerY;
+			float w = 1.0f / (wpos + tc.wstepY * dy);
+			float u = (upos + tc.ustepY * dy) * w;
+			float v = (vpos + tc.vstepY * dy) * w;
+			uint32_t texelX = (uint32_t)(int64_t)((u - std::floor(u)) * 0x1'0000'0000LL);
+			uint32_t texelY = (uint32_t)(int64_t)((v - std::floor(v)) * 0x1'0000'0000LL);
+			uint32_t texelStepY = (uint32_t)(int64_t)(tc.vstepY * w * 0x1'0000'0000LL);
+
+			const uint8_t *column = texpixels + (((texelX >> 16) * args.texwidth) >> 16) * args.texheight;
+			uint32_t frac = (uint32_t)(((uint64_t)texelY * args.texheight) >> (32 - args.fracbits));
+			uint32_t fracstep = (uint32_t)(((uint64_t)texelStepY * args.texheight) >> (32 - args.fracbits));
+
+			for (int y = y1; y < y2; y++)
+			{
+				uint8_t pix = column[frac >> args.fracbits];
+				if (!masked || pix != 0)
+				{
+					uint8_t *dest = args.Viewport()->GetDest(x, y);
+					uint8_t lit = colormap[pix];
+					*dest = Blend(mode, mode == BlendCopy ? lit : fg2rgb[lit], *dest, bg2rgb);
+				}
+				frac += fracstep;
+				if (uv_max != 0 && frac >= uv_max)
+					frac -= uv_max;
+			}
+		}
+	}
+
+	void SWPalReferenceDrawers::Span(const SpanDrawerArgs &args, BlendMode mode, bool masked, bool requantize)
+	{
+		const uint8_t *source = args.TexturePixels();
+		const uint8_t *colormap = args.Colormap(args.Viewport());
+		const uint32_t *fg2rgb = args.SrcBlend();
+		const uint32_t *bg2rgb = args.DestBlend();
+		uint32_t width = args.TextureWidth();
+		uint32_t height = args.TextureHeight();
+		uint32_t xfrac = args.TextureUPos();
+		uint32_t yfrac = args.TextureVPos();
+		bool is64 = width == 64 && height == 64;
+
+		for (int x = args.DestX1(); x <= args.DestX2(); x++)
+		{
+			int spot;
+			if (is64)
+				spot = ((xfrac >> (32 - 6 - 6)) & (63 * 64)) + (yfrac >> (32 - 6));
+			else
+				spot = (((xfrac >> 16) * width) >> 16) * height + (((yfrac >> 16) * height) >> 16);
+
+			uint8_t pix = source[spot];
+			if (!masked || pix != 0)
+			{
+				uint8_t *dest = args.Viewport()->GetDest(x, args.DestY());
+				uint8_t lit = colormap[pix];
+				if (requantize && !is64)
+					lit = Requantize(lit);
+				*dest = Blend(mode, mode == BlendCopy ? lit : fg2rgb[lit], *dest, bg2rgb);
+			}
+			xfrac += args.TextureUStep();
+			yfrac += args.TextureVStep();
+		}
+	}
+
+	void SWPalReferenceDrawers::Column(const SpriteDrawerArgs &args, BlendMode mode, bool translated)
+	{
+		const uint8_t *source = args.TexturePixels();
+		const uint8_t *colormap = args.Colormap(args.Viewport());
+		const uint8_t *translation = translated ? args.TranslationMap() : nullptr;
+		const uint32_t *fg2rgb = args.SrcBlend();
+		const uint32_t *bg2rgb = args.DestBlend();
+		int pitch = args.Viewport()->RenderTarget->GetPitch();
+		uint8_t *dest = args.Dest();
+		fixed_t frac = args.TextureVPos();
+
+		for (int i = 0; i < args.Count(); i++)
+		{
+			uint8_t pix = source[frac >> FRACBITS];
+			uint8_t lit = colormap[translation ? translation[pix] : pix];
+			dest[i * pitch] = Blend(mode, mode == BlendCopy ? lit : fg2rgb[lit], dest[i * pitch], bg2rgb);
+			frac += args.TextureVStep();
+		}
+	}
+
+	void SWPalReferenceDrawers::Fill(const SpriteDrawerArgs &args, BlendMode mode, uint32_t fg)
+	{
+		const uint32_t *bg2rgb = args.DestBlend();
+		int pitch = args.Viewport()->RenderTarget->GetPitch();
+		uint8_t *dest = args.Dest();
+
+		for (int i = 0; i < args.Count(); i++)
+			dest[i * pitch] = Blend(mode, fg, dest[i * pitch], bg2rgb);
+	}
+
+	void SWPalReferenceDrawers::DrawShadedColumn(const SpriteDrawerArgs &args)
+	{
+		const uint8_t *source = args.TexturePixels();
+		const uint8_t *colormap = args.Colormap(args.Viewport());
+		int pitch = args.Viewport()->RenderTarget->GetPitch();
+		uint8_t *dest = args.Dest();
+		fixed_t frac = args.TextureVPos();
+
+		// The colormap gives the alpha, from 0 to 64, of the solid color
+		for (int i = 0; i < args.Count(); i++)
+		{
+			uint32_t alpha = colormap[source[frac >> FRACBITS]];
+			if (alpha != 0)
+			{
+				uint8_t &pixel = dest[i * pitch];
+				uint32_t a = (Col2RGB8[alpha][args.SolidColor()] + Col2RGB8[64 - alpha][pixel]) | 0x1f07c1f;
+				pixel = RGB32k.All[a & (a >> 15)];
+			}
+			frac += args.TextureVStep();
+		}
+	}
+
+	void SWPalReferenceDrawers::DrawAddClampShadedColumn(const SpriteDrawerArgs &args)
+	{
+		const uint8_t *source = args.TexturePixels();
+		const uint8_t *colormap = args.Colormap(args.Viewport());
+		int pitch = args.Viewport()->RenderTarget->GetPitch();
+		uint8_t *dest = args.Dest();
+		fixed_t frac = args.TextureVPos();
+		PalEntry color = GPalette.BaseColors[args.SolidColor()];
+
+		for (int i = 0; i < args.Count(); i++)
+		{
+			int alpha = colormap[source[frac >> FRACBITS]] * 4;
+			uint8_t &pixel = dest[i * pitch];
+			PalEntry bg = GPalette.BaseColors[pixel];
+			int r = (bg.r * 256 + color.r * alpha) >> 10;
+			int g = (bg.g * 256 + color.g * alpha) >> 10;
+			int b = (bg.b * 256 + color.b * alpha) >> 10;
+			pixel = RGB256k.RGB[clamp(r, 0, 63)][clamp(g, 0, 63)][clamp(b, 0, 63)];
+			frac += args.TextureVStep();
+		}
+	}
+
+	/////////////////////////////////////////////////////////////////////////
+
+	int RunDrawerBenchmark(int width, int height, int iterations)
+	{
+		int failures = 0;
+
+		// The SSE2 truecolor drawers are the reference for any other truecolor set
+		SWTruecolorDrawers reference(nullptr);
+		std::unique_ptr<SWTruecolorDrawers> avx2;
+#ifndef NO_SSE
+		if (SWTruecolorAVX2Drawers::IsSupported())
+			avx2.reset(new SWTruecolorAVX2Drawers(nullptr));
+#endif
+
+		SWDrawerBenchmark truecolor(width, height, true);
+		for (int colored = 0; colored < 2; colored++)
+		{
+			truecolor.SetColored(colored != 0);
+			Printf("Truecolor drawers, %s light, %d iterations at %dx%d\n", colored ? "colored" : "simple", iterations, width, height);
+			for (const auto &workload : truecolor.Workloads())
+			{
+				truecolor.Run(workload, &reference);
+				TArray<uint8_t> expected = truecolor.Snapshot();
+				double sse2time = truecolor.Time(workload, &reference, iterations);
+				if (avx2)
+				{
+					truecolor.Run(workload, avx2.get());
+					SWDrawerBenchmark::Difference diff = truecolor.Compare(expected);
+					double avx2time = truecolor.Time(workload, avx2.get(), iterations);
+					Printf("  %-32s %8.3f ms %8.3f ms %5.2fx", workload.Name.GetChars(), sse2time, avx2time, sse2time / max(avx2time, 0.001));
+					if (diff.Pixels != 0)
+					{
+						Printf(TEXTCOLOR_RED "  %d pixels differ by up to %d\n", diff.Pixels, diff.MaxChannel);
+						failures++;
+					}
+					else
+					{
+						Printf("\n");
+					}
+				}
+				else
+				{
+					Printf("  %-32s %8.3f ms\n", workload.Name.GetChars(), sse2time);
+				}
+			}
+		}
+		if (!avx2)
+			Printf("AVX2 drawers are not supported on this CPU\n");
+
+		// The palette drawers are diffed against the per-pixel reference versions. The checksums
+		// also cover the drawers without a reference and can be compared between builds.
+		SWPalDrawers pal(nullptr);
+		SWPalReferenceDrawers palreference(nullptr);
+		SWDrawerBenchmark paletted(width, height, false);
+		bool blendmethod = r_blendmethod;
+		r_blendmethod = false;
+		Printf("Palette drawers, %d iterations at %dx%d\n", iterations, width, height);
+		for (const auto &workload : paletted.Workloads())
+		{
+			TArray<uint8_t> expected;
+			if (workload.PalReference)
+			{
+				paletted.Run(workload, &palreference);
+				expected = paletted.Snapshot();
+			}
+			paletted.Run(workload, &pal);
+			uint32_t checksum = paletted.Checksum();
+			SWDrawerBenchmark::Difference diff = paletted.Compare(expected);
+			double paltime = paletted.Time(workload, &pal, iterations);
+			Printf("  %-32s %8.3f ms  %08x", workload.Name.GetChars(), paltime, checksum);
+			if (diff.Pixels != 0)
+			{
+				Printf(TEXTCOLOR_RED "  %d pixels differ by up to %d\n", diff.Pixels, diff.MaxChannel);
+				failures++;
+			}
+			else
+			{
+				Printf(workload.PalReference ? "\n" : "  (no reference)\n");
+			}
+		}
+		r_blendmethod = blendmethod;
+
+		return failures;
+	}
+
+	void SetupDrawerBenchmarkPalette()
+	{
+		// 6x7x6 color cube followed by a gray ramp
+		for (int i = 0; i < 256; i++)
+		{
+			if (i < 252)
+				GPalette.BaseColors[i] = PalEntry(255, (i / 42) * 51, ((i / 6) % 7) * 42, (i % 6) * 51);
+			else
+				GPalette.BaseColors[i] = PalEntry(255, (i - 252) * 85, (i - 252) * 85, (i - 252) * 85);
+		}
+		ColorMatcher.SetPalette(GPalette.BaseColors);
+		BuildTransTable(GPalette.BaseColors);
+	}
+}
+
+//==========================================================================
+//
+// Times every drawer and checks the AVX2 drawers against the SSE2 ones and
+// the palette drawers against the reference versions
+//
+//==========================================================================
+
+CCMD (bench_swdrawers)
+{
+	int iterations = 20;
+	if (argv.argc() > 1)
+		iterations = max(atoi(argv[1]), 1);
+
+	swrenderer::RunDrawerBenchmark(1920, 1080, iterations);
+}
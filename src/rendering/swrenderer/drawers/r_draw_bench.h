@@ -0,0 +1,125 @@
+/*
+**  Synthetic workloads for timing the software renderer drawers
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include "tarray.h"
+#include "zstring.h"
+#include "v_video.h"
+#include "swrenderer/r_swcolormaps.h"
+
+namespace swrenderer
+{
+	class RenderViewport;
+	class SWPixelFormatDrawers;
+	class WallDrawerArgs;
+	class SpanDrawerArgs;
+	class SpriteDrawerArgs;
+
+	// Draws synthetic full screen workloads through a drawer set so the
+	// drawers can be timed and compared without a level being loaded.
+	class SWDrawerBenchmark
+	{
+	public:
+		SWDrawerBenchmark(int width, int height, bool bgra);
+		~SWDrawerBenchmark();
+
+		struct Workload
+		{
+			FString Name;
+			std::function<void(SWDrawerBenchmark &bench, SWPixelFormatDrawers *drawers)> Draw;
+			bool PalReference = true;	// the palette output can be checked against the reference drawers
+		};
+
+		struct Difference
+		{
+			int Pixels = 0;
+			int MaxChannel = 0;
+		};
+
+		// Colored selects the advanced shading path (tinted light, fade and desaturation)
+		void SetColored(bool colored) { Colored = colored; }
+
+		// Restores the canvas to the same starting image for every run
+		void ResetCanvas();
+
+		// Average time in milliseconds of one run of the workload
+		double Time(const Workload &workload, SWPixelFormatDrawers *drawers, int iterations);
+
+		// Draws one run of the workload onto a freshly reset canvas
+		void Run(const Workload &workload, SWPixelFormatDrawers *drawers);
+
+		// Compares the canvas against a copy of an earlier run
+		Difference Compare(const TArray<uint8_t> &reference) const;
+		TArray<uint8_t> Snapshot() const;
+		uint32_t Checksum() const;
+
+		const TArray<Workload> &Workloads() const { return WorkloadList; }
+		DCanvas *Canvas() { return &Target; }
+
+	private:
+		enum SpriteSource
+		{
+			TextureSource,
+			TranslatedSource,
+			ShadedSource
+		};
+
+		void CreateTextures();
+		void CreateWorkloads();
+		void DrawWalls(SWPixelFormatDrawers *drawers, void (SWPixelFormatDrawers::*func)(const WallDrawerArgs &), bool translucent);
+		void DrawSpans(SWPixelFormatDrawers *drawers, void (SWPixelFormatDrawers::*func)(const SpanDrawerArgs &), bool translucent);
+		void DrawTiltedSpans(SWPixelFormatDrawers *drawers);
+		void DrawSpriteColumns(SWPixelFormatDrawers *drawers, void (SWPixelFormatDrawers::*func)(const SpriteDrawerArgs &), bool translucent, SpriteSource source);
+
+		template<typename ArgsT> void SetupLight(ArgsT &args, bool shaded = false);
+		const uint8_t *TexturePixels() const { return Bgra ? (const uint8_t *)Texture.Data() : PalTexture.Data(); }
+
+		int Width, Height;
+		bool Bgra;
+		bool Colored = false;
+		DCanvas Target;
+		TArray<uint8_t> Background;
+		std::unique_ptr<RenderViewport> Viewport;
+		TArray<uint32_t> Texture;
+		TArray<uint8_t> PalTexture;
+		TArray<uint32_t> Translation;
+		TArray<uint8_t> PalTranslation;
+		TArray<uint8_t> LightMaps;
+		TArray<uint8_t> ShadeMaps;
+		TArray<short> WallTop, WallBottom;
+		FSWColormap Light;
+		FSWColormap ColoredLight;
+		FSWColormap ShadeLight;
+		TArray<Workload> WorkloadList;
+	};
+
+	// Times every drawer and checks the optional truecolor sets and the palette drawers against reference output.
+	// Returns the number of workloads whose output did not match.
+	int RunDrawerBenchmark(int width, int height, int iterations);
+
+	// Fills the palette and blending tables with a synthetic palette, for running
+	// the benchmark before any game data has been loaded
+	void SetupDrawerBenchmarkPalette();
+}
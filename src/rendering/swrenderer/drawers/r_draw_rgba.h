@@ -142,6 +142,49 @@ namespace swrenderer
 		WallColumnDrawerArgs wallcolargs;
 	};
 
+#ifndef NO_SSE
+	// Truecolor drawers processing eight pixels per iteration for walls, sprites and spans.
+	// Only created when the CPU supports AVX2, see r_avx2drawers.
+	class SWTruecolorAVX2Drawers : public SWTruecolorDrawers
+	{
+	public:
+		using SWTruecolorDrawers::SWTruecolorDrawers;
+
+		static bool IsSupported();
+
+		void DrawWall(const WallDrawerArgs &args) override;
+		void DrawWallMasked(const WallDrawerArgs &args) override;
+		void DrawWallAdd(const WallDrawerArgs &args) override;
+		void DrawWallAddClamp(const WallDrawerArgs &args) override;
+		void DrawWallSubClamp(const WallDrawerArgs &args) override;
+		void DrawWallRevSubClamp(const WallDrawerArgs &args) override;
+		void DrawColumn(const SpriteDrawerArgs &args) override;
+		void FillColumn(const SpriteDrawerArgs &args) override;
+		void FillAddColumn(const SpriteDrawerArgs &args) override;
+		void FillAddClampColumn(const SpriteDrawerArgs &args) override;
+		void FillSubClampColumn(const SpriteDrawerArgs &args) override;
+		void FillRevSubClampColumn(const SpriteDrawerArgs &args) override;
+		void DrawAddColumn(const SpriteDrawerArgs &args) override;
+		void DrawTranslatedColumn(const SpriteDrawerArgs &args) override;
+		void DrawTranslatedAddColumn(const SpriteDrawerArgs &args) override;
+		void DrawShadedColumn(const SpriteDrawerArgs &args) override;
+		void DrawAddClampShadedColumn(const SpriteDrawerArgs &args) override;
+		void DrawAddClampColumn(const SpriteDrawerArgs &args) override;
+		void DrawAddClampTranslatedColumn(const SpriteDrawerArgs &args) override;
+		void DrawSubClampColumn(const SpriteDrawerArgs &args) override;
+		void DrawSubClampTranslatedColumn(const SpriteDrawerArgs &args) override;
+		void DrawRevSubClampColumn(const SpriteDrawerArgs &args) override;
+		void DrawRevSubClampTranslatedColumn(const SpriteDrawerArgs &args) override;
+		void DrawSpan(const SpanDrawerArgs &args) override;
+		void DrawSpanMasked(const SpanDrawerArgs &args) override;
+		void DrawSpanTranslucent(const SpanDrawerArgs &args) override;
+		void DrawSpanMaskedTranslucent(const SpanDrawerArgs &args) override;
+		void DrawSpanAddClamp(const SpanDrawerArgs &args) override;
+		void DrawSpanMaskedAddClamp(const SpanDrawerArgs &args) override;
+		void DrawTiltedSpan(const SpanDrawerArgs& args, const FVector3& plane_sz, const FVector3& plane_su, const FVector3& plane_sv, bool plane_shade, int planeshade, float planelightfloat, fixed_t pviewx, fixed_t pviewy, FDynamicColormap* basecolormap) override;
+	};
+#endif
+
 	/////////////////////////////////////////////////////////////////////////////
 	// Pixel shading inline functions:
 
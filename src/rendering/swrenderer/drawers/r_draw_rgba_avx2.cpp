@@ -0,0 +1,377 @@
+/*
+**  AVX2 truecolor drawer set
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#include <stddef.h>
+
+#include "doomdef.h"
+#include "x86.h"
+#include "v_video.h"
+#include "r_draw_rgba.h"
+#include "swrenderer/viewport/r_viewport.h"
+#include "swrenderer/scene/r_light.h"
+
+#ifndef NO_SSE
+#include "r_draw_wall32_avx2.h"
+#include "r_draw_sprite32_avx2.h"
+#include "r_draw_span32_avx2.h"
+#endif
+
+// Use the AVX2 truecolor drawers when the CPU supports them
+CVAR(Bool, r_avx2drawers, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG);
+
+#ifndef NO_SSE
+
+namespace swrenderer
+{
+	static uint64_t GetXCR0()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		uint32_t eax, edx;
+		__asm__ __volatile__("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+		return ((uint64_t)edx << 32) | eax;
+#endif
+	}
+
+	bool SWTruecolorAVX2Drawers::IsSupported()
+	{
+		// The OS must also save the YMM registers on context switches
+		return CPU.bAVX && CPU.bAVX2 && CPU.bOSXSAVE && (GetXCR0() & 6) == 6;
+	}
+
+	void SWTruecolorAVX2Drawers::DrawWall(const WallDrawerArgs &args)
+	{
+		DrawWallColumns<DrawWall32AVX2Command>(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawWallMasked(const WallDrawerArgs &args)
+	{
+		DrawWallColumns<DrawWallMasked32AVX2Command>(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawWallAdd(const WallDrawerArgs &args)
+	{
+		DrawWallColumns<DrawWallAddClamp32AVX2Command>(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawWallAddClamp(const WallDrawerArgs &args)
+	{
+		DrawWallColumns<DrawWallAddClamp32AVX2Command>(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawWallSubClamp(const WallDrawerArgs &args)
+	{
+		DrawWallColumns<DrawWallSubClamp32AVX2Command>(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawWallRevSubClamp(const WallDrawerArgs &args)
+	{
+		DrawWallColumns<DrawWallRevSubClamp32AVX2Command>(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSprite32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::FillColumn(const SpriteDrawerArgs &args)
+	{
+		FillSprite32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::FillAddColumn(const SpriteDrawerArgs &args)
+	{
+		FillSpriteAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::FillAddClampColumn(const SpriteDrawerArgs &args)
+	{
+		FillSpriteAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::FillSubClampColumn(const SpriteDrawerArgs &args)
+	{
+		FillSpriteSubClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::FillRevSubClampColumn(const SpriteDrawerArgs &args)
+	{
+		FillSpriteRevSubClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawAddColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawTranslatedColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteTranslated32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawTranslatedAddColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteTranslatedAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawShadedColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteShaded32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawAddClampShadedColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteAddClampShaded32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawAddClampColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawAddClampTranslatedColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteTranslatedAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSubClampColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteSubClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSubClampTranslatedColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteTranslatedSubClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawRevSubClampColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteRevSubClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawRevSubClampTranslatedColumn(const SpriteDrawerArgs &args)
+	{
+		DrawSpriteTranslatedRevSubClamp32AVX2Command::DrawColumn(args);
+	}
+
+	// The span mapping intentionally mirrors SWTruecolorDrawers so both sets draw the same image
+	void SWTruecolorAVX2Drawers::DrawSpan(const SpanDrawerArgs &args)
+	{
+		DrawSpan32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSpanMasked(const SpanDrawerArgs &args)
+	{
+		DrawSpanMasked32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSpanTranslucent(const SpanDrawerArgs &args)
+	{
+		DrawSpanTranslucent32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSpanMaskedTranslucent(const SpanDrawerArgs &args)
+	{
+		DrawSpanAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSpanAddClamp(const SpanDrawerArgs &args)
+	{
+		DrawSpanTranslucent32AVX2Command::DrawColumn(args);
+	}
+
+	void SWTruecolorAVX2Drawers::DrawSpanMaskedAddClamp(const SpanDrawerArgs &args)
+	{
+		DrawSpanAddClamp32AVX2Command::DrawColumn(args);
+	}
+
+	/////////////////////////////////////////////////////////////////////////////
+
+	// Same math as LightBgra::shade_bgra, for eight texels with their own light multiplier each
+	template<bool SimpleShade>
+	FORCEINLINE static AVX2_TARGET __m256i VECTORCALL ShadeTiltedTexels(__m256i fg, __m256i light, const ShadeConstants &constants)
+	{
+		__m256i mask = _mm256_set1_epi32(0xff);
+		__m256i red = _mm256_and_si256(_mm256_srli_epi32(fg, 16), mask);
+		__m256i green = _mm256_and_si256(_mm256_srli_epi32(fg, 8), mask);
+		__m256i blue = _mm256_and_si256(fg, mask);
+		__m256i alpha;
+
+		if (SimpleShade)
+		{
+			alpha = _mm256_set1_epi32(0xff000000);
+			red = _mm256_srli_epi32(_mm256_mullo_epi32(red, light), 8);
+			green = _mm256_srli_epi32(_mm256_mullo_epi32(green, light), 8);
+			blue = _mm256_srli_epi32(_mm256_mullo_epi32(blue, light), 8);
+		}
+		else
+		{
+			alpha = _mm256_and_si256(fg, _mm256_set1_epi32(0xff000000));
+			__m256i inv_light = _mm256_sub_epi32(_mm256_set1_epi32(256), light);
+			__m256i inv_desaturate = _mm256_set1_epi32(256 - constants.desaturate);
+
+			__m256i intensity = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(red, _mm256_set1_epi32(77)), _mm256_mullo_epi32(green, _mm256_set1_epi32(143))), _mm256_mullo_epi32(blue, _mm256_set1_epi32(37)));
+			intensity = _mm256_mullo_epi32(_mm256_srli_epi32(intensity, 8), _mm256_set1_epi32(constants.desaturate));
+
+			red = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(red, inv_desaturate), intensity), 8);
+			green = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(green, inv_desaturate), intensity), 8);
+			blue = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(blue, inv_desaturate), intensity), 8);
+
+			red = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(constants.fade_red), inv_light), _mm256_mullo_epi32(red, light)), 8);
+			green = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(constants.fade_green), inv_light), _mm256_mullo_epi32(green, light)), 8);
+			blue = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(constants.fade_blue), inv_light), _mm256_mullo_epi32(blue, light)), 8);
+
+			red = _mm256_srli_epi32(_mm256_mullo_epi32(red, _mm256_set1_epi32(constants.light_red)), 8);
+			green = _mm256_srli_epi32(_mm256_mullo_epi32(green, _mm256_set1_epi32(constants.light_green)), 8);
+			blue = _mm256_srli_epi32(_mm256_mullo_epi32(blue, _mm256_set1_epi32(constants.light_blue)), 8);
+		}
+
+		return _mm256_or_si256(_mm256_or_si256(alpha, _mm256_slli_epi32(red, 16)), _mm256_or_si256(_mm256_slli_epi32(green, 8), blue));
+	}
+
+	template<bool SimpleShade>
+	static AVX2_TARGET void DrawTiltedSpanAVX2(const SpanDrawerArgs& drawerargs, const FVector3& _plane_sz, const FVector3& _plane_su, const FVector3& _plane_sv, bool _plane_shade, int _planeshade, float _planelightfloat, fixed_t _pviewx, fixed_t _pviewy)
+	{
+		int _x1 = drawerargs.DestX1();
+		int _x2 = drawerargs.DestX2();
+		int _y = drawerargs.DestY();
+		fixed_t _light = drawerargs.Light();
+		ShadeConstants _shade_constants = drawerargs.ColormapConstants();
+		const uint32_t* _source = (const uint32_t*)drawerargs.TexturePixels();
+		RenderViewport* viewport = drawerargs.Viewport();
+
+		// Must match the span size of SWTruecolorDrawers::DrawTiltedSpan for identical output
+		const int spansize = 16;
+		const double invspan = 1.0 / spansize;
+
+		int source_width = 1 << drawerargs.TextureWidthBits();
+		int source_height = 1 << drawerargs.TextureHeightBits();
+
+		uint32_t *dest = (uint32_t*)viewport->GetDest(_x1, _y);
+		int count = _x2 - _x1 + 1;
+
+		// Depth (Z) change across the span
+		double iz = _plane_sz[2] + _plane_sz[1] * (viewport->viewwindow.centery - _y) + _plane_sz[0] * (_x1 - viewport->viewwindow.centerx);
+
+		// Light change across the span
+		fixed_t lightstart = _light;
+		fixed_t lightend = lightstart;
+		if (_plane_shade)
+		{
+			double vis_start = iz * _planelightfloat;
+			double vis_end = (iz + _plane_sz[0] * count) * _planelightfloat;
+
+			lightstart = LIGHTSCALE(vis_start, _planeshade);
+			lightend = LIGHTSCALE(vis_end, _planeshade);
+		}
+		fixed_t light = lightstart;
+		fixed_t steplight = (lightend - lightstart) / count;
+
+		// Texture coordinates
+		double uz = _plane_su[2] + _plane_su[1] * (viewport->viewwindow.centery - _y) + _plane_su[0] * (_x1 - viewport->viewwindow.centerx);
+		double vz = _plane_sv[2] + _plane_sv[1] * (viewport->viewwindow.centery - _y) + _plane_sv[0] * (_x1 - viewport->viewwindow.centerx);
+		double startz = 1.f / iz;
+		double startu = uz*startz;
+		double startv = vz*startz;
+		double izstep = _plane_sz[0] * spansize;
+		double uzstep = _plane_su[0] * spansize;
+		double vzstep = _plane_sv[0] * spansize;
+
+		__m256i texwidth = _mm256_set1_epi32(source_width);
+		__m256i texheight = _mm256_set1_epi32(source_height);
+
+		// Linear interpolate in sizes of spansize to increase speed
+		while (count >= spansize)
+		{
+			iz += izstep;
+			uz += uzstep;
+			vz += vzstep;
+
+			double endz = 1.f / iz;
+			double endu = uz * endz;
+			double endv = vz * endz;
+			uint32_t stepu = (uint32_t)(int64_t((endu - startu) * invspan));
+			uint32_t stepv = (uint32_t)(int64_t((endv - startv) * invspan));
+			uint32_t u = (uint32_t)(int64_t(startu) + _pviewx);
+			uint32_t v = (uint32_t)(int64_t(startv) + _pviewy);
+
+			for (int i = 0; i < spansize; i += 8)
+			{
+				__m256i sx = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(Drawer32AVX2::Steps(u, stepu), 16), texwidth), 16);
+				__m256i sy = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(Drawer32AVX2::Steps(v, stepv), 16), texheight), 16);
+				__m256i fg = _mm256_i32gather_epi32((const int*)_source, _mm256_add_epi32(sy, _mm256_mullo_epi32(sx, texheight)), 4);
+
+				// calc_light_multiplier
+				__m256i lights = _mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(Drawer32AVX2::Steps((uint32_t)light, (uint32_t)steplight), FRACBITS - 8));
+
+				_mm256_storeu_si256((__m256i*)dest, ShadeTiltedTexels<SimpleShade>(fg, lights, _shade_constants));
+				dest += 8;
+
+				u += stepu * 8;
+				v += stepv * 8;
+				light += steplight * 8;
+			}
+			startu = endu;
+			startv = endv;
+			count -= spansize;
+		}
+
+		// The last few pixels at the end
+		while (count > 0)
+		{
+			double endz = 1.f / iz;
+			startu = uz * endz;
+			startv = vz * endz;
+			uint32_t u = (uint32_t)(int64_t(startu) + _pviewx);
+			uint32_t v = (uint32_t)(int64_t(startv) + _pviewy);
+
+			uint32_t sx = ((u >> 16) * source_width) >> 16;
+			uint32_t sy = ((v >> 16) * source_height) >> 16;
+			uint32_t fg = _source[sy + sx * source_height];
+
+			if (SimpleShade)
+				*(dest++) = LightBgra::shade_bgra_simple(fg, LightBgra::calc_light_multiplier(light));
+			else
+				*(dest++) = LightBgra::shade_bgra(fg, LightBgra::calc_light_multiplier(light), _shade_constants);
+
+			iz += _plane_sz[0];
+			uz += _plane_su[0];
+			vz += _plane_sv[0];
+			light += steplight;
+			count--;
+		}
+	}
+
+	void SWTruecolorAVX2Drawers::DrawTiltedSpan(const SpanDrawerArgs& args, const FVector3& plane_sz, const FVector3& plane_su, const FVector3& plane_sv, bool plane_shade, int planeshade, float planelightfloat, fixed_t pviewx, fixed_t pviewy, FDynamicColormap* basecolormap)
+	{
+		// Dynamic lights on slopes are rare enough to leave them to the per pixel path
+		if (args.dc_num_lights != 0)
+			SWTruecolorDrawers::DrawTiltedSpan(args, plane_sz, plane_su, plane_sv, plane_shade, planeshade, planelightfloat, pviewx, pviewy, basecolormap);
+		else if (args.ColormapConstants().simple_shade)
+			DrawTiltedSpanAVX2<true>(args, plane_sz, plane_su, plane_sv, plane_shade, planeshade, planelightfloat, pviewx, pviewy);
+		else
+			DrawTiltedSpanAVX2<false>(args, plane_sz, plane_su, plane_sv, plane_shade, planeshade, planelightfloat, pviewx, pviewy);
+	}
+}
+
+#endif
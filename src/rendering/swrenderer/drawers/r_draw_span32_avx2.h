@@ -0,0 +1,284 @@
+/*
+**  AVX2 drawer commands for spans
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#pragma once
+
+#include "swrenderer/drawers/r_draw32_avx2.h"
+#include "swrenderer/drawers/r_draw_span32_sse2.h"
+
+namespace swrenderer
+{
+	template<typename BlendT>
+	class DrawSpan32AVX2T
+	{
+	public:
+		typedef typename DrawSpan32T<BlendT>::TextureData TextureData;
+
+		static AVX2_TARGET void DrawColumn(const SpanDrawerArgs& args)
+		{
+			using namespace DrawSpan32TModes;
+
+			TextureData texdata;
+			texdata.width = args.TextureWidth();
+			texdata.height = args.TextureHeight();
+			texdata.xstep = args.TextureUStep();
+			texdata.ystep = args.TextureVStep();
+			texdata.xfrac = args.TextureUPos();
+			texdata.yfrac = args.TextureVPos();
+
+			texdata.source = (const uint32_t*)args.TexturePixels();
+
+			double lod = args.TextureLOD();
+			bool mipmapped = args.MipmappedTexture();
+
+			bool magnifying = lod < 0.0;
+			if (r_mipmap && mipmapped)
+			{
+				int level = (int)lod;
+				while (level > 0)
+				{
+					if (texdata.width <= 2 || texdata.height <= 2)
+						break;
+
+					texdata.source += texdata.width * texdata.height;
+					texdata.width = max<uint32_t>(texdata.width / 2, 1);
+					texdata.height = max<uint32_t>(texdata.height / 2, 1);
+					level--;
+				}
+			}
+
+			texdata.xone = (0x80000000u / texdata.width) << 1;
+			texdata.yone = (0x80000000u / texdata.height) << 1;
+
+			bool is_nearest_filter = (magnifying && !r_magfilter) || (!magnifying && !r_minfilter);
+			bool is_64x64 = texdata.width == 64 && texdata.height == 64;
+
+			auto shade_constants = args.ColormapConstants();
+			if (shade_constants.simple_shade)
+			{
+				if (is_nearest_filter)
+				{
+					if (is_64x64)
+						Loop<SimpleShade, NearestFilter, TextureSize64x64>(args, texdata, shade_constants);
+					else
+						Loop<SimpleShade, NearestFilter, TextureSizeAny>(args, texdata, shade_constants);
+				}
+				else
+				{
+					if (is_64x64)
+						Loop<SimpleShade, LinearFilter, TextureSize64x64>(args, texdata, shade_constants);
+					else
+						Loop<SimpleShade, LinearFilter, TextureSizeAny>(args, texdata, shade_constants);
+				}
+			}
+			else
+			{
+				if (is_nearest_filter)
+				{
+					if (is_64x64)
+						Loop<AdvancedShade, NearestFilter, TextureSize64x64>(args, texdata, shade_constants);
+					else
+						Loop<AdvancedShade, NearestFilter, TextureSizeAny>(args, texdata, shade_constants);
+				}
+				else
+				{
+					if (is_64x64)
+						Loop<AdvancedShade, LinearFilter, TextureSize64x64>(args, texdata, shade_constants);
+					else
+						Loop<AdvancedShade, LinearFilter, TextureSizeAny>(args, texdata, shade_constants);
+				}
+			}
+		}
+
+		template<typename ShadeModeT, typename FilterModeT, typename TextureSizeT>
+		FORCEINLINE static AVX2_TARGET void VECTORCALL Loop(const SpanDrawerArgs& args, TextureData texdata, ShadeConstants shade_constants)
+		{
+			using namespace DrawSpan32TModes;
+
+			// Shade constants
+			int light = 256 - (args.Light() >> (FRACBITS - 8));
+			__m256i mlight = Drawer32AVX2::Broadcast(_mm_set_epi16(256, light, light, light, 256, light, light, light));
+
+			__m256i desaturate, inv_desaturate, shade_fade, shade_light;
+			if (ShadeModeT::Mode == (int)ShadeMode::Advanced)
+			{
+				__m128i inv_light = _mm_set_epi16(0, 256 - light, 256 - light, 256 - light, 0, 256 - light, 256 - light, 256 - light);
+				__m128i fade = _mm_set_epi16(shade_constants.fade_alpha, shade_constants.fade_red, shade_constants.fade_green, shade_constants.fade_blue, shade_constants.fade_alpha, shade_constants.fade_red, shade_constants.fade_green, shade_constants.fade_blue);
+				desaturate = _mm256_set1_epi16(shade_constants.desaturate);
+				inv_desaturate = Drawer32AVX2::Broadcast(_mm_setr_epi16(256, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate));
+				shade_fade = Drawer32AVX2::Broadcast(_mm_mullo_epi16(fade, inv_light));
+				shade_light = Drawer32AVX2::Broadcast(_mm_set_epi16(shade_constants.light_alpha, shade_constants.light_red, shade_constants.light_green, shade_constants.light_blue, shade_constants.light_alpha, shade_constants.light_red, shade_constants.light_green, shade_constants.light_blue));
+			}
+			else
+			{
+				desaturate = _mm256_setzero_si256();
+				inv_desaturate = _mm256_setzero_si256();
+				shade_fade = _mm256_setzero_si256();
+				shade_light = _mm256_setzero_si256();
+			}
+
+			auto lights = args.dc_lights;
+			auto num_lights = args.dc_num_lights;
+			__m256 viewpos_x = Drawer32AVX2::Steps(args.dc_viewpos.X, args.dc_viewpos_step.X);
+			__m256 step_viewpos_x = _mm256_set1_ps(args.dc_viewpos_step.X * 8.0f);
+
+			int count = args.DestX2() - args.DestX1() + 1;
+			uint32_t *dest = (uint32_t*)args.Viewport()->GetDest(args.DestX1(), args.DestY());
+
+			if (FilterModeT::Mode == (int)FilterModes::Linear)
+			{
+				texdata.xfrac -= texdata.xone / 2;
+				texdata.yfrac -= texdata.yone / 2;
+			}
+
+			uint32_t srcalpha = args.SrcAlpha() >> (FRACBITS - 8);
+			uint32_t destalpha = args.DestAlpha() >> (FRACBITS - 8);
+
+			for (int offset = 0; offset < count; offset += 8)
+			{
+				int pixels = min(count - offset, 8);
+				__m256i mask = Drawer32AVX2::LaneMask(pixels);
+
+				__m256i texels = Sample<FilterModeT, TextureSizeT>(texdata, pixels, mask);
+				texdata.xfrac += texdata.xstep * 8;
+				texdata.yfrac += texdata.ystep * 8;
+
+				__m256i fg_lo, fg_hi;
+				Drawer32AVX2::Unpack(texels, fg_lo, fg_hi);
+				__m256i material_lo = fg_lo, material_hi = fg_hi;
+
+				if (ShadeModeT::Mode == (int)ShadeMode::Simple)
+				{
+					fg_lo = Drawer32AVX2::ShadeSimple(fg_lo, mlight);
+					fg_hi = Drawer32AVX2::ShadeSimple(fg_hi, mlight);
+				}
+				else
+				{
+					fg_lo = Drawer32AVX2::ShadeAdvanced(fg_lo, mlight, desaturate, inv_desaturate, shade_fade, shade_light);
+					fg_hi = Drawer32AVX2::ShadeAdvanced(fg_hi, mlight, desaturate, inv_desaturate, shade_fade, shade_light);
+				}
+
+				__m256i lit_lo = _mm256_setzero_si256(), lit_hi = _mm256_setzero_si256();
+				for (int i = 0; i != num_lights; i++)
+				{
+					__m256i attenuation = Drawer32AVX2::LightAttenuation(viewpos_x, lights[i].y, lights[i].x, lights[i].z, lights[i].radius);
+					Drawer32AVX2::AddLight(lit_lo, lit_hi, attenuation, lights[i].color);
+				}
+				fg_lo = Drawer32AVX2::ApplyLights(material_lo, fg_lo, lit_lo);
+				fg_hi = Drawer32AVX2::ApplyLights(material_hi, fg_hi, lit_hi);
+				viewpos_x = _mm256_add_ps(viewpos_x, step_viewpos_x);
+
+				__m256i outcolor;
+				if (BlendT::Mode == (int)SpanBlendModes::Opaque)
+				{
+					outcolor = Drawer32AVX2::Pack(fg_lo, fg_hi);
+				}
+				else
+				{
+					__m256i bgcolor = _mm256_maskload_epi32((const int*)(dest + offset), mask);
+					outcolor = Blend(fg_lo, fg_hi, bgcolor, texels, srcalpha, destalpha);
+				}
+
+				if (pixels == 8)
+					_mm256_storeu_si256((__m256i*)(dest + offset), outcolor);
+				else
+					_mm256_maskstore_epi32((int*)(dest + offset), mask, outcolor);
+			}
+		}
+
+		template<typename FilterModeT, typename TextureSizeT>
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Sample(const TextureData &texdata, int pixels, __m256i mask)
+		{
+			using namespace DrawSpan32TModes;
+
+			if (FilterModeT::Mode == (int)FilterModes::Nearest)
+			{
+				__m256i xfrac = Drawer32AVX2::Steps(texdata.xfrac, texdata.xstep);
+				__m256i yfrac = Drawer32AVX2::Steps(texdata.yfrac, texdata.ystep);
+				__m256i sample_index;
+				if (TextureSizeT::Mode == (int)SpanTextureSize::Size64x64)
+				{
+					sample_index = _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(xfrac, 32 - 6 - 6), _mm256_set1_epi32(63 * 64)), _mm256_srli_epi32(yfrac, 32 - 6));
+				}
+				else
+				{
+					__m256i x = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(xfrac, 16), _mm256_set1_epi32(texdata.width)), 16);
+					__m256i y = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(yfrac, 16), _mm256_set1_epi32(texdata.height)), 16);
+					sample_index = _mm256_add_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32(texdata.height)), y);
+				}
+				return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)texdata.source, sample_index, mask, 4);
+			}
+			else
+			{
+				alignas(32) uint32_t texels[8] = { 0 };
+				uint32_t xfrac = texdata.xfrac;
+				uint32_t yfrac = texdata.yfrac;
+				for (int i = 0; i < pixels; i++)
+				{
+					texels[i] = DrawSpan32T<BlendT>::template Sample<FilterModeT, TextureSizeT>(texdata.width, texdata.height, texdata.xone, texdata.yone, texdata.xstep, texdata.ystep, xfrac, yfrac, texdata.source);
+					xfrac += texdata.xstep;
+					yfrac += texdata.ystep;
+				}
+				return _mm256_load_si256((const __m256i*)texels);
+			}
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Blend(__m256i fg_lo, __m256i fg_hi, __m256i bgcolor, __m256i texels, uint32_t srcalpha, uint32_t destalpha)
+		{
+			using namespace DrawSpan32TModes;
+
+			if (BlendT::Mode == (int)SpanBlendModes::Masked)
+			{
+				return Drawer32AVX2::BlendMasked(fg_lo, fg_hi, bgcolor);
+			}
+
+			__m256i fgalpha_lo, fgalpha_hi, bgalpha_lo, bgalpha_hi, bg_lo, bg_hi;
+			if (BlendT::Mode == (int)SpanBlendModes::Translucent)
+			{
+				fgalpha_lo = fgalpha_hi = _mm256_set1_epi16(srcalpha);
+				bgalpha_lo = bgalpha_hi = _mm256_set1_epi16(destalpha);
+			}
+			else
+			{
+				__m256i fgalpha, bgalpha;
+				Drawer32AVX2::AlphaFactors(texels, srcalpha, destalpha, fgalpha, bgalpha);
+				Drawer32AVX2::SplatPixels(fgalpha, fgalpha_lo, fgalpha_hi);
+				Drawer32AVX2::SplatPixels(bgalpha, bgalpha_lo, bgalpha_hi);
+			}
+			Drawer32AVX2::Unpack(bgcolor, bg_lo, bg_hi);
+
+			const int op =
+				BlendT::Mode == (int)SpanBlendModes::SubClamp ? Drawer32AVX2::SubOp :
+				BlendT::Mode == (int)SpanBlendModes::RevSubClamp ? Drawer32AVX2::RevSubOp : Drawer32AVX2::AddOp;
+			__m256i out_lo = Drawer32AVX2::BlendAlpha<op>(fg_lo, bg_lo, fgalpha_lo, bgalpha_lo);
+			__m256i out_hi = Drawer32AVX2::BlendAlpha<op>(fg_hi, bg_hi, fgalpha_hi, bgalpha_hi);
+			return Drawer32AVX2::Pack(out_lo, out_hi);
+		}
+	};
+
+	typedef DrawSpan32AVX2T<DrawSpan32TModes::OpaqueSpan> DrawSpan32AVX2Command;
+	typedef DrawSpan32AVX2T<DrawSpan32TModes::MaskedSpan> DrawSpanMasked32AVX2Command;
+	typedef DrawSpan32AVX2T<DrawSpan32TModes::TranslucentSpan> DrawSpanTranslucent32AVX2Command;
+	typedef DrawSpan32AVX2T<DrawSpan32TModes::AddClampSpan> DrawSpanAddClamp32AVX2Command;
+	typedef DrawSpan32AVX2T<DrawSpan32TModes::SubClampSpan> DrawSpanSubClamp32AVX2Command;
+	typedef DrawSpan32AVX2T<DrawSpan32TModes::RevSubClampSpan> DrawSpanRevSubClamp32AVX2Command;
+}
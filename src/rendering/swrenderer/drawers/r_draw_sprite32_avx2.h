@@ -0,0 +1,329 @@
+/*
+**  AVX2 drawer commands for sprites
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#pragma once
+
+#include "swrenderer/drawers/r_draw32_avx2.h"
+#include "swrenderer/drawers/r_draw_sprite32_sse2.h"
+
+namespace swrenderer
+{
+	template<typename BlendT, typename SamplerT>
+	class DrawSprite32AVX2T
+	{
+	public:
+		static AVX2_TARGET void DrawColumn(const SpriteDrawerArgs& args)
+		{
+			using namespace DrawSprite32TModes;
+
+			auto shade_constants = args.ColormapConstants();
+			if (SamplerT::Mode == (int)SpriteSamplers::Texture)
+			{
+				const uint32_t *source2 = (const uint32_t*)args.TexturePixels2();
+				bool is_nearest_filter = (source2 == nullptr);
+
+				if (shade_constants.simple_shade)
+				{
+					if (is_nearest_filter)
+						Loop<SimpleShade, NearestFilter>(args, shade_constants);
+					else
+						Loop<SimpleShade, LinearFilter>(args, shade_constants);
+				}
+				else
+				{
+					if (is_nearest_filter)
+						Loop<AdvancedShade, NearestFilter>(args, shade_constants);
+					else
+						Loop<AdvancedShade, LinearFilter>(args, shade_constants);
+				}
+			}
+			else // no linear filtering for translated, shaded or fill
+			{
+				if (shade_constants.simple_shade)
+				{
+					Loop<SimpleShade, NearestFilter>(args, shade_constants);
+				}
+				else
+				{
+					Loop<AdvancedShade, NearestFilter>(args, shade_constants);
+				}
+			}
+		}
+
+		template<typename ShadeModeT, typename FilterModeT>
+		FORCEINLINE static AVX2_TARGET void VECTORCALL Loop(const SpriteDrawerArgs& args, ShadeConstants shade_constants)
+		{
+			using namespace DrawSprite32TModes;
+
+			const uint32_t *source;
+			const uint32_t *source2;
+			const uint8_t *colormap;
+			const uint32_t *translation;
+
+			if (SamplerT::Mode == (int)SpriteSamplers::Shaded || SamplerT::Mode == (int)SpriteSamplers::Translated)
+			{
+				source = (const uint32_t*)args.TexturePixels();
+				source2 = nullptr;
+				colormap = args.Colormap(args.Viewport());
+				translation = (const uint32_t*)args.TranslationMap();
+			}
+			else
+			{
+				source = (const uint32_t*)args.TexturePixels();
+				source2 = (const uint32_t*)args.TexturePixels2();
+				colormap = nullptr;
+				translation = nullptr;
+			}
+
+			int textureheight = args.TextureHeight();
+			uint32_t one = ((0x20000000 + textureheight - 1) / textureheight) * 2 + 1;
+
+			// Shade constants
+			__m128i dynlight = _mm_cvtsi32_si128(args.DynamicLight());
+			dynlight = _mm_unpacklo_epi8(dynlight, _mm_setzero_si128());
+			dynlight = _mm_shuffle_epi32(dynlight, _MM_SHUFFLE(1, 0, 1, 0));
+			int light = 256 - (args.Light() >> (FRACBITS - 8));
+			__m128i mlight = _mm_set_epi16(256, light, light, light, 256, light, light, light);
+
+			__m256i desaturate, inv_desaturate, shade_fade, shade_light, lightcontrib;
+			if (ShadeModeT::Mode == (int)ShadeMode::Advanced)
+			{
+				__m128i inv_light = _mm_set_epi16(0, 256 - light, 256 - light, 256 - light, 0, 256 - light, 256 - light, 256 - light);
+				__m128i fade = _mm_set_epi16(shade_constants.fade_alpha, shade_constants.fade_red, shade_constants.fade_green, shade_constants.fade_blue, shade_constants.fade_alpha, shade_constants.fade_red, shade_constants.fade_green, shade_constants.fade_blue);
+				desaturate = _mm256_set1_epi16(shade_constants.desaturate);
+				inv_desaturate = Drawer32AVX2::Broadcast(_mm_setr_epi16(256, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate));
+				shade_fade = Drawer32AVX2::Broadcast(_mm_mullo_epi16(fade, inv_light));
+				shade_light = Drawer32AVX2::Broadcast(_mm_set_epi16(shade_constants.light_alpha, shade_constants.light_red, shade_constants.light_green, shade_constants.light_blue, shade_constants.light_alpha, shade_constants.light_red, shade_constants.light_green, shade_constants.light_blue));
+
+				__m128i contrib = _mm_min_epi16(_mm_add_epi16(mlight, dynlight), _mm_set1_epi16(256));
+				lightcontrib = Drawer32AVX2::Broadcast(_mm_sub_epi16(contrib, mlight));
+			}
+			else
+			{
+				desaturate = _mm256_setzero_si256();
+				inv_desaturate = _mm256_setzero_si256();
+				shade_fade = _mm256_setzero_si256();
+				shade_light = _mm256_setzero_si256();
+				lightcontrib = _mm256_setzero_si256();
+
+				mlight = _mm_min_epi16(_mm_add_epi16(mlight, dynlight), _mm_set1_epi16(256));
+			}
+			__m256i mlight8 = Drawer32AVX2::Broadcast(mlight);
+
+			int count = args.Count();
+			if (count <= 0) return;
+			int pitch = args.Viewport()->RenderTarget->GetPitch();
+			uint32_t fracstep = args.TextureVStep();
+			uint32_t frac = args.TextureVPos();
+			uint32_t texturefracx = args.TextureUPos();
+			uint32_t *dest = (uint32_t*)args.Dest();
+
+			if (FilterModeT::Mode == (int)FilterModes::Linear)
+			{
+				frac -= one / 2;
+			}
+
+			uint32_t srcalpha = args.SrcAlpha() >> (FRACBITS - 8);
+			uint32_t destalpha = args.DestAlpha() >> (FRACBITS - 8);
+			uint32_t srccolor = args.SrcColorBgra();
+			uint32_t color = LightBgra::shade_bgra_simple(args.SolidColorBgra(),
+				LightBgra::calc_light_multiplier(light));
+
+			__m256i dest_offsets = _mm256_mullo_epi32(Drawer32AVX2::LaneIndex(), _mm256_set1_epi32(pitch));
+
+			for (int index = 0; index < count; index += 8)
+			{
+				int pixels = min(count - index, 8);
+				__m256i mask = Drawer32AVX2::LaneMask(pixels);
+				uint32_t *destline = dest + index * pitch;
+
+				__m256i texels, shades;
+				Sample<FilterModeT>(texels, shades, frac, fracstep, pixels, mask, source, source2, translation, colormap, textureheight, one, texturefracx, color, srccolor);
+				frac += fracstep * 8;
+
+				__m256i fg_lo, fg_hi;
+				Drawer32AVX2::Unpack(texels, fg_lo, fg_hi);
+				fg_lo = Shade<ShadeModeT>(fg_lo, mlight8, desaturate, inv_desaturate, shade_fade, shade_light, lightcontrib);
+				fg_hi = Shade<ShadeModeT>(fg_hi, mlight8, desaturate, inv_desaturate, shade_fade, shade_light, lightcontrib);
+
+				__m256i outcolor;
+				if (BlendT::Mode == (int)SpriteBlendModes::Opaque)
+				{
+					outcolor = Drawer32AVX2::Pack(fg_lo, fg_hi);
+				}
+				else
+				{
+					__m256i bgcolor = Drawer32AVX2::GatherColumn(destline, dest_offsets, mask);
+					outcolor = Blend(fg_lo, fg_hi, bgcolor, texels, shades, srcalpha, destalpha);
+				}
+
+				Drawer32AVX2::StoreColumn(destline, pitch, outcolor, pixels);
+			}
+		}
+
+		template<typename FilterModeT>
+		FORCEINLINE static AVX2_TARGET void VECTORCALL Sample(__m256i &texels, __m256i &shades, uint32_t frac, uint32_t fracstep, int pixels, __m256i mask, const uint32_t *source, const uint32_t *source2, const uint32_t *translation, const uint8_t *colormap, int textureheight, uint32_t one, uint32_t texturefracx, uint32_t color, uint32_t srccolor)
+		{
+			using namespace DrawSprite32TModes;
+			typedef DrawSprite32T<BlendT, SamplerT> SSE2Drawer;
+
+			shades = _mm256_setzero_si256();
+			if (SamplerT::Mode == (int)SpriteSamplers::Fill)
+			{
+				texels = _mm256_set1_epi32(srccolor);
+			}
+			else if (SamplerT::Mode == (int)SpriteSamplers::Texture && FilterModeT::Mode == (int)FilterModes::Nearest)
+			{
+				__m256i fracs = _mm256_slli_epi32(Drawer32AVX2::Steps(frac, fracstep), 2);
+				__m256i sample_index = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(fracs, FRACBITS), _mm256_set1_epi32(textureheight)), FRACBITS);
+				texels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)source, sample_index, mask, 4);
+			}
+			else if (SamplerT::Mode == (int)SpriteSamplers::Shaded)
+			{
+				// Spilling to memory and reloading stalls store forwarding, so full runs are inserted directly
+				auto sample = [&](int i) { return (int)SSE2Drawer::SampleShade(frac + fracstep * i, source, colormap); };
+				if (pixels == 8)
+				{
+					shades = _mm256_setr_epi32(sample(0), sample(1), sample(2), sample(3), sample(4), sample(5), sample(6), sample(7));
+				}
+				else
+				{
+					alignas(32) uint32_t ifgshade[8] = { 0 };
+					for (int i = 0; i < pixels; i++)
+						ifgshade[i] = sample(i);
+					shades = _mm256_load_si256((const __m256i*)ifgshade);
+				}
+				texels = _mm256_set1_epi32(color);
+			}
+			else if (SamplerT::Mode == (int)SpriteSamplers::Translated)
+			{
+				const uint8_t *sourcepal = (const uint8_t *)source;
+				auto index = [&](int i) { return (int)sourcepal[(frac + fracstep * i) >> FRACBITS]; };
+				__m256i indices;
+				if (pixels == 8)
+				{
+					indices = _mm256_setr_epi32(index(0), index(1), index(2), index(3), index(4), index(5), index(6), index(7));
+				}
+				else
+				{
+					alignas(32) uint32_t ifgindex[8] = { 0 };
+					for (int i = 0; i < pixels; i++)
+						ifgindex[i] = index(i);
+					indices = _mm256_load_si256((const __m256i*)ifgindex);
+				}
+				texels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)translation, indices, mask, 4);
+			}
+			else
+			{
+				alignas(32) uint32_t ifgcolor[8] = { 0 };
+				for (int i = 0; i < pixels; i++)
+				{
+					ifgcolor[i] = SSE2Drawer::template Sample<FilterModeT>(frac, source, source2, translation, textureheight, one, texturefracx, color, srccolor);
+					frac += fracstep;
+				}
+				texels = _mm256_load_si256((const __m256i*)ifgcolor);
+			}
+		}
+
+		template<typename ShadeModeT>
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Shade(__m256i fgcolor, __m256i mlight, __m256i desaturate, __m256i inv_desaturate, __m256i shade_fade, __m256i shade_light, __m256i lightcontrib)
+		{
+			using namespace DrawSprite32TModes;
+
+			if (BlendT::Mode == (int)SpriteBlendModes::Copy)
+				return fgcolor;
+
+			if (ShadeModeT::Mode == (int)ShadeMode::Simple)
+			{
+				return Drawer32AVX2::ShadeSimple(fgcolor, mlight);
+			}
+			else
+			{
+				__m256i lit_dynlight = _mm256_srli_epi16(_mm256_mullo_epi16(fgcolor, lightcontrib), 8);
+				fgcolor = Drawer32AVX2::ShadeAdvanced(fgcolor, mlight, desaturate, inv_desaturate, shade_fade, shade_light);
+				fgcolor = _mm256_add_epi16(fgcolor, lit_dynlight);
+				return _mm256_min_epi16(fgcolor, _mm256_set1_epi16(255));
+			}
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Blend(__m256i fg_lo, __m256i fg_hi, __m256i bgcolor, __m256i texels, __m256i shades, uint32_t srcalpha, uint32_t destalpha)
+		{
+			using namespace DrawSprite32TModes;
+
+			__m256i bg_lo, bg_hi;
+			Drawer32AVX2::Unpack(bgcolor, bg_lo, bg_hi);
+
+			if (BlendT::Mode == (int)SpriteBlendModes::Shaded)
+			{
+				__m256i alpha_lo, alpha_hi;
+				Drawer32AVX2::SplatPixels(shades, alpha_lo, alpha_hi);
+				__m256i inv_alpha_lo = _mm256_sub_epi16(_mm256_set1_epi16(256), alpha_lo);
+				__m256i inv_alpha_hi = _mm256_sub_epi16(_mm256_set1_epi16(256), alpha_hi);
+
+				__m256i out_lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg_lo, alpha_lo), _mm256_mullo_epi16(bg_lo, inv_alpha_lo)), 8);
+				__m256i out_hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg_hi, alpha_hi), _mm256_mullo_epi16(bg_hi, inv_alpha_hi)), 8);
+				return Drawer32AVX2::Pack(out_lo, out_hi);
+			}
+			else if (BlendT::Mode == (int)SpriteBlendModes::AddClampShaded)
+			{
+				__m256i alpha_lo, alpha_hi;
+				Drawer32AVX2::SplatPixels(shades, alpha_lo, alpha_hi);
+
+				__m256i out_lo = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(fg_lo, alpha_lo), 8), bg_lo);
+				__m256i out_hi = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(fg_hi, alpha_hi), 8), bg_hi);
+				return Drawer32AVX2::Pack(out_lo, out_hi);
+			}
+			else
+			{
+				__m256i fgalpha, bgalpha, fgalpha_lo, fgalpha_hi, bgalpha_lo, bgalpha_hi;
+				Drawer32AVX2::AlphaFactors(texels, srcalpha, destalpha, fgalpha, bgalpha);
+				Drawer32AVX2::SplatPixels(fgalpha, fgalpha_lo, fgalpha_hi);
+				Drawer32AVX2::SplatPixels(bgalpha, bgalpha_lo, bgalpha_hi);
+
+				const int op =
+					BlendT::Mode == (int)SpriteBlendModes::SubClamp ? Drawer32AVX2::SubOp :
+					BlendT::Mode == (int)SpriteBlendModes::RevSubClamp ? Drawer32AVX2::RevSubOp : Drawer32AVX2::AddOp;
+				__m256i out_lo = Drawer32AVX2::BlendAlpha<op>(fg_lo, bg_lo, fgalpha_lo, bgalpha_lo);
+				__m256i out_hi = Drawer32AVX2::BlendAlpha<op>(fg_hi, bg_hi, fgalpha_hi, bgalpha_hi);
+				return Drawer32AVX2::Pack(out_lo, out_hi);
+			}
+		}
+	};
+
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::OpaqueSprite, DrawSprite32TModes::TextureSampler> DrawSprite32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::AddClampSprite, DrawSprite32TModes::TextureSampler> DrawSpriteAddClamp32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::SubClampSprite, DrawSprite32TModes::TextureSampler> DrawSpriteSubClamp32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::RevSubClampSprite, DrawSprite32TModes::TextureSampler> DrawSpriteRevSubClamp32AVX2Command;
+
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::OpaqueSprite, DrawSprite32TModes::FillSampler> FillSprite32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::AddClampSprite, DrawSprite32TModes::FillSampler> FillSpriteAddClamp32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::SubClampSprite, DrawSprite32TModes::FillSampler> FillSpriteSubClamp32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::RevSubClampSprite, DrawSprite32TModes::FillSampler> FillSpriteRevSubClamp32AVX2Command;
+
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::ShadedSprite, DrawSprite32TModes::ShadedSampler> DrawSpriteShaded32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::AddClampShadedSprite, DrawSprite32TModes::ShadedSampler> DrawSpriteAddClampShaded32AVX2Command;
+
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::OpaqueSprite, DrawSprite32TModes::TranslatedSampler> DrawSpriteTranslated32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::AddClampSprite, DrawSprite32TModes::TranslatedSampler> DrawSpriteTranslatedAddClamp32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::SubClampSprite, DrawSprite32TModes::TranslatedSampler> DrawSpriteTranslatedSubClamp32AVX2Command;
+	typedef DrawSprite32AVX2T<DrawSprite32TModes::RevSubClampSprite, DrawSprite32TModes::TranslatedSampler> DrawSpriteTranslatedRevSubClamp32AVX2Command;
+}
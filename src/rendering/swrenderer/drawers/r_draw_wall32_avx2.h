@@ -0,0 +1,216 @@
+/*
+**  AVX2 drawer commands for walls
+**  Copyright (c) 2026 The Redemption Team
+**
+**  This software is provided 'as-is', without any express or implied
+**  warranty.  In no event will the authors be held liable for any damages
+**  arising from the use of this software.
+**
+**  Permission is granted to anyone to use this software for any purpose,
+**  including commercial applications, and to alter it and redistribute it
+**  freely, subject to the following restrictions:
+**
+**  1. The origin of this software must not be misrepresented; you must not
+**     claim that you wrote the original software. If you use this software
+**     in a product, an acknowledgment in the product documentation would be
+**     appreciated but is not required.
+**  2. Altered source versions must be plainly marked as such, and must not be
+**     misrepresented as being the original software.
+**  3. This notice may not be removed or altered from any source distribution.
+**
+*/
+
+#pragma once
+
+#include "swrenderer/drawers/r_draw32_avx2.h"
+#include "swrenderer/drawers/r_draw_wall32_sse2.h"
+
+namespace swrenderer
+{
+	template<typename BlendT>
+	class DrawWall32AVX2T
+	{
+	public:
+		static AVX2_TARGET void DrawColumn(const WallColumnDrawerArgs& args)
+		{
+			using namespace DrawWall32TModes;
+
+			const uint32_t *source2 = (const uint32_t*)args.TexturePixels2();
+			bool is_nearest_filter = (source2 == nullptr);
+			auto shade_constants = args.ColormapConstants();
+			if (shade_constants.simple_shade)
+			{
+				if (is_nearest_filter)
+					Loop<SimpleShade, NearestFilter>(args, shade_constants);
+				else
+					Loop<SimpleShade, LinearFilter>(args, shade_constants);
+			}
+			else
+			{
+				if (is_nearest_filter)
+					Loop<AdvancedShade, NearestFilter>(args, shade_constants);
+				else
+					Loop<AdvancedShade, LinearFilter>(args, shade_constants);
+			}
+		}
+
+		template<typename ShadeModeT, typename FilterModeT>
+		FORCEINLINE static AVX2_TARGET void VECTORCALL Loop(const WallColumnDrawerArgs& args, ShadeConstants shade_constants)
+		{
+			using namespace DrawWall32TModes;
+
+			const uint32_t *source = (const uint32_t*)args.TexturePixels();
+			const uint32_t *source2 = (const uint32_t*)args.TexturePixels2();
+			int textureheight = args.TextureHeight();
+			uint32_t one = ((0x80000000 + textureheight - 1) / textureheight) * 2 + 1;
+
+			// Shade constants
+			int light = 256 - (args.Light() >> (FRACBITS - 8));
+			__m256i mlight = Drawer32AVX2::Broadcast(_mm_set_epi16(256, light, light, light, 256, light, light, light));
+
+			__m256i desaturate, inv_desaturate, shade_fade, shade_light;
+			if (ShadeModeT::Mode == (int)ShadeMode::Advanced)
+			{
+				__m128i inv_light = _mm_set_epi16(0, 256 - light, 256 - light, 256 - light, 0, 256 - light, 256 - light, 256 - light);
+				__m128i fade = _mm_set_epi16(shade_constants.fade_alpha, shade_constants.fade_red, shade_constants.fade_green, shade_constants.fade_blue, shade_constants.fade_alpha, shade_constants.fade_red, shade_constants.fade_green, shade_constants.fade_blue);
+				desaturate = _mm256_set1_epi16(shade_constants.desaturate);
+				inv_desaturate = Drawer32AVX2::Broadcast(_mm_setr_epi16(256, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate, 256 - shade_constants.desaturate));
+				shade_fade = Drawer32AVX2::Broadcast(_mm_mullo_epi16(fade, inv_light));
+				shade_light = Drawer32AVX2::Broadcast(_mm_set_epi16(shade_constants.light_alpha, shade_constants.light_red, shade_constants.light_green, shade_constants.light_blue, shade_constants.light_alpha, shade_constants.light_red, shade_constants.light_green, shade_constants.light_blue));
+			}
+			else
+			{
+				desaturate = _mm256_setzero_si256();
+				inv_desaturate = _mm256_setzero_si256();
+				shade_fade = _mm256_setzero_si256();
+				shade_light = _mm256_setzero_si256();
+			}
+
+			int count = args.Count();
+			if (count <= 0) return;
+
+			int pitch = args.Viewport()->RenderTarget->GetPitch();
+			uint32_t fracstep = args.TextureVStep();
+			uint32_t frac = args.TextureVPos();
+			uint32_t texturefracx = args.TextureUPos();
+			uint32_t *dest = (uint32_t*)args.Dest();
+
+			auto lights = args.dc_lights;
+			auto num_lights = args.dc_num_lights;
+			__m256 viewpos_z = Drawer32AVX2::Steps(args.dc_viewpos.Z, args.dc_viewpos_step.Z);
+			__m256 step_viewpos_z = _mm256_set1_ps(args.dc_viewpos_step.Z * 8.0f);
+
+			if (FilterModeT::Mode == (int)FilterModes::Linear)
+			{
+				frac -= one / 2;
+			}
+
+			uint32_t srcalpha = args.SrcAlpha() >> (FRACBITS - 8);
+			uint32_t destalpha = args.DestAlpha() >> (FRACBITS - 8);
+
+			__m256i dest_offsets = _mm256_mullo_epi32(Drawer32AVX2::LaneIndex(), _mm256_set1_epi32(pitch));
+
+			for (int index = 0; index < count; index += 8)
+			{
+				int pixels = min(count - index, 8);
+				__m256i mask = Drawer32AVX2::LaneMask(pixels);
+				uint32_t *destline = dest + index * pitch;
+
+				__m256i texels = Sample<FilterModeT>(frac, fracstep, pixels, mask, source, source2, textureheight, one, texturefracx);
+				frac += fracstep * 8;
+
+				__m256i fg_lo, fg_hi;
+				Drawer32AVX2::Unpack(texels, fg_lo, fg_hi);
+				__m256i material_lo = fg_lo, material_hi = fg_hi;
+
+				if (ShadeModeT::Mode == (int)ShadeMode::Simple)
+				{
+					fg_lo = Drawer32AVX2::ShadeSimple(fg_lo, mlight);
+					fg_hi = Drawer32AVX2::ShadeSimple(fg_hi, mlight);
+				}
+				else
+				{
+					fg_lo = Drawer32AVX2::ShadeAdvanced(fg_lo, mlight, desaturate, inv_desaturate, shade_fade, shade_light);
+					fg_hi = Drawer32AVX2::ShadeAdvanced(fg_hi, mlight, desaturate, inv_desaturate, shade_fade, shade_light);
+				}
+
+				__m256i lit_lo = _mm256_setzero_si256(), lit_hi = _mm256_setzero_si256();
+				for (int i = 0; i != num_lights; i++)
+				{
+					__m256i attenuation = Drawer32AVX2::LightAttenuation(viewpos_z, lights[i].x, lights[i].z, lights[i].y, lights[i].radius);
+					Drawer32AVX2::AddLight(lit_lo, lit_hi, attenuation, lights[i].color);
+				}
+				fg_lo = Drawer32AVX2::ApplyLights(material_lo, fg_lo, lit_lo);
+				fg_hi = Drawer32AVX2::ApplyLights(material_hi, fg_hi, lit_hi);
+				viewpos_z = _mm256_add_ps(viewpos_z, step_viewpos_z);
+
+				__m256i outcolor;
+				if (BlendT::Mode == (int)WallBlendModes::Opaque)
+				{
+					outcolor = Drawer32AVX2::Pack(fg_lo, fg_hi);
+				}
+				else
+				{
+					__m256i bgcolor = Drawer32AVX2::GatherColumn(destline, dest_offsets, mask);
+					outcolor = Blend(fg_lo, fg_hi, bgcolor, texels, srcalpha, destalpha);
+				}
+
+				Drawer32AVX2::StoreColumn(destline, pitch, outcolor, pixels);
+			}
+		}
+
+		template<typename FilterModeT>
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Sample(uint32_t frac, uint32_t fracstep, int pixels, __m256i mask, const uint32_t *source, const uint32_t *source2, int textureheight, uint32_t one, uint32_t texturefracx)
+		{
+			using namespace DrawWall32TModes;
+
+			if (FilterModeT::Mode == (int)FilterModes::Nearest)
+			{
+				__m256i fracs = Drawer32AVX2::Steps(frac, fracstep);
+				__m256i sample_index = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(fracs, FRACBITS), _mm256_set1_epi32(textureheight)), FRACBITS);
+				return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)source, sample_index, mask, 4);
+			}
+			else
+			{
+				alignas(32) uint32_t texels[8] = { 0 };
+				for (int i = 0; i < pixels; i++)
+				{
+					texels[i] = DrawWall32T<BlendT>::template Sample<FilterModeT>(frac, source, source2, textureheight, one, texturefracx);
+					frac += fracstep;
+				}
+				return _mm256_load_si256((const __m256i*)texels);
+			}
+		}
+
+		FORCEINLINE static AVX2_TARGET __m256i VECTORCALL Blend(__m256i fg_lo, __m256i fg_hi, __m256i bgcolor, __m256i texels, uint32_t srcalpha, uint32_t destalpha)
+		{
+			using namespace DrawWall32TModes;
+
+			if (BlendT::Mode == (int)WallBlendModes::Masked)
+			{
+				return Drawer32AVX2::BlendMasked(fg_lo, fg_hi, bgcolor);
+			}
+			else
+			{
+				__m256i fgalpha, bgalpha, fgalpha_lo, fgalpha_hi, bgalpha_lo, bgalpha_hi, bg_lo, bg_hi;
+				Drawer32AVX2::AlphaFactors(texels, srcalpha, destalpha, fgalpha, bgalpha);
+				Drawer32AVX2::SplatPixels(fgalpha, fgalpha_lo, fgalpha_hi);
+				Drawer32AVX2::SplatPixels(bgalpha, bgalpha_lo, bgalpha_hi);
+				Drawer32AVX2::Unpack(bgcolor, bg_lo, bg_hi);
+
+				const int op =
+					BlendT::Mode == (int)WallBlendModes::AddClamp ? Drawer32AVX2::AddOp :
+					BlendT::Mode == (int)WallBlendModes::SubClamp ? Drawer32AVX2::SubOp : Drawer32AVX2::RevSubOp;
+				__m256i out_lo = Drawer32AVX2::BlendAlpha<op>(fg_lo, bg_lo, fgalpha_lo, bgalpha_lo);
+				__m256i out_hi = Drawer32AVX2::BlendAlpha<op>(fg_hi, bg_hi, fgalpha_hi, bgalpha_hi);
+				return Drawer32AVX2::Pack(out_lo, out_hi);
+			}
+		}
+	};
+
+	typedef DrawWall32AVX2T<DrawWall32TModes::OpaqueWall> DrawWall32AVX2Command;
+	typedef DrawWall32AVX2T<DrawWall32TModes::MaskedWall> DrawWallMasked32AVX2Command;
+	typedef DrawWall32AVX2T<DrawWall32TModes::AddClampWall> DrawWallAddClamp32AVX2Command;
+	typedef DrawWall32AVX2T<DrawWall32TModes::SubClampWall> DrawWallSubClamp32AVX2Command;
+	typedef DrawWall32AVX2T<DrawWall32TModes::RevSubClampWall> DrawWallRevSubClamp32AVX2Command;
+}
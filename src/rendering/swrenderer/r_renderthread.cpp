@@ -56,6 +56,8 @@
 
 std::pair<PalEntry, PalEntry>& R_GetSkyCapColor(FGameTexture* tex);
 
+EXTERN_CVAR(Bool, r_avx2drawers)
+
 namespace swrenderer
 {
 	RenderThread::RenderThread(RenderScene *scene, bool mainThread)
@@ -75,6 +77,10 @@ namespace swrenderer
 		DrawSegments.reset(new DrawSegmentList(this));
 		ClipSegments.reset(new RenderClipSegment());
 		tc_drawers.reset(new SWTruecolorDrawers(this));
+#ifndef NO_SSE
+		if (SWTruecolorAVX2Drawers::IsSupported())
+			tc_avx2_drawers.reset(new SWTruecolorAVX2Drawers(this));
+#endif
 		pal_drawers.reset(new SWPalDrawers(this));
 	}
 
@@ -85,7 +91,7 @@ namespace swrenderer
 	SWPixelFormatDrawers *RenderThread::Drawers(RenderViewport *viewport)
 	{
 		if (viewport->RenderTarget->IsBgra())
-			return tc_drawers.get();
+			return (r_avx2drawers && tc_avx2_drawers) ? tc_avx2_drawers.get() : tc_drawers.get();
 		else
 			return pal_drawers.get();
 	}
@@ -92,6 +92,7 @@ namespace swrenderer
 		
 	private:
 		std::unique_ptr<SWTruecolorDrawers> tc_drawers;
+		std::unique_ptr<SWTruecolorDrawers> tc_avx2_drawers;
 		std::unique_ptr<SWPalDrawers> pal_drawers;
 	};
 }
@@ -336,6 +336,17 @@ namespace swrenderer
 	// Checks BSP node/subtree bounding box.
 	// Returns true if some part of the bbox might be visible.
 	bool RenderOpaquePass::CheckBBox(float *bspcoord)
+	{
+		int sx1, sx2;
+		switch (ProjectBBox(bspcoord, sx1, sx2))
+		{
+		case BBoxProjection::Offscreen: return false;
+		case BBoxProjection::Surrounds: return true;
+		default: return Thread->ClipSegments->IsVisible(sx1, sx2);
+		}
+	}
+
+	RenderOpaquePass::BBoxProjection RenderOpaquePass::ProjectBBox(const float *bspcoord, int &sx1, int &sx2)
 	{
 		static const int checkcoord[12][4] =
 		{
@@ -358,7 +369,6 @@ namespace swrenderer
 
 		double	 			x1, y1, x2, y2;
 		double				rx1, ry1, rx2, ry2;
-		int					sx1, sx2;
 
 		// Find the corners of the box
 		// that define the edges from current viewpoint.
@@ -378,7 +388,7 @@ namespace swrenderer
 
 		boxpos = (boxy << 2) + boxx;
 		if (boxpos == 5)
-			return true;
+			return BBoxProjection::Surrounds;
 
 		x1 = bspcoord[checkcoord[boxpos][0]] - Thread->Viewport->viewpoint.Pos.X;
 		y1 = bspcoord[checkcoord[boxpos][1]] - Thread->Viewport->viewpoint.Pos.Y;
@@ -389,7 +399,7 @@ namespace swrenderer
 
 		// Sitting on a line?
 		if (y1 * (x1 - x2) + x1 * (y2 - y1) >= -EQUAL_EPSILON)
-			return true;
+			return BBoxProjection::Surrounds;
 
 		rx1 = x1 * Thread->Viewport->viewpoint.Sin - y1 * Thread->Viewport->viewpoint.Cos;
 		rx2 = x2 * Thread->Viewport->viewpoint.Sin - y2 * Thread->Viewport->viewpoint.Cos;
@@ -408,34 +418,35 @@ namespace swrenderer
 
 		if (rx1 >= -ry1)
 		{
-			if (rx1 > ry1) return false;	// left edge is off the right side
-			if (ry1 == 0) return false;
+			if (rx1 > ry1) return BBoxProjection::Offscreen;	// left edge is off the right side
+			if (ry1 == 0) return BBoxProjection::Offscreen;
 			sx1 = xs_RoundToInt(viewport->CenterX + rx1 * viewport->CenterX / ry1);
 		}
 		else
 		{
-			if (rx2 < -ry2) return false;	// wall is off the left side
-			if (rx1 - rx2 - ry2 + ry1 == 0) return false;	// wall does not intersect view volume
+			if (rx2 < -ry2) return BBoxProjection::Offscreen;	// wall is off the left side
+			if (rx1 - rx2 - ry2 + ry1 == 0) return BBoxProjection::Offscreen;	// wall does not intersect view volume
 			sx1 = 0;
 		}
 
 		if (rx2 <= ry2)
 		{
-			if (rx2 < -ry2) return false;	// right edge is off the left side
-			if (ry2 == 0) return false;
+			if (rx2 < -ry2) return BBoxProjection::Offscreen;	// right edge is off the left side
+			if (ry2 == 0) return BBoxProjection::Offscreen;
 			sx2 = xs_RoundToInt(viewport->CenterX + rx2 * viewport->CenterX / ry2);
 		}
 		else
 		{
-			if (rx1 > ry1) return false;	// wall is off the right side
-			if (ry2 - ry1 - rx2 + rx1 == 0) return false;	// wall does not intersect view volume
+			if (rx1 > ry1) return BBoxProjection::Offscreen;	// wall is off the right side
+			if (ry2 - ry1 - rx2 + rx1 == 0) return BBoxProjection::Offscreen;	// wall does not intersect view volume
 			sx2 = viewwidth;
 		}
 
-		// Find the first clippost that touches the source post
-		//	(adjacent pixels are touching).
+		// Does not cross a pixel.
+		if (sx2 <= sx1)
+			return BBoxProjection::Offscreen;
 
-		return Thread->ClipSegments->IsVisible(sx1, sx2);
+		return BBoxProjection::Columns;
 	}
 
 	void RenderOpaquePass::AddPolyobjs(subsector_t *sub)
@@ -815,7 +826,7 @@ namespace swrenderer
 		}
 	}
 
-	void RenderOpaquePass::RenderScene(FLevelLocals *Level)
+	void RenderOpaquePass::RenderScene(FLevelLocals *Level, const TArray<BinnedSceneEntry> *binnedScene)
 	{
 		if (Thread->MainThread)
 			WallCycles.Clock();
@@ -829,7 +840,10 @@ namespace swrenderer
 		SeenActors.clear();
 
 		InSubsector = nullptr;
-		RenderBSPNode(Level->HeadNode());	// The head node is the last node output.
+		if (binnedScene)
+			RenderBinnedScene(*binnedScene);
+		else
+			RenderBSPNode(Level->HeadNode());	// The head node is the last node output.
 
 		if (Thread->MainThread)
 			WallCycles.Unclock();
@@ -868,6 +882,71 @@ namespace swrenderer
 		RenderSubsector((subsector_t *)((uint8_t *)node - 1));
 	}
 
+	void RenderOpaquePass::BuildBinnedScene(FLevelLocals *Level, TArray<BinnedSceneEntry> &entries)
+	{
+		entries.Clear();
+		if (Level->nodes.Size() == 0)
+			entries.Push({ &Level->subsectors[0], 0, 0, 0 });
+		else
+			BinBSPNode(Level->HeadNode(), entries);
+	}
+
+	void RenderOpaquePass::BinBSPNode(void *node, TArray<BinnedSceneEntry> &entries)
+	{
+		// Same walk as RenderBSPNode, but a failed box test skips to the end of this call instead of returning
+		unsigned firstTest = BinnedTests.Size();
+		while (!((size_t)node & 1))
+		{
+			node_t *bsp = (node_t *)node;
+
+			int side = R_PointOnSide(Thread->Viewport->viewpoint.Pos.XY(), bsp);
+			BinBSPNode(bsp->children[side], entries);
+
+			// Only the clip segment test depends on the slice. Boxes that are off screen or
+			// surround the viewer give the same answer everywhere.
+			side ^= 1;
+			int sx1, sx2;
+			BBoxProjection projection = ProjectBBox(bsp->bbox[side], sx1, sx2);
+			if (projection == BBoxProjection::Offscreen)
+				break;
+			if (projection == BBoxProjection::Columns)
+				BinnedTests.Push(entries.Push({ nullptr, 0, sx1, sx2 }));
+
+			node = bsp->children[side];
+		}
+		if ((size_t)node & 1)
+			entries.Push({ (subsector_t *)((uint8_t *)node - 1), 0, 0, 0 });
+
+		for (unsigned i = firstTest; i < BinnedTests.Size(); i++)
+			entries[BinnedTests[i]].Skip = entries.Size();
+		BinnedTests.Resize(firstTest);
+	}
+
+	void RenderOpaquePass::RenderBinnedScene(const TArray<BinnedSceneEntry> &entries)
+	{
+		int x1 = Thread->X1;
+		int x2 = Thread->X2;
+		unsigned count = entries.Size();
+		unsigned index = 0;
+		while (index < count)
+		{
+			const BinnedSceneEntry &entry = entries[index];
+			if (entry.Subsector)
+			{
+				RenderSubsector(entry.Subsector);
+				index++;
+			}
+			else if (entry.X2 <= x1 || entry.X1 >= x2 || !Thread->ClipSegments->IsVisible(entry.X1, entry.X2))
+			{
+				index = entry.Skip;
+			}
+			else
+			{
+				index++;
+			}
+		}
+	}
+
 	void RenderOpaquePass::ClearClip()
 	{
 		fillshort(floorclip, viewwidth, viewheight);
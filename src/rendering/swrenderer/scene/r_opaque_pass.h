@@ -58,13 +58,25 @@ namespace swrenderer
 		int renderflags;
 	};
 
+	// One step of a BSP walk flattened by RenderOpaquePass::BuildBinnedScene
+	struct BinnedSceneEntry
+	{
+		subsector_t *Subsector;	// Subsector to render, or nullptr for a bounding box test
+		unsigned Skip;			// Entry to continue at when the box is hidden
+		int X1, X2;				// Screen columns covered by the box
+	};
+
 	class RenderOpaquePass
 	{
 	public:
 		RenderOpaquePass(RenderThread *thread);
 
 		void ClearClip();
-		void RenderScene(FLevelLocals *Level);
+		void RenderScene(FLevelLocals *Level, const TArray<BinnedSceneEntry> *binnedScene = nullptr);
+
+		// Walks the BSP once for the whole view. Render slices can then replay the result
+		// instead of repeating the node traversal.
+		void BuildBinnedScene(FLevelLocals *Level, TArray<BinnedSceneEntry> &entries);
 
 		void ResetFakingUnderwater() { r_fakingunderwater = false; }
 		sector_t *FakeFlat(sector_t *sec, sector_t *tempsec, int *floorlightlevel, int *ceilinglightlevel, seg_t *backline, int backx1, int backx2, double frontcz1, double frontcz2);
@@ -82,6 +94,16 @@ namespace swrenderer
 		void RenderBSPNode(void *node);
 		void RenderSubsector(subsector_t *sub);
 		bool CheckBBox(float *bspcoord);
+		void BinBSPNode(void *node, TArray<BinnedSceneEntry> &entries);
+		void RenderBinnedScene(const TArray<BinnedSceneEntry> &entries);
+
+		enum class BBoxProjection
+		{
+			Offscreen,
+			Surrounds,
+			Columns
+		};
+		BBoxProjection ProjectBBox(const float *bspcoord, int &sx1, int &sx2);
 
 		void AddPolyobjs(subsector_t *sub);
 
@@ -102,5 +124,6 @@ namespace swrenderer
 		std::set<AActor*> SeenActors;
 		std::vector<uint32_t> PvsSubsectors;
 		std::vector<uint32_t> SubsectorDepths;
+		TArray<unsigned> BinnedTests;
 	};
 }
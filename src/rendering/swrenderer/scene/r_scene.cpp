@@ -63,6 +63,8 @@ EXTERN_CVAR(Int, r_clearbuffer)
 EXTERN_CVAR(Int, r_debug_draw)
 
 CVAR(Int, r_scene_multithreaded, 1, 0);
+CVAR(Bool, r_scene_binning, false, 0);
+CVAR(Int, r_scene_slicesperthread, 4, 0);
 CVAR(Bool, r_models, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG);
 
 namespace swrenderer
@@ -195,6 +197,21 @@ namespace swrenderer
 			Threads[i]->X1 = viewwidth * i / numThreads;
 			Threads[i]->X2 = viewwidth * (i + 1) / numThreads;
 		}
+
+		// With binning the BSP is walked once here and the threads pick narrower slices as they
+		// finish, instead of every thread walking the BSP for one fixed slice of the screen
+		UseBinnedScene = r_scene_binning;
+		if (UseBinnedScene)
+		{
+			MainThread()->Portal->SetMainPortal();
+			MainThread()->OpaquePass->BuildBinnedScene(MainThread()->Viewport->Level(), BinnedScene);
+			NumSlices = numThreads > 1 ? numThreads * clamp(*r_scene_slicesperthread, 1, 16) : 1;
+		}
+		else
+		{
+			NumSlices = numThreads;
+		}
+		NextSlice = 0;
 		run_id++;
 		FSoftwareTexture::CurrentUpdate = run_id;
 		start_lock.unlock();
@@ -206,7 +223,7 @@ namespace swrenderer
 		}
 
 		// Do the main thread ourselves:
-		RenderThreadSlice(MainThread());
+		RenderAssignedSlices(MainThread());
 
 		// Wait for everyone to finish:
 		if (Threads.size() > 1)
@@ -226,6 +243,25 @@ namespace swrenderer
 		MainThread()->X2 = viewwidth;
 	}
 
+	void RenderScene::RenderAssignedSlices(RenderThread *thread)
+	{
+		if (!UseBinnedScene)
+		{
+			RenderThreadSlice(thread);
+			return;
+		}
+
+		while (true)
+		{
+			int slice = NextSlice++;
+			if (slice >= NumSlices)
+				break;
+			thread->X1 = viewwidth * slice / NumSlices;
+			thread->X2 = viewwidth * (slice + 1) / NumSlices;
+			RenderThreadSlice(thread);
+		}
+	}
+
 	void RenderScene::RenderThreadSlice(RenderThread *thread)
 	{
 		thread->FrameMemory->Clear();
@@ -247,7 +283,7 @@ namespace swrenderer
 		if (thread->X2 < viewwidth)
 			thread->ClipSegments->Clip(thread->X2, viewwidth, true, &visitor);
 
-		thread->OpaquePass->RenderScene(thread->Viewport->Level());
+		thread->OpaquePass->RenderScene(thread->Viewport->Level(), UseBinnedScene ? &BinnedScene : nullptr);
 		thread->Clip3D->ResetClip(); // reset clips (floor/ceiling)
 
 		if (viewactive)
@@ -313,7 +349,7 @@ namespace swrenderer
 					last_run_id = run_id;
 					start_lock.unlock();
 
-					RenderThreadSlice(renderthread);
+					RenderAssignedSlices(renderthread);
 
 					// Notify main thread that we finished:
 					std::unique_lock<std::mutex> end_lock(end_mutex);
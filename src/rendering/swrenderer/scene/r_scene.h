@@ -27,6 +27,7 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include "r_defs.h"
 #include "d_player.h"
 
@@ -37,6 +38,7 @@ namespace swrenderer
 	extern cycle_t WallCycles, PlaneCycles, MaskedCycles, DrawerWaitCycles;
 
 	class RenderThread;
+	struct BinnedSceneEntry;
 	
 	class RenderScene
 	{
@@ -58,6 +60,7 @@ namespace swrenderer
 	private:
 		void RenderActorView(AActor *actor,bool renderplayersprite, bool dontmaplines);
 		void RenderThreadSlices();
+		void RenderAssignedSlices(RenderThread *thread);
 		void RenderThreadSlice(RenderThread *thread);
 		void RenderPSprites();
 
@@ -75,5 +78,10 @@ namespace swrenderer
 		std::mutex end_mutex;
 		std::condition_variable end_condition;
 		size_t finished_threads = 0;
+
+		bool UseBinnedScene = false;
+		TArray<BinnedSceneEntry> BinnedScene;
+		int NumSlices = 0;
+		std::atomic<int> NextSlice = { 0 };
 	};
 }
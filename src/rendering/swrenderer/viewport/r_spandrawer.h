@@ -84,5 +84,7 @@ namespace swrenderer
 		int ds_color = 0;
 		double ds_lod;
 		RenderViewport *ds_viewport = nullptr;
+
+		friend class SWDrawerBenchmark;
 	};
 }
@@ -2215,3 +2215,62 @@ DEFINE_ACTION_FUNCTION_NATIVE(FLevelLocals, SpawnParticle, SpawnParticle)
 	SpawnParticle(self, p);
 	return 0;
 }
+
+static int CreateParticleBatch(FLevelLocals *Level, double drag, DObject *handler)
+{
+	return P_CreateParticleBatch(Level, drag, handler);
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(FLevelLocals, CreateParticleBatch, CreateParticleBatch)
+{
+	PARAM_SELF_STRUCT_PROLOGUE(FLevelLocals);
+	PARAM_FLOAT(drag);
+	PARAM_OBJECT(handler, DObject);
+	ACTION_RETURN_INT(CreateParticleBatch(self, drag, handler));
+}
+
+static void ReleaseParticleBatch(FLevelLocals *Level, int batch)
+{
+	P_ReleaseParticleBatch(Level, batch);
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(FLevelLocals, ReleaseParticleBatch, ReleaseParticleBatch)
+{
+	PARAM_SELF_STRUCT_PROLOGUE(FLevelLocals);
+	PARAM_INT(batch);
+	ReleaseParticleBatch(self, batch);
+	return 0;
+}
+
+static int GetParticleBatchCount(FLevelLocals *Level, int batch)
+{
+	return P_GetParticleBatchCount(Level, batch);
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(FLevelLocals, GetParticleBatchCount, GetParticleBatchCount)
+{
+	PARAM_SELF_STRUCT_PROLOGUE(FLevelLocals);
+	PARAM_INT(batch);
+	ACTION_RETURN_INT(GetParticleBatchCount(self, batch));
+}
+
+static void SpawnParticleBatch(FLevelLocals *Level, FSpawnParticleParams *params, int count, int batch, double psx, double psy, double psz, double vsx, double vsy, double vsz)
+{
+	P_SpawnParticleBatch(Level, *params, count, batch, DVector3(psx, psy, psz), DVector3(vsx, vsy, vsz));
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(FLevelLocals, SpawnParticleBatch, SpawnParticleBatch)
+{
+	PARAM_SELF_STRUCT_PROLOGUE(FLevelLocals);
+	PARAM_POINTER(p, FSpawnParticleParams);
+	PARAM_INT(count);
+	PARAM_INT(batch);
+	PARAM_FLOAT(psx);
+	PARAM_FLOAT(psy);
+	PARAM_FLOAT(psz);
+	PARAM_FLOAT(vsx);
+	PARAM_FLOAT(vsy);
+	PARAM_FLOAT(vsz);
+	SpawnParticleBatch(self, p, count, batch, psx, psy, psz, vsx, vsy, vsz);
+	return 0;
+}